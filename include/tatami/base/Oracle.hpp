@@ -2,6 +2,7 @@
 #define TATAMI_ORACLE_HPP
 
 #include <cstddef>
+#include <limits>
 
 /**
  * @file Oracle.hpp
@@ -24,6 +25,10 @@ typedef std::size_t PredictionIndex;
  *
  * This allows `Matrix` implementations to pre-fetch data for future requests to `OracularDenseExtractor::fetch()` or `OracularSparseExtractor::fetch()`.
  * Check out `ConsecutiveOracle` and `FixedVectorOracle` for some examples of concrete subclasses.
+ *
+ * Subclasses only need to implement `total()` and `get()`.
+ * Implementations may also override `span()` and the structural queries (`is_consecutive()`, `is_strided()`, `stride()` and `is_increasing()`)
+ * to allow `Matrix` implementations to plan their pre-fetching without calling `get()` for each prediction.
  */
 template<typename Index_>
 class Oracle {
@@ -51,6 +56,92 @@ public:
      * @return The `i`-th prediction, to be interpreted as an index on the target dimension.
      */
     virtual Index_ get(PredictionIndex i) const = 0;
+
+    /**
+     * @param start Index of the first prediction of interest.
+     * @param number Number of predictions of interest.
+     * This should be such that `start + number` is no greater than `total()`.
+     * @param buffer Pointer to an array of length no less than `number`.
+     *
+     * @return Pointer to an array containing predictions `start, start + 1, ..., start + number - 1`.
+     * This may be `buffer` or a pointer to the oracle's internal storage.
+     *
+     * The default implementation fills `buffer` with calls to `get()`.
+     * Subclasses with contiguous storage of their predictions should override this method to avoid the copy.
+     */
+    virtual const Index_* span(const PredictionIndex start, const PredictionIndex number, Index_* const buffer) const {
+        for (PredictionIndex i = 0; i < number; ++i) {
+            buffer[i] = get(start + i);
+        }
+        return buffer;
+    }
+
+    /**
+     * @return Whether the predictions are a strictly increasing sequence of consecutive indices, i.e., the `i`-th prediction is equal to `get(0) + i`.
+     * If true, `Matrix` implementations can compute the range of all upcoming predictions in constant time.
+     *
+     * The default implementation returns false, which is always safe.
+     */
+    virtual bool is_consecutive() const {
+        return false;
+    }
+
+    /**
+     * @return Whether the predictions form an arithmetic sequence with a positive step, i.e., the `i`-th prediction is equal to `get(0) + i * stride()`.
+     * If true, `Matrix` implementations can compute the location of any prediction in constant time.
+     *
+     * The default implementation returns `is_consecutive()`.
+     * Subclasses that override this method should ensure that `is_consecutive()` is true if and only if `is_strided()` is true and `stride()` is equal to 1.
+     */
+    virtual bool is_strided() const {
+        return is_consecutive();
+    }
+
+    /**
+     * @return Step size between successive predictions.
+     * This is only meaningful if `is_strided()` is true.
+     *
+     * The default implementation returns 1.
+     */
+    virtual Index_ stride() const {
+        return 1;
+    }
+
+    /**
+     * @return Whether the predictions are sorted in non-decreasing order, i.e., each prediction is no less than the preceding prediction.
+     * If true, `Matrix` implementations can satisfy all predictions in a single forward pass over their data, e.g., with sequential reads from a file. 
+     *
+     * The default implementation returns `is_strided()`.
+     */
+    virtual bool is_increasing() const {
+        return is_strided();
+    }
+
+    /**
+     * @return Maximum number of upcoming predictions that are useful to the consumer of the `Oracle`, as set by `set_max_lookahead()`.
+     * `Matrix` implementations may use this as an upper bound on the number of predictions to pre-fetch at any time,
+     * e.g., to avoid reading data that the caller will not request before it is evicted from a cache.
+     * This is only a hint and does not affect the predictions themselves.
+     *
+     * By default, this is the largest value of `PredictionIndex`, i.e., there is no limit.
+     */
+    PredictionIndex max_lookahead() const {
+        return my_max_lookahead;
+    }
+
+    /**
+     * @param lookahead Maximum number of upcoming predictions that are useful to the consumer, see `max_lookahead()` for details.
+     * This should be positive.
+     *
+     * This should be set by the creator of the `Oracle` before passing it to a `Matrix` to construct an oracular extractor.
+     * Wrapper oracles (e.g., those created by delayed operations to transform the predictions) should propagate this value from the wrapped `Oracle`.
+     */
+    void set_max_lookahead(const PredictionIndex lookahead) {
+        my_max_lookahead = lookahead;
+    }
+
+private:
+    PredictionIndex my_max_lookahead = std::numeric_limits<PredictionIndex>::max();
 };
 
 }
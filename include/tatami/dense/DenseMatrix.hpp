@@ -3,15 +3,24 @@
 
 #include "../base/Matrix.hpp"
 #include "SparsifiedWrapper.hpp"
+#include "transpose.hpp"
 #include "../utils/has_data.hpp"
+#include "../utils/ElementType.hpp"
 #include "../utils/copy.hpp"
 #include "../utils/Index_to_container.hpp"
+#include "../utils/gather.hpp"
 #include "../utils/PseudoOracularExtractor.hpp"
+#include "../utils/parallelize.hpp"
+#include "../subset/SubsetMaterializable.hpp"
 
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
 #include <utility>
+#include <string>
+#include <cstddef>
+#include <optional>
+#include <memory>
 
 #include "sanisizer/sanisizer.hpp"
 
@@ -30,13 +39,20 @@ namespace tatami {
  */
 namespace DenseMatrix_internals {
 
+// Each extractor is given the position of the first element in the storage vector ('offset')
+// and the distance between the first elements of consecutive primary dimension elements ('leading').
+// For a contiguous matrix, 'offset' is zero and 'leading' is equal to the extent of the secondary dimension.
+template<class Storage_>
+using StorageSize = I<decltype(std::declval<const Storage_&>().size())>;
+
 template<typename Value_, typename Index_, class Storage_>
 class PrimaryMyopicFullDense final : public MyopicDenseExtractor<Value_, Index_> {
 public:
-    PrimaryMyopicFullDense(const Storage_& storage, const Index_ secondary) : my_storage(storage), my_secondary(secondary) {}
+    PrimaryMyopicFullDense(const Storage_& storage, const StorageSize<Storage_> offset, const StorageSize<Storage_> leading, const Index_ secondary) :
+        my_storage(storage), my_offset(offset), my_leading(leading), my_secondary(secondary) {}
 
     const Value_* fetch(const Index_ i, Value_* const buffer) {
-        const auto offset = sanisizer::product_unsafe<I<decltype(my_storage.size())> >(my_secondary, i);
+        const auto offset = my_offset + sanisizer::product_unsafe<StorageSize<Storage_> >(my_leading, i);
 #ifndef TATAMI_DEBUG_FORCE_COPY
         if constexpr(has_data<Value_, Storage_>::value) {
             return my_storage.data() + offset;
@@ -51,17 +67,18 @@ public:
 
 private:
     const Storage_& my_storage;
+    StorageSize<Storage_> my_offset, my_leading;
     Index_ my_secondary;
 };
 
 template<typename Value_, typename Index_, class Storage_>
 class PrimaryMyopicBlockDense final : public MyopicDenseExtractor<Value_, Index_> {
 public:
-    PrimaryMyopicBlockDense(const Storage_& storage, const Index_ secondary, const Index_ block_start, const Index_ block_length) : 
-        my_storage(storage), my_secondary(secondary), my_block_start(block_start), my_block_length(block_length) {}
+    PrimaryMyopicBlockDense(const Storage_& storage, const StorageSize<Storage_> offset, const StorageSize<Storage_> leading, const Index_ block_start, const Index_ block_length) : 
+        my_storage(storage), my_offset(offset), my_leading(leading), my_block_start(block_start), my_block_length(block_length) {}
 
     const Value_* fetch(const Index_ i, Value_* const buffer) {
-        const auto offset = sanisizer::nd_offset<I<decltype(my_storage.size())> >(my_block_start, my_secondary, i);
+        const auto offset = my_offset + sanisizer::nd_offset<StorageSize<Storage_> >(my_block_start, my_leading, i);
 #ifndef TATAMI_DEBUG_FORCE_COPY
         if constexpr(has_data<Value_, Storage_>::value) {
             return my_storage.data() + offset;
@@ -76,96 +93,178 @@ public:
 
 private:
     const Storage_& my_storage;
-    Index_ my_secondary;
+    StorageSize<Storage_> my_offset, my_leading;
     Index_ my_block_start, my_block_length;
 };
 
 template<typename Value_, typename Index_, class Storage_>
 class PrimaryMyopicIndexDense final : public MyopicDenseExtractor<Value_, Index_> {
 public:
-    PrimaryMyopicIndexDense(const Storage_& storage, const Index_ secondary, VectorPtr<Index_> indices_ptr) : 
-        my_storage(storage), my_secondary(secondary), my_indices_ptr(std::move(indices_ptr)) {}
+    PrimaryMyopicIndexDense(const Storage_& storage, const StorageSize<Storage_> offset, const StorageSize<Storage_> leading, VectorPtr<Index_> indices_ptr) : 
+        my_storage(storage), my_offset(offset), my_leading(leading), my_indices(std::move(indices_ptr)) {}
 
     const Value_* fetch(const Index_ i, Value_* const buffer) {
-        const auto& indices = *my_indices_ptr;
-        const auto nindices = indices.size();
-        for (I<decltype(nindices)> x = 0; x < nindices; ++x) {
-            buffer[x] = my_storage[sanisizer::nd_offset<I<decltype(my_storage.size())> >(indices[x], my_secondary, i)];
-        }
-        return buffer;
+        const auto offset = my_offset + sanisizer::product_unsafe<StorageSize<Storage_> >(my_leading, i);
+        return my_indices.gather(my_storage.begin() + offset, buffer);
     }
 
 private:
     const Storage_& my_storage;
-    Index_ my_secondary;
-    VectorPtr<Index_> my_indices_ptr;
+    StorageSize<Storage_> my_offset, my_leading;
+    GatherIndices<Index_> my_indices;
 };
 
 template<typename Value_, typename Index_, class Storage_>
 class SecondaryMyopicFullDense final : public MyopicDenseExtractor<Value_, Index_> {
 public:
-    SecondaryMyopicFullDense(const Storage_& storage, const Index_ secondary, const Index_ primary) : 
-        my_storage(storage), my_secondary(secondary), my_primary(primary) {}
+    SecondaryMyopicFullDense(const Storage_& storage, const StorageSize<Storage_> offset, const StorageSize<Storage_> leading, const Index_ primary) : 
+        my_storage(storage), my_offset(offset), my_leading(leading), my_primary(primary) {}
 
     const Value_* fetch(const Index_ i, Value_* const buffer) {
         for (I<decltype(my_primary)> x = 0; x < my_primary; ++x) {
-            buffer[x] = my_storage[sanisizer::nd_offset<I<decltype(my_storage.size())> >(i, my_secondary, x)];
+            buffer[x] = my_storage[my_offset + sanisizer::nd_offset<StorageSize<Storage_> >(i, my_leading, x)];
         }
         return buffer;
     }
 
 private:
     const Storage_& my_storage;
-    Index_ my_secondary;
+    StorageSize<Storage_> my_offset, my_leading;
     Index_ my_primary;
 };
 
 template<typename Value_, typename Index_, class Storage_>
 class SecondaryMyopicBlockDense final : public MyopicDenseExtractor<Value_, Index_> {
 public:
-    SecondaryMyopicBlockDense(const Storage_& storage, const Index_ secondary, const Index_ block_start, const Index_ block_length) : 
-        my_storage(storage), my_secondary(secondary), my_block_start(block_start), my_block_length(block_length) {}
+    SecondaryMyopicBlockDense(const Storage_& storage, const StorageSize<Storage_> offset, const StorageSize<Storage_> leading, const Index_ block_start, const Index_ block_length) : 
+        my_storage(storage), my_offset(offset), my_leading(leading), my_block_start(block_start), my_block_length(block_length) {}
 
     const Value_* fetch(const Index_ i, Value_* const buffer) {
         for (I<decltype(my_block_length)> x = 0; x < my_block_length; ++x) {
-            buffer[x] = my_storage[sanisizer::nd_offset<I<decltype(my_storage.size())> >(i, my_secondary, my_block_start + x)];
+            buffer[x] = my_storage[my_offset + sanisizer::nd_offset<StorageSize<Storage_> >(i, my_leading, my_block_start + x)];
         }
         return buffer;
     }
 
 private:
     const Storage_& my_storage;
-    Index_ my_secondary;
+    StorageSize<Storage_> my_offset, my_leading;
     Index_ my_block_start;
     Index_ my_block_length;
 };
 
+// Not using GatherIndices here, as consecutive indices are 'leading' elements apart in the storage so they cannot be copied as contiguous blocks.
 template<typename Value_, typename Index_, class Storage_>
 class SecondaryMyopicIndexDense final : public MyopicDenseExtractor<Value_, Index_> {
 public:
-    SecondaryMyopicIndexDense(const Storage_& storage, const Index_ secondary, VectorPtr<Index_> indices_ptr) : 
-        my_storage(storage), my_secondary(secondary), my_indices_ptr(std::move(indices_ptr)) {}
+    SecondaryMyopicIndexDense(const Storage_& storage, const StorageSize<Storage_> offset, const StorageSize<Storage_> leading, VectorPtr<Index_> indices_ptr) : 
+        my_storage(storage), my_offset(offset), my_leading(leading), my_indices_ptr(std::move(indices_ptr)) {}
 
     const Value_* fetch(const Index_ i, Value_* const buffer) {
         const auto& indices = *my_indices_ptr;
         const auto nindices = indices.size();
         for (I<decltype(nindices)> x = 0; x < nindices; ++x) {
-            buffer[x] = my_storage[sanisizer::nd_offset<I<decltype(my_storage.size())> >(i, my_secondary, indices[x])];
+            buffer[x] = my_storage[my_offset + sanisizer::nd_offset<StorageSize<Storage_> >(i, my_leading, indices[x])];
         }
         return buffer;
     }
 
 private:
     const Storage_& my_storage;
-    Index_ my_secondary;
+    StorageSize<Storage_> my_offset, my_leading;
     VectorPtr<Index_> my_indices_ptr;
 };
 
+template<typename Value_, typename Index_, class Storage_>
+class DenseSubsetScanner final : public SubsetScanner<Value_, Index_> {
+public:
+    DenseSubsetScanner(
+        const Storage_& storage,
+        const StorageSize<Storage_> offset,
+        const StorageSize<Storage_> leading,
+        const bool row_major,
+        const Index_ num_primary,
+        const Index_ num_secondary,
+        const std::vector<Index_>* const primary_subset,
+        const std::vector<Index_>* const secondary_subset
+    ) :
+        my_storage(storage),
+        my_offset(offset),
+        my_leading(leading),
+        my_row_major(row_major),
+        my_primary_subset(primary_subset),
+        my_secondary_subset(secondary_subset),
+        my_num_primary(primary_subset ? primary_subset->size() : num_primary),
+        my_num_secondary(secondary_subset ? secondary_subset->size() : num_secondary)
+    {}
+
+private:
+    const Storage_& my_storage;
+    StorageSize<Storage_> my_offset, my_leading;
+    bool my_row_major;
+    const std::vector<Index_>* my_primary_subset;
+    const std::vector<Index_>* my_secondary_subset;
+    Index_ my_num_primary, my_num_secondary;
+
+public:
+    bool by_row() const {
+        return my_row_major;
+    }
+
+    Index_ primary() const {
+        return my_num_primary;
+    }
+
+    Index_ secondary() const {
+        return my_num_secondary;
+    }
+
+    bool sorted() const {
+        return true; // as we iterate over the positions of the secondary subset.
+    }
+
+    Index_ scan(const Index_ p, Value_* const value_buffer, Index_* const index_buffer) const {
+        const Index_ stored = (my_primary_subset ? (*my_primary_subset)[p] : p);
+        const auto src = my_storage.begin() + (my_offset + sanisizer::product_unsafe<StorageSize<Storage_> >(my_leading, stored));
+        Index_ count = 0;
+        for (Index_ s = 0; s < my_num_secondary; ++s) {
+            const auto& v = src[my_secondary_subset ? (*my_secondary_subset)[s] : s];
+            if (v != 0) {
+                value_buffer[count] = v;
+                index_buffer[count] = s;
+                ++count;
+            }
+        }
+        return count;
+    }
+};
+
 }
 /**
  * @endcond
  */
 
+/**
+ * @brief Options for the `DenseMatrix` constructor.
+ */
+struct DenseMatrixOptions {
+    /**
+     * Position of the first element of the matrix in the vector of values.
+     */
+    std::size_t offset = 0;
+
+    /**
+     * Leading dimension of the matrix, i.e., the distance in the vector of values between the first elements of consecutive rows (for row-major matrices) or columns (otherwise).
+     * This should be no less than the number of columns (for row-major matrices) or rows (otherwise).
+     * If zero, it is set to the number of columns or rows, i.e., the matrix is stored contiguously.
+     *
+     * Together with `DenseMatrixOptions::offset`, this can be used to define a `DenseMatrix` for a rectangular window of a larger dense array without copying its contents,
+     * e.g., by supplying an `ArrayView` to the larger array as the vector of values.
+     * Extraction of rows (for row-major matrices) or columns (otherwise) will then return pointers directly into the larger array.
+     */
+    std::size_t leading_dimension = 0;
+};
+
 /**
  * @brief Dense matrix representation.
  *
@@ -177,7 +276,7 @@ private:
  * If a method is available for `data()` that returns a `const Value_*`, it will also be used.
  */
 template<typename Value_, typename Index_, class Storage_>
-class DenseMatrix : public Matrix<Value_, Index_> {
+class DenseMatrix : public Matrix<Value_, Index_>, public SubsetMaterializable<Value_, Index_> {
 public: 
     /**
      * @param nrow Number of rows.
@@ -187,7 +286,7 @@ public:
      * If `false`, a column-major representation is assumed instead.
      */
     DenseMatrix(const Index_ nrow, const Index_ ncol, Storage_ values, const bool row_major) :
-        my_nrow(nrow), my_ncol(ncol), my_values(std::move(values)), my_row_major(row_major)
+        my_nrow(nrow), my_ncol(ncol), my_values(std::move(values)), my_row_major(row_major), my_offset(0), my_leading_dimension(secondary())
     {
         const auto nvalues = my_values.size();
         if (my_nrow == 0) {
@@ -199,11 +298,49 @@ public:
         }
     }
 
+    /**
+     * @param nrow Number of rows.
+     * @param ncol Number of columns.
+     * @param values Vector of values containing the matrix contents, possibly as a window of a larger array.
+     * The element at row `r` and column `c` is stored at `values[offset + r * leading_dimension + c]` for row-major matrices,
+     * or `values[offset + c * leading_dimension + r]` otherwise, where `offset` and `leading_dimension` are defined in `options`.
+     * @param row_major Whether `values` stores the matrix contents in a row-major representation.
+     * If `false`, a column-major representation is assumed instead.
+     * @param options Further options.
+     */
+    DenseMatrix(const Index_ nrow, const Index_ ncol, Storage_ values, const bool row_major, const DenseMatrixOptions& options) :
+        my_nrow(nrow), my_ncol(ncol), my_values(std::move(values)), my_row_major(row_major)
+    {
+        const Index_ sec = secondary();
+        if (options.leading_dimension == 0) {
+            my_leading_dimension = sanisizer::cast<StorageSize>(attest_for_Index(sec));
+        } else {
+            if (!sanisizer::is_greater_than_or_equal(options.leading_dimension, sec)) {
+                throw std::runtime_error("'leading_dimension' should be no less than the number of " + std::string(my_row_major ? "columns" : "rows"));
+            }
+            my_leading_dimension = sanisizer::cast<StorageSize>(options.leading_dimension);
+        }
+        my_offset = sanisizer::cast<StorageSize>(options.offset);
+
+        // Checking that the last element is addressable, while being careful about overflow when computing its position.
+        const Index_ prim = primary();
+        StorageSize required = my_offset;
+        if (prim > 0 && sec > 0) {
+            required = sanisizer::sum<StorageSize>(required, sanisizer::product<StorageSize>(my_leading_dimension, prim - 1), attest_for_Index(sec));
+        }
+        if (my_values.size() < required) {
+            throw std::runtime_error("length of 'values' is not sufficient for the specified dimensions, 'offset' and 'leading_dimension'");
+        }
+    }
+
 private: 
     Index_ my_nrow, my_ncol;
     Storage_ my_values;
     bool my_row_major;
 
+    typedef DenseMatrix_internals::StorageSize<Storage_> StorageSize;
+    StorageSize my_offset, my_leading_dimension;
+
 public:
     Index_ nrow() const { return my_nrow; }
 
@@ -240,31 +377,137 @@ private:
         }
     }
 
+    /*****************************
+     **** Subset materializing ***
+     *****************************/
+private:
+    template<class Function_>
+    void subset_materialize_setup(const std::vector<Index_>* const row_subset, const std::vector<Index_>* const column_subset, const Function_ fun) const {
+        const auto primary_subset = (my_row_major ? row_subset : column_subset);
+        const auto secondary_subset = (my_row_major ? column_subset : row_subset);
+        const Index_ num_primary = (primary_subset ? primary_subset->size() : primary());
+        const Index_ num_secondary = (secondary_subset ? secondary_subset->size() : secondary());
+
+        // Iterator to the start of the stored primary dimension element for the p-th primary dimension element of the subset.
+        const auto get_primary = [&](const Index_ p) -> auto {
+            const Index_ stored = (primary_subset ? (*primary_subset)[p] : p);
+            return my_values.begin() + (my_offset + sanisizer::product_unsafe<StorageSize>(my_leading_dimension, stored));
+        };
+        const auto get_secondary = [&](const Index_ s) -> StorageSize {
+            return (secondary_subset ? (*secondary_subset)[s] : s);
+        };
+
+        fun(primary_subset, secondary_subset, num_primary, num_secondary, get_primary, get_secondary);
+    }
+
+public:
+    /**
+     * @cond
+     */
+    std::unique_ptr<SubsetScanner<Value_, Index_> > subset_scanner(
+        const std::vector<Index_>* const row_subset,
+        const std::vector<Index_>* const column_subset
+    ) const {
+        return std::make_unique<DenseMatrix_internals::DenseSubsetScanner<Value_, Index_, Storage_> >(
+            my_values,
+            my_offset,
+            my_leading_dimension,
+            my_row_major,
+            primary(),
+            secondary(),
+            (my_row_major ? row_subset : column_subset),
+            (my_row_major ? column_subset : row_subset)
+        );
+    }
+
+    void subset_materialize(
+        const std::vector<Index_>* const row_subset,
+        const std::vector<Index_>* const column_subset,
+        const bool row_major,
+        Value_* const store,
+        const int num_threads
+    ) const {
+        subset_materialize_setup(row_subset, column_subset, [&](const auto primary_subset, const auto secondary_subset, const Index_ num_primary, const Index_ num_secondary, const auto get_primary, const auto get_secondary) -> void {
+            // We assume that 'store' was allocated correctly, in which case the product of 'num_primary' and 'num_secondary' is known to fit inside a std::size_t.
+            if (row_major == my_row_major) {
+                std::optional<GatherIndices<Index_> > gatherer;
+                if (secondary_subset) {
+                    gatherer.emplace(secondary_subset->data(), secondary_subset->size());
+                }
+                parallelize([&](const int, const Index_ start, const Index_ length) -> void {
+                    for (Index_ p = start, end = start + length; p < end; ++p) {
+                        const auto output = store + sanisizer::product_unsafe<std::size_t>(p, num_secondary);
+                        if (gatherer.has_value()) {
+                            gatherer->gather(get_primary(p), output);
+                        } else {
+                            std::copy_n(get_primary(p), num_secondary, output);
+                        }
+                    }
+                }, num_primary, num_threads);
+                return;
+            }
+
+            // Otherwise, each worker transposes a contiguous range of the stored secondary dimension into its own range of the output.
+            parallelize([&](const int, const Index_ start, const Index_ length) -> void {
+                const auto output = store + sanisizer::product_unsafe<std::size_t>(start, num_primary);
+
+                if constexpr(has_data<ElementType<Storage_>, Storage_>::value) {
+                    if (!primary_subset && !secondary_subset) {
+                        transpose(my_values.data() + my_offset + start, num_primary, length, my_leading_dimension, output, num_primary);
+                        return;
+                    }
+                }
+
+                // Same blocking strategy as transpose(), but with remapping of the indices.
+                constexpr Index_ block_size = 16;
+                Index_ sec_i = 0;
+                while (sec_i < length) {
+                    const Index_ sec_end = sec_i + std::min(static_cast<Index_>(length - sec_i), block_size);
+                    Index_ prim_i = 0;
+                    while (prim_i < num_primary) {
+                        const Index_ prim_end = prim_i + std::min(static_cast<Index_>(num_primary - prim_i), block_size);
+                        for (Index_ p = prim_i; p < prim_end; ++p) {
+                            const auto src = get_primary(p);
+                            for (Index_ s = sec_i; s < sec_end; ++s) {
+                                output[sanisizer::nd_offset<std::size_t>(p, num_primary, s)] = src[get_secondary(start + s)];
+                            }
+                        }
+                        prim_i = prim_end;
+                    }
+                    sec_i = sec_end;
+                }
+            }, num_secondary, num_threads);
+        });
+    }
+    /**
+     * @endcond
+     */
+
     /*****************************
      ******* Dense myopic ********
      *****************************/
 public:
     std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(const bool row, const Options&) const {
         if (my_row_major == row) {
-            return std::make_unique<DenseMatrix_internals::PrimaryMyopicFullDense<Value_, Index_, Storage_> >(my_values, secondary());
+            return std::make_unique<DenseMatrix_internals::PrimaryMyopicFullDense<Value_, Index_, Storage_> >(my_values, my_offset, my_leading_dimension, secondary());
         } else {
-            return std::make_unique<DenseMatrix_internals::SecondaryMyopicFullDense<Value_, Index_, Storage_> >(my_values, secondary(), primary()); 
+            return std::make_unique<DenseMatrix_internals::SecondaryMyopicFullDense<Value_, Index_, Storage_> >(my_values, my_offset, my_leading_dimension, primary()); 
         }
     }
 
     std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(const bool row, const Index_ block_start, const Index_ block_length, const Options&) const {
         if (my_row_major == row) { 
-            return std::make_unique<DenseMatrix_internals::PrimaryMyopicBlockDense<Value_, Index_, Storage_> >(my_values, secondary(), block_start, block_length);
+            return std::make_unique<DenseMatrix_internals::PrimaryMyopicBlockDense<Value_, Index_, Storage_> >(my_values, my_offset, my_leading_dimension, block_start, block_length);
         } else {
-            return std::make_unique<DenseMatrix_internals::SecondaryMyopicBlockDense<Value_, Index_, Storage_> >(my_values, secondary(), block_start, block_length);
+            return std::make_unique<DenseMatrix_internals::SecondaryMyopicBlockDense<Value_, Index_, Storage_> >(my_values, my_offset, my_leading_dimension, block_start, block_length);
         }
     }
 
     std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(const bool row, VectorPtr<Index_> indices_ptr, const Options&) const {
         if (my_row_major == row) {
-            return std::make_unique<DenseMatrix_internals::PrimaryMyopicIndexDense<Value_, Index_, Storage_> >(my_values, secondary(), std::move(indices_ptr));
+            return std::make_unique<DenseMatrix_internals::PrimaryMyopicIndexDense<Value_, Index_, Storage_> >(my_values, my_offset, my_leading_dimension, std::move(indices_ptr));
         } else {
-            return std::make_unique<DenseMatrix_internals::SecondaryMyopicIndexDense<Value_, Index_, Storage_> >(my_values, secondary(), std::move(indices_ptr));
+            return std::make_unique<DenseMatrix_internals::SecondaryMyopicIndexDense<Value_, Index_, Storage_> >(my_values, my_offset, my_leading_dimension, std::move(indices_ptr));
         }
     }
 
@@ -344,6 +587,15 @@ public:
      * @param values Vector of values of length equal to the product of `nr` and `nc`, storing the matrix in column-major format.
      */
     DenseColumnMatrix(const Index_ nrow, const Index_ ncol, Storage_ values) : DenseMatrix<Value_, Index_, Storage_>(nrow, ncol, std::move(values), false) {}
+
+    /**
+     * @param nrow Number of rows.
+     * @param ncol Number of columns.
+     * @param values Vector of values storing the matrix in column-major format, see the `DenseMatrix` constructor for details.
+     * @param options Further options.
+     */
+    DenseColumnMatrix(const Index_ nrow, const Index_ ncol, Storage_ values, const DenseMatrixOptions& options) :
+        DenseMatrix<Value_, Index_, Storage_>(nrow, ncol, std::move(values), false, options) {}
 };
 
 /**
@@ -360,6 +612,15 @@ public:
      * @param values Vector of values of length equal to the product of `nr` and `nc`, storing the matrix in row-major format.
      */
     DenseRowMatrix(const Index_ nrow, const Index_ ncol, Storage_ values) : DenseMatrix<Value_, Index_, Storage_>(nrow, ncol, std::move(values), true) {}
+
+    /**
+     * @param nrow Number of rows.
+     * @param ncol Number of columns.
+     * @param values Vector of values storing the matrix in row-major format, see the `DenseMatrix` constructor for details.
+     * @param options Further options.
+     */
+    DenseRowMatrix(const Index_ nrow, const Index_ ncol, Storage_ values, const DenseMatrixOptions& options) :
+        DenseMatrix<Value_, Index_, Storage_>(nrow, ncol, std::move(values), true, options) {}
 };
 
 }
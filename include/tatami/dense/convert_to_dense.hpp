@@ -6,8 +6,11 @@
 
 #include "../utils/consecutive_extractor.hpp"
 #include "../utils/parallelize.hpp"
+#include "../utils/parallelize_numa.hpp"
 #include "../utils/copy.hpp"
 #include "../utils/Index_to_container.hpp"
+#include "../utils/DefaultInitAllocator.hpp"
+#include "../subset/subset_materialize.hpp"
 
 #include <memory>
 #include <vector>
@@ -28,7 +31,7 @@ namespace tatami {
  */
 struct ConvertToDenseOptions {
     /**
-     * Number of threads to use, for parallelization with `parallelize()`.
+     * Number of threads to use, for parallelization with `parallelize()` or `parallelize_numa()`.
      */
     int num_threads = 1;
 };
@@ -46,7 +49,9 @@ void convert_to_dense_direct(const Matrix<InputValue_, InputIndex_>& matrix, con
     constexpr bool same_type = std::is_same<InputValue_, StoredValue_>::value;
     can_cast_Index_to_container_size<std::vector<InputValue_> >(secondary);
 
-    parallelize([&](const int, const InputIndex_ start, const InputIndex_ length) -> void {
+    // Each worker writes (and thus first touches) its own range of the primary dimension,
+    // so using the same NUMA-aware ranges as convert_to_dense_first_touch().
+    parallelize_numa([&](const int, const InputIndex_ start, const InputIndex_ length) -> void {
         auto wrk = consecutive_extractor<false, InputValue_, InputIndex_>(matrix, row, start, length);
         auto temp = [&]{
             if constexpr(same_type) {
@@ -69,6 +74,24 @@ void convert_to_dense_direct(const Matrix<InputValue_, InputIndex_>& matrix, con
     }, primary, options.num_threads);
 }
 
+template <typename StoredValue_, typename InputIndex_>
+void convert_to_dense_first_touch(StoredValue_* const store, const InputIndex_ primary, const InputIndex_ secondary, const ConvertToDenseOptions& options) {
+    // Zeroing the output in parallel across the primary dimension, rather than on the main thread.
+    // Each range is processed by a thread that is pinned to the NUMA node from numa_node_for_task(),
+    // so its pages are placed on the same node that is used for that range in later calls to parallelize_numa() over the output's primary dimension,
+    // assuming that 'store' was not previously touched (e.g., allocated with DefaultInitAllocator).
+    //
+    // We assume that 'store' was allocated correctly, in which case the product of 'primary' and 'secondary' is known to fit inside a std::size_t.
+    // This saves us from various checks when computing related products. 
+    parallelize_numa([&](const int, const InputIndex_ start, const InputIndex_ length) -> void {
+        std::fill_n(
+            store + sanisizer::product_unsafe<std::size_t>(start, secondary),
+            sanisizer::product_unsafe<std::size_t>(length, secondary),
+            0
+        );
+    }, primary, options.num_threads);
+}
+
 template <typename StoredValue_, typename InputValue_, typename InputIndex_>
 void convert_to_dense_running_from_sparse(const Matrix<InputValue_, InputIndex_>& matrix, const bool row, StoredValue_* const store, const ConvertToDenseOptions& options) {
     const InputIndex_ NR = matrix.nrow();
@@ -101,9 +124,7 @@ void convert_to_dense_running_from_sparse(const Matrix<InputValue_, InputIndex_>
         all_partial_contents.emplace(sanisizer::cast<I<decltype(all_partial_contents->size())> >(options.num_threads - 1));
     }
 
-    // We assume that 'store' was allocated correctly, in which case the product of 'primary' and 'secondary' is known to fit inside a std::size_t.
-    // This saves us from various checks when computing related products. 
-    std::fill_n(store, sanisizer::product_unsafe<std::size_t>(primary, secondary), 0);
+    convert_to_dense_first_touch(store, primary, secondary, options);
 
     const auto num_used = parallelize([&](const int thread, const InputIndex_ start, const InputIndex_ length) -> void {
         auto wrk = consecutive_extractor<true, InputValue_, InputIndex_>(matrix, !row, start, length);
@@ -177,9 +198,7 @@ void convert_to_dense_running_from_dense(const Matrix<InputValue_, InputIndex_>&
         all_partial_contents.emplace(sanisizer::cast<I<decltype(all_partial_contents->size())> >(options.num_threads - 1));
     }
 
-    // We assume that 'store' was allocated correctly, in which case the product of 'primary' and 'secondary' is known to fit inside a std::size_t.
-    // This saves us from various checks when computing related products. 
-    std::fill_n(store, sanisizer::product_unsafe<std::size_t>(primary, secondary), 0);
+    convert_to_dense_first_touch(store, primary, secondary, options);
 
     const auto num_used = parallelize([&](const int thread, const InputIndex_ start, const InputIndex_ length) -> void {
         auto wrk = consecutive_extractor<false, InputValue_, InputIndex_>(matrix, !row, start, length);
@@ -247,10 +266,21 @@ void convert_to_dense_running_from_dense(const Matrix<InputValue_, InputIndex_>&
  * @param row_major Whether to store the output as a row-major matrix.
  * @param[out] store Pointer to an array of length equal to the product of the dimensions of `matrix`.
  * On output, this is filled with values from `matrix` in row- or column-major format depending on `row_major`.
+ * Each contiguous range of rows (if `row_major = true`) or columns of `store` is first written by a worker in `parallelize_numa()`,
+ * using the same ranges as any other call to `parallelize_numa()` over the same dimension with the same number of threads.
+ * If `store` has not yet been touched, e.g., it was allocated with `DefaultInitAllocator`, each range's pages will be placed on the NUMA node assigned to that range by `numa_node_for_task()`.
+ * When the output is not in the preferred orientation of `matrix`, the values are then filled in by separate passes over the other dimension, but this does not affect the page placement.
  * @param options Further options.
  */
 template <typename StoredValue_, typename InputValue_, typename InputIndex_>
 void convert_to_dense(const Matrix<InputValue_, InputIndex_>& matrix, const bool row_major, StoredValue_* const store, const ConvertToDenseOptions& options) {
+    // Delayed subsets and transpositions of a concrete matrix can be materialized directly from its storage, e.g., for a transposed CompressedSparseMatrix.
+    if constexpr(std::is_same<StoredValue_, InputValue_>::value) {
+        if (subset_materialize(matrix, row_major, store, options.num_threads)) {
+            return;
+        }
+    }
+
     if (row_major == matrix.prefer_rows()) {
         convert_to_dense_direct(matrix, row_major, store, options);
     } else if (matrix.is_sparse()) {
@@ -273,6 +303,9 @@ void convert_to_dense(const Matrix<InputValue_, InputIndex_>& matrix, const bool
  *
  * @return A pointer to a new `tatami::DenseMatrix` with the same dimensions and type as the matrix referenced by `matrix`.
  * If `row_major = true`, the matrix is row-major, otherwise it is column-major.
+ * The storage type of the returned `tatami::DenseMatrix` is `std::vector<StoredValue_, DefaultInitAllocator<StoredValue_> >`,
+ * so that the pages of the array are first touched by the NUMA-pinned workers in `parallelize_numa()`, see the other `convert_to_dense()` overload for details.
+ * (Earlier versions of **tatami** used `std::vector<StoredValue_>`; callers that `dynamic_cast` the result to a specific `tatami::DenseMatrix` should use the new storage type.)
  */
 template <
     typename Value_,
@@ -284,8 +317,11 @@ template <
 std::shared_ptr<Matrix<Value_, Index_> > convert_to_dense(const Matrix<InputValue_, InputIndex_>& matrix, const bool row_major, const ConvertToDenseOptions& options) {
     const auto NR = matrix.nrow();
     const auto NC = matrix.ncol();
-    const auto buffer_size = sanisizer::product<typename std::vector<StoredValue_>::size_type>(attest_for_Index(NR), attest_for_Index(NC));
-    std::vector<StoredValue_> buffer(buffer_size);
+
+    // Using a default-initializing allocator so that the pages are first touched by the pinned workers in the conversion, not by the main thread.
+    typedef std::vector<StoredValue_, DefaultInitAllocator<StoredValue_> > Buffer;
+    const auto buffer_size = sanisizer::product<typename Buffer::size_type>(attest_for_Index(NR), attest_for_Index(NC));
+    Buffer buffer(buffer_size);
     convert_to_dense(matrix, row_major, buffer.data(), options);
 
     return std::shared_ptr<Matrix<Value_, Index_> >(
@@ -3,6 +3,8 @@
 
 #include <cmath>
 #include <limits>
+#include <type_traits>
+#include <utility>
 
 #include "../utils/copy.hpp"
 
@@ -129,6 +131,183 @@ constexpr bool has_unsafe_divide_by_zero() {
     return false;
 }
 
+// Division and exponentiation by a fixed scalar can often be replaced by
+// cheaper operations. This class decides which replacement (if any) is valid
+// for a given scalar, so that the decision is made once per array rather than
+// once per element; each replacement is then applied in its own simple loop
+// that can be auto-vectorized by the compiler.
+enum class DelayedArithmeticKernel : char {
+    GENERIC,
+    RECIPROCAL_MULTIPLY,
+    POWER_ZERO,
+    POWER_ONE,
+    POWER_SQUARE,
+    POWER_SQRT,
+    POWER_RECIPROCAL,
+    POWER_INTEGER,
+    POWER_HALF_INTEGER
+};
+
+template<typename Product_>
+Product_ delayed_arithmetic_integer_power(Product_ base, unsigned int exponent) {
+    Product_ output = 1;
+    while (exponent) {
+        if (exponent & 1u) {
+            output *= base;
+        }
+        base *= base;
+        exponent >>= 1;
+    }
+    return output;
+}
+
+template<typename Input_, typename Index_, typename Output_, class Function_>
+void delayed_arithmetic_run_kernel(const Input_* input, const Index_ length, Output_* const output, Function_ fun) {
+    if constexpr(std::is_same<Input_, Output_>::value) {
+        input = output; // basically an assertion to the compiler to skip aliasing protection.
+    }
+    for (Index_ i = 0; i < length; ++i) {
+        output[i] = fun(input[i]);
+    }
+}
+
+template<ArithmeticOperation op_, bool right_, typename Value_, typename Scalar_>
+class DelayedArithmeticScalarKernel {
+public:
+    typedef I<decltype(delayed_arithmetic<op_, right_>(std::declval<Value_>(), std::declval<Scalar_>()))> Product;
+
+    DelayedArithmeticScalarKernel(const Scalar_ scalar, [[maybe_unused]] const bool allow_inexact) : my_scalar(scalar) {
+        if constexpr(right_ && std::numeric_limits<Product>::is_iec559) {
+            if constexpr(op_ == ArithmeticOperation::DIVIDE) {
+                const Product denom = scalar;
+                const Product recip = static_cast<Product>(1) / denom;
+
+                // Multiplication by the reciprocal is exact if the scalar is a power of two,
+                // as both operations only need to shift the exponent of the other operand.
+                if (std::isfinite(recip) && recip != 0) {
+                    int exp;
+                    if (allow_inexact || std::abs(std::frexp(denom, &exp)) == static_cast<Product>(0.5)) {
+                        my_kernel = DelayedArithmeticKernel::RECIPROCAL_MULTIPLY;
+                        my_reciprocal = recip;
+                    }
+                }
+
+            } else if constexpr(op_ == ArithmeticOperation::POWER) {
+                // These replacements yield the correctly rounded result of the power operation,
+                // and respect the special cases in std::pow for zeros, infinities and NaNs.
+                const Product exponent = scalar;
+                if (exponent == 0) {
+                    my_kernel = DelayedArithmeticKernel::POWER_ZERO;
+                } else if (exponent == 1) {
+                    my_kernel = DelayedArithmeticKernel::POWER_ONE;
+                } else if (exponent == 2) {
+                    my_kernel = DelayedArithmeticKernel::POWER_SQUARE;
+                } else if (exponent == static_cast<Product>(0.5)) {
+                    my_kernel = DelayedArithmeticKernel::POWER_SQRT;
+                } else if (exponent == -1) {
+                    my_kernel = DelayedArithmeticKernel::POWER_RECIPROCAL;
+
+                } else if (allow_inexact) {
+                    // Repeated multiplication accumulates rounding error, so this is only used on request.
+                    // We also limit the size of the exponent to avoid excessive error.
+                    constexpr Product max_exponent = 64;
+                    const Product abs_exponent = std::abs(exponent);
+                    if (abs_exponent <= max_exponent) {
+                        my_negative = exponent < 0;
+                        const Product floored = std::floor(abs_exponent);
+                        my_integer = floored;
+                        if (floored == abs_exponent) {
+                            my_kernel = DelayedArithmeticKernel::POWER_INTEGER;
+                        } else if (abs_exponent - floored == static_cast<Product>(0.5)) {
+                            my_kernel = DelayedArithmeticKernel::POWER_HALF_INTEGER;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    Scalar_ my_scalar;
+    DelayedArithmeticKernel my_kernel = DelayedArithmeticKernel::GENERIC;
+    Product my_reciprocal = 0;
+    unsigned int my_integer = 0;
+    bool my_negative = false;
+
+public:
+    DelayedArithmeticKernel kernel() const {
+        return my_kernel;
+    }
+
+    template<typename Input_, typename Index_, typename Output_>
+    void run(const Input_* const input, const Index_ length, Output_* const output) const {
+        if constexpr(right_ && std::numeric_limits<Product>::is_iec559) {
+            switch (my_kernel) {
+                case DelayedArithmeticKernel::RECIPROCAL_MULTIPLY:
+                    delayed_arithmetic_run_kernel(input, length, output, [&](const Input_ x) -> Product { return x * my_reciprocal; });
+                    return;
+
+                case DelayedArithmeticKernel::POWER_ZERO:
+                    delayed_arithmetic_run_kernel(input, length, output, [&](const Input_) -> Product { return 1; });
+                    return;
+
+                case DelayedArithmeticKernel::POWER_ONE:
+                    delayed_arithmetic_run_kernel(input, length, output, [&](const Input_ x) -> Product { return x; });
+                    return;
+
+                case DelayedArithmeticKernel::POWER_SQUARE:
+                    delayed_arithmetic_run_kernel(input, length, output, [&](const Input_ x) -> Product { 
+                        const Product y = x;
+                        return y * y;
+                    });
+                    return;
+
+                case DelayedArithmeticKernel::POWER_SQRT:
+                    delayed_arithmetic_run_kernel(input, length, output, [&](const Input_ x) -> Product {
+                        // std::pow returns +0 for -0 and +Inf for -Inf, unlike std::sqrt.
+                        const Product y = x;
+                        if (y == 0) {
+                            return 0;
+                        } else if (std::isinf(y)) {
+                            return std::abs(y);
+                        } else {
+                            return std::sqrt(y);
+                        }
+                    });
+                    return;
+
+                case DelayedArithmeticKernel::POWER_RECIPROCAL:
+                    delayed_arithmetic_run_kernel(input, length, output, [&](const Input_ x) -> Product { return static_cast<Product>(1) / static_cast<Product>(x); });
+                    return;
+
+                case DelayedArithmeticKernel::POWER_INTEGER:
+                    delayed_arithmetic_run_kernel(input, length, output, [&](const Input_ x) -> Product {
+                        const Product out = delayed_arithmetic_integer_power<Product>(x, my_integer);
+                        return (my_negative ? static_cast<Product>(1) / out : out);
+                    });
+                    return;
+
+                case DelayedArithmeticKernel::POWER_HALF_INTEGER:
+                    delayed_arithmetic_run_kernel(input, length, output, [&](const Input_ x) -> Product {
+                        // The product of the integer power and the square root does not have the same sign or special values as std::pow for zeros and infinities.
+                        const Product y = x;
+                        if (y == 0 || std::isinf(y)) {
+                            return std::pow(y, static_cast<Product>(my_scalar));
+                        }
+                        const Product out = delayed_arithmetic_integer_power<Product>(y, my_integer) * std::sqrt(y);
+                        return (my_negative ? static_cast<Product>(1) / out : out);
+                    });
+                    return;
+
+                default:
+                    break;
+            }
+        }
+
+        delayed_arithmetic_run_kernel(input, length, output, [&](const Input_ x) -> Product { return delayed_arithmetic<op_, right_>(x, my_scalar); });
+    }
+};
+
 // COMMENT: if the fill value is visible at a compile time, the coercion to the
 // output type is also visible. If the output type cannot hold the fill value,
 // we could potentially get more compile-time UB. (This mostly concerns NaNs or
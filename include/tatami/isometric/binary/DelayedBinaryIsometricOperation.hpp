@@ -46,16 +46,32 @@ public:
         my_oracle(oracle, my_helper, row)
     {
         my_left_ext = new_extractor<false, oracle_>(left, my_row, oracle, opt);
-        my_right_ext = new_extractor<false, oracle_>(right, my_row, std::move(oracle), opt);
+        if (&left != &right) {
+            my_right_ext = new_extractor<false, oracle_>(right, my_row, std::move(oracle), opt);
+        }
         my_extent = my_row ? left.ncol() : left.nrow();
 
         resize_container_to_Index_size(my_right_holding_buffer, my_extent);
         if constexpr(!same_value) {
-            my_left_holding_buffer.resize(my_right_holding_buffer.size());
+            if (my_right_ext) {
+                my_left_holding_buffer.resize(my_right_holding_buffer.size());
+            }
         }
     }
 
     const OutputValue_* fetch(const Index_ i, OutputValue_* const buffer) {
+        if (!my_right_ext) {
+            // Both operands are the same matrix, so we only need to extract once.
+            const auto ptr = my_left_ext->fetch(i, my_right_holding_buffer.data());
+            if constexpr(same_value) {
+                copy_n(ptr, my_extent, buffer);
+                my_helper.dense(my_row, my_oracle.get(i), static_cast<Index_>(0), my_extent, buffer, ptr, buffer);
+            } else {
+                my_helper.dense(my_row, my_oracle.get(i), static_cast<Index_>(0), my_extent, ptr, ptr, buffer);
+            }
+            return buffer;
+        }
+
         const auto rptr = my_right_ext->fetch(i, my_right_holding_buffer.data());
 
         if constexpr(same_value) {
@@ -102,15 +118,31 @@ public:
         my_block_length(block_length)
     {
         my_left_ext = new_extractor<false, oracle_>(left, my_row, oracle, my_block_start, my_block_length, opt);
-        my_right_ext = new_extractor<false, oracle_>(right, my_row, std::move(oracle), my_block_start, my_block_length, opt);
+        if (&left != &right) {
+            my_right_ext = new_extractor<false, oracle_>(right, my_row, std::move(oracle), my_block_start, my_block_length, opt);
+        }
 
         resize_container_to_Index_size(my_right_holding_buffer, my_block_length);
         if constexpr(!same_value) {
-            my_left_holding_buffer.resize(my_right_holding_buffer.size());
+            if (my_right_ext) {
+                my_left_holding_buffer.resize(my_right_holding_buffer.size());
+            }
         }
     }
 
     const OutputValue_* fetch(const Index_ i, OutputValue_* const buffer) {
+        if (!my_right_ext) {
+            // Both operands are the same matrix, so we only need to extract once.
+            const auto ptr = my_left_ext->fetch(i, my_right_holding_buffer.data());
+            if constexpr(same_value) {
+                copy_n(ptr, my_block_length, buffer);
+                my_helper.dense(my_row, my_oracle.get(i), my_block_start, my_block_length, buffer, ptr, buffer);
+            } else {
+                my_helper.dense(my_row, my_oracle.get(i), my_block_start, my_block_length, ptr, ptr, buffer);
+            }
+            return buffer;
+        }
+
         const auto rptr = my_right_ext->fetch(i, my_right_holding_buffer.data());
 
         if constexpr(same_value) {
@@ -155,18 +187,35 @@ public:
         my_indices_ptr(std::move(indices_ptr))
     {
         my_left_ext = new_extractor<false, oracle_>(left, my_row, oracle, my_indices_ptr, opt);
-        my_right_ext = new_extractor<false, oracle_>(right, my_row, std::move(oracle), my_indices_ptr, opt);
+        if (&left != &right) {
+            my_right_ext = new_extractor<false, oracle_>(right, my_row, std::move(oracle), my_indices_ptr, opt);
+        }
 
         resize_container_to_Index_size(my_right_holding_buffer, my_indices_ptr->size());
         if constexpr(!same_value) {
-            my_left_holding_buffer.resize(my_right_holding_buffer.size());
+            if (my_right_ext) {
+                my_left_holding_buffer.resize(my_right_holding_buffer.size());
+            }
         }
     }
 
     const OutputValue_* fetch(const Index_ i, OutputValue_* const buffer) {
-        const auto rptr = my_right_ext->fetch(i, my_right_holding_buffer.data());
         const auto& indices = *my_indices_ptr;
 
+        if (!my_right_ext) {
+            // Both operands are the same matrix, so we only need to extract once.
+            const auto ptr = my_left_ext->fetch(i, my_right_holding_buffer.data());
+            if constexpr(same_value) {
+                copy_n(ptr, indices.size(), buffer);
+                my_helper.dense(my_row, my_oracle.get(i), indices, buffer, ptr, buffer);
+            } else {
+                my_helper.dense(my_row, my_oracle.get(i), indices, ptr, ptr, buffer);
+            }
+            return buffer;
+        }
+
+        const auto rptr = my_right_ext->fetch(i, my_right_holding_buffer.data());
+
         if constexpr(same_value) {
             const auto lptr = my_left_ext->fetch(i, buffer);
             copy_n(lptr, indices.size(), buffer);
@@ -214,22 +263,24 @@ public:
         opt.sparse_extract_index = true;
         opt.sparse_ordered_index = true;
         my_left_ext = new_extractor<true, oracle_>(left, my_row, oracle, opt);
-        my_right_ext = new_extractor<true, oracle_>(right, my_row, std::move(oracle), opt);
+        if (&left != &right) {
+            my_right_ext = new_extractor<true, oracle_>(right, my_row, std::move(oracle), opt);
+        }
         my_extent = my_row ? left.ncol() : left.nrow();
 
         resize_container_to_Index_size(my_left_vbuffer, my_extent);
-        my_right_vbuffer.resize(my_left_vbuffer.size());
-
         resize_container_to_Index_size(my_output_vbuffer, my_extent);
-
         resize_container_to_Index_size(my_left_ibuffer, my_extent);
-        my_right_ibuffer.resize(my_left_ibuffer.size());
         my_output_ibuffer.resize(my_left_ibuffer.size());
+        if (my_right_ext) {
+            my_right_vbuffer.resize(my_left_vbuffer.size());
+            my_right_ibuffer.resize(my_left_ibuffer.size());
+        }
     }
 
     const OutputValue_* fetch(Index_ i, OutputValue_* const buffer) {
         const auto lres = my_left_ext->fetch(i, my_left_vbuffer.data(), my_left_ibuffer.data());
-        const auto rres = my_right_ext->fetch(i, my_right_vbuffer.data(), my_right_ibuffer.data());
+        const auto rres = (my_right_ext ? my_right_ext->fetch(i, my_right_vbuffer.data(), my_right_ibuffer.data()) : lres);
 
         i = my_oracle.get(i);
         const auto num = my_helper.sparse(my_row, i, lres, rres, my_output_vbuffer.data(), my_output_ibuffer.data(), true, true);
@@ -281,21 +332,23 @@ public:
         opt.sparse_extract_index = true;
         opt.sparse_ordered_index = true;
         my_left_ext = new_extractor<true, oracle_>(left, my_row, oracle, my_block_start, my_block_length, opt);
-        my_right_ext = new_extractor<true, oracle_>(right, my_row, std::move(oracle), my_block_start, my_block_length, opt);
+        if (&left != &right) {
+            my_right_ext = new_extractor<true, oracle_>(right, my_row, std::move(oracle), my_block_start, my_block_length, opt);
+        }
 
         resize_container_to_Index_size(my_left_vbuffer, my_block_length);
-        my_right_vbuffer.resize(my_left_vbuffer.size());
-
         resize_container_to_Index_size(my_output_vbuffer, my_block_length);
-
         resize_container_to_Index_size(my_left_ibuffer, my_block_length);
-        my_right_ibuffer.resize(my_left_ibuffer.size());
         my_output_ibuffer.resize(my_left_ibuffer.size());
+        if (my_right_ext) {
+            my_right_vbuffer.resize(my_left_vbuffer.size());
+            my_right_ibuffer.resize(my_left_ibuffer.size());
+        }
     }
 
     const OutputValue_* fetch(Index_ i, OutputValue_* const buffer) {
         const auto lres = my_left_ext->fetch(i, my_left_vbuffer.data(), my_left_ibuffer.data());
-        const auto rres = my_right_ext->fetch(i, my_right_vbuffer.data(), my_right_ibuffer.data());
+        const auto rres = (my_right_ext ? my_right_ext->fetch(i, my_right_vbuffer.data(), my_right_ibuffer.data()) : lres);
 
         i = my_oracle.get(i);
         const auto num = my_helper.sparse(my_row, i, lres, rres, my_output_vbuffer.data(), my_output_ibuffer.data(), true, true);
@@ -357,21 +410,23 @@ public:
         opt.sparse_extract_index = true;
         opt.sparse_ordered_index = true;
         my_left_ext = new_extractor<true, oracle_>(left, my_row, oracle, indices_ptr, opt);
-        my_right_ext = new_extractor<true, oracle_>(right, my_row, std::move(oracle), std::move(indices_ptr), opt);
+        if (&left != &right) {
+            my_right_ext = new_extractor<true, oracle_>(right, my_row, std::move(oracle), std::move(indices_ptr), opt);
+        }
 
         resize_container_to_Index_size(my_left_vbuffer, my_extent);
-        my_right_vbuffer.resize(my_left_vbuffer.size());
-
         resize_container_to_Index_size(my_output_vbuffer, my_extent);
-
         resize_container_to_Index_size(my_left_ibuffer, my_extent);
-        my_right_ibuffer.resize(my_left_ibuffer.size());
         my_output_ibuffer.resize(my_left_ibuffer.size());
+        if (my_right_ext) {
+            my_right_vbuffer.resize(my_left_vbuffer.size());
+            my_right_ibuffer.resize(my_left_ibuffer.size());
+        }
     }
 
     const OutputValue_* fetch(Index_ i, OutputValue_* const buffer) {
         const auto lres = my_left_ext->fetch(i, my_left_vbuffer.data(), my_left_ibuffer.data());
-        const auto rres = my_right_ext->fetch(i, my_right_vbuffer.data(), my_right_ibuffer.data());
+        const auto rres = (my_right_ext ? my_right_ext->fetch(i, my_right_vbuffer.data(), my_right_ibuffer.data()) : lres);
 
         i = my_oracle.get(i);
         const auto num = my_helper.sparse(my_row, i, lres, rres, my_output_vbuffer.data(), my_output_ibuffer.data(), true, true);
@@ -422,9 +477,11 @@ public:
         my_row(row),
         my_oracle(oracle, my_helper, row)
     {
-        initialize(my_row ? left.ncol() : left.nrow(), opt);
+        initialize(my_row ? left.ncol() : left.nrow(), &left == &right, opt);
         my_left_ext = new_extractor<true, oracle_>(left, my_row, oracle, opt);
-        my_right_ext = new_extractor<true, oracle_>(right, my_row, std::move(oracle), opt);
+        if (&left != &right) {
+            my_right_ext = new_extractor<true, oracle_>(right, my_row, std::move(oracle), opt);
+        }
     }
 
     Sparse(
@@ -440,9 +497,11 @@ public:
         my_row(row),
         my_oracle(oracle, my_helper, row)
     {
-        initialize(block_length, opt);
+        initialize(block_length, &left == &right, opt);
         my_left_ext = new_extractor<true, oracle_>(left, my_row, oracle, block_start, block_length, opt);
-        my_right_ext = new_extractor<true, oracle_>(right, my_row, std::move(oracle), block_start, block_length, opt);
+        if (&left != &right) {
+            my_right_ext = new_extractor<true, oracle_>(right, my_row, std::move(oracle), block_start, block_length, opt);
+        }
     }
 
     Sparse(
@@ -457,22 +516,28 @@ public:
         my_row(row),
         my_oracle(oracle, my_helper, row)
     {
-        initialize(indices_ptr->size(), opt); // do this before the move.
+        initialize(indices_ptr->size(), &left == &right, opt); // do this before the move.
         my_left_ext = new_extractor<true, oracle_>(left, my_row, oracle, indices_ptr, opt);
-        my_right_ext = new_extractor<true, oracle_>(right, my_row, std::move(oracle), std::move(indices_ptr), opt);
+        if (&left != &right) {
+            my_right_ext = new_extractor<true, oracle_>(right, my_row, std::move(oracle), std::move(indices_ptr), opt);
+        }
     }
 
 private:
-    void initialize(std::size_t extent, Options& opt) {
+    void initialize(std::size_t extent, const bool same_operand, Options& opt) {
         my_report_value = opt.sparse_extract_value;
         my_report_index = opt.sparse_extract_index;
 
         resize_container_to_Index_size(my_left_ibuffer, extent);
-        my_right_ibuffer.resize(my_left_ibuffer.size());
+        if (!same_operand) {
+            my_right_ibuffer.resize(my_left_ibuffer.size());
+        }
 
         if (my_report_value) {
             resize_container_to_Index_size(my_left_vbuffer, extent);
-            my_right_vbuffer.resize(my_left_vbuffer.size());
+            if (!same_operand) {
+                my_right_vbuffer.resize(my_left_vbuffer.size());
+            }
         }
 
         opt.sparse_ordered_index = true;
@@ -482,7 +547,7 @@ private:
 public:
     SparseRange<OutputValue_, Index_> fetch(const Index_ i, OutputValue_* const value_buffer, Index_* const index_buffer) {
         const auto left_ranges = my_left_ext->fetch(i, my_left_vbuffer.data(), my_left_ibuffer.data());
-        const auto right_ranges = my_right_ext->fetch(i, my_right_vbuffer.data(), my_right_ibuffer.data());
+        const auto right_ranges = (my_right_ext ? my_right_ext->fetch(i, my_right_vbuffer.data(), my_right_ibuffer.data()) : left_ranges);
         const auto num = my_helper.sparse(
             my_row, 
             my_oracle.get(i), 
@@ -528,6 +593,9 @@ private:
  *
  * This class is inspired by the `DelayedNaryIsoOp` class in the **DelayedArray** Bioconductor package.
  *
+ * If the left and right matrices are the same object, e.g., for operations like `x * x`, 
+ * each row/column is only extracted once from the underlying matrix and used as both operands.
+ *
  * @tparam OutputValue_ Type of the result of the operation.
  * This is the type of the value of the output matrix.
  * @tparam InputValue_ Type of the value of the input matrices, to use in the operation.
@@ -5,7 +5,9 @@
 #include "helper_interface.hpp"
 #include <vector>
 #include <limits>
+#include <cmath>
 #include <type_traits>
+#include <utility>
 
 /**
  * @file arithmetic_helpers.hpp
@@ -18,16 +20,6 @@ namespace tatami {
 /**
  * @cond
  */
-template<ArithmeticOperation op_, bool right_, typename InputValue_, typename Index_, typename Scalar_, typename OutputValue_>
-void delayed_arithmetic_run_simple(const InputValue_* input, const Index_ length, const Scalar_ scalar, OutputValue_* const output) {
-    if constexpr(std::is_same<InputValue_, OutputValue_>::value) {
-        input = output; // basically an assertion to the compiler to skip aliasing protection.
-    }
-    for (Index_ i = 0; i < length; ++i) {
-        output[i] = delayed_arithmetic<op_, right_>(input[i], scalar);
-    }
-}
-
 // The '*_actual_sparse' and '*_zero' functions should be mirrors of each other;
 // we enforce this by putting their logic all in the same place.
 template<bool check_only_, ArithmeticOperation op_, bool right_, typename OutputValue_, typename InputValue_, typename Scalar_>
@@ -74,6 +66,22 @@ OutputValue_ delayed_arithmetic_zero(const Scalar_ scalar) {
  * @endcond
  */
 
+/**
+ * @brief Options for the delayed unary isometric arithmetic helpers.
+ */
+struct DelayedUnaryIsometricArithmeticOptions {
+    /**
+     * Whether to allow faster computations that are not guaranteed to yield the same result as the naive operation.
+     * If `true`, division by a scalar is replaced with multiplication by its precomputed reciprocal,
+     * and integer or half-integer powers are computed with repeated multiplication and/or `std::sqrt()`.
+     * This only has an effect for IEEE-754 floating-point types, where the results may differ from the naive operation by a few ULPs.
+     *
+     * Regardless of this option, some replacements are always performed when they yield the correctly rounded result,
+     * e.g., multiplication by the reciprocal of a power of two, or `std::sqrt()` for a power of 0.5.
+     */
+    bool allow_inexact = false;
+};
+
 /**
  * @brief Helper for delayed unary isometric scalar arithmetic.
  *
@@ -95,12 +103,23 @@ public:
     /**
      * @param scalar Scalar value to be used in the operation.
      */
-    DelayedUnaryIsometricArithmeticScalarHelper(const Scalar_ scalar) : my_scalar(scalar) {
+    DelayedUnaryIsometricArithmeticScalarHelper(const Scalar_ scalar) :
+        DelayedUnaryIsometricArithmeticScalarHelper(scalar, DelayedUnaryIsometricArithmeticOptions()) {}
+
+    /**
+     * @param scalar Scalar value to be used in the operation.
+     * @param options Further options.
+     */
+    DelayedUnaryIsometricArithmeticScalarHelper(const Scalar_ scalar, const DelayedUnaryIsometricArithmeticOptions& options) :
+        my_scalar(scalar),
+        my_kernel(scalar, options.allow_inexact)
+    {
         my_sparse = delayed_arithmetic_actual_sparse<op_, right_, OutputValue_, InputValue_>(my_scalar);
     }
 
 private:
     Scalar_ my_scalar;
+    DelayedArithmeticScalarKernel<op_, right_, InputValue_, Scalar_> my_kernel;
     bool my_sparse;
 
 public:
@@ -131,11 +150,11 @@ public:
 
 public:
     void dense(const bool, const Index_, const Index_, const Index_ length, const InputValue_* const input, OutputValue_* const output) const {
-        delayed_arithmetic_run_simple<op_, right_>(input, length, my_scalar, output);
+        my_kernel.run(input, length, output);
     }
 
     void dense(const bool, const Index_, const std::vector<Index_>& indices, const InputValue_* const input, OutputValue_* const output) const {
-        delayed_arithmetic_run_simple<op_, right_>(input, static_cast<Index_>(indices.size()), my_scalar, output);
+        my_kernel.run(input, static_cast<Index_>(indices.size()), output);
     }
 
 public:
@@ -144,7 +163,7 @@ public:
     }
 
     void sparse(const bool, const Index_, const Index_ number, const InputValue_* const input_value, const Index_* const, OutputValue_* const output_value) const {
-        delayed_arithmetic_run_simple<op_, right_>(input_value, number, my_scalar, output_value);
+        my_kernel.run(input_value, number, output_value);
     }
 
     OutputValue_ fill(const bool, const Index_) const {
@@ -262,6 +281,11 @@ std::shared_ptr<DelayedUnaryIsometricOperationHelper<OutputValue_, InputValue_,
     return std::make_shared<DelayedUnaryIsometricDivideScalarHelper<right_, OutputValue_, InputValue_, Index_, Scalar_> >(std::move(scalar));
 }
 
+template<bool right_, typename OutputValue_ = double, typename InputValue_ = double, typename Index_ = int, typename Scalar_>
+std::shared_ptr<DelayedUnaryIsometricOperationHelper<OutputValue_, InputValue_, Index_> > make_DelayedUnaryIsometricDivideScalar(Scalar_ scalar, const DelayedUnaryIsometricArithmeticOptions& options) {
+    return std::make_shared<DelayedUnaryIsometricDivideScalarHelper<right_, OutputValue_, InputValue_, Index_, Scalar_> >(std::move(scalar), options);
+}
+
 template<bool right_, typename OutputValue_ = double, typename InputValue_ = double, typename Index_ = int, typename Scalar_>
 std::shared_ptr<DelayedUnaryIsometricOperationHelper<OutputValue_, InputValue_, Index_> > make_DelayedUnaryIsometricModuloScalar(Scalar_ scalar) {
     return std::make_shared<DelayedUnaryIsometricModuloScalarHelper<right_, OutputValue_, InputValue_, Index_, Scalar_> >(std::move(scalar));
@@ -272,6 +296,11 @@ std::shared_ptr<DelayedUnaryIsometricOperationHelper<OutputValue_, InputValue_,
     return std::make_shared<DelayedUnaryIsometricPowerScalarHelper<right_, OutputValue_, InputValue_, Index_, Scalar_> >(std::move(scalar));
 }
 
+template<bool right_, typename OutputValue_ = double, typename InputValue_ = double, typename Index_ = int, typename Scalar_>
+std::shared_ptr<DelayedUnaryIsometricOperationHelper<OutputValue_, InputValue_, Index_> > make_DelayedUnaryIsometricPowerScalar(Scalar_ scalar, const DelayedUnaryIsometricArithmeticOptions& options) {
+    return std::make_shared<DelayedUnaryIsometricPowerScalarHelper<right_, OutputValue_, InputValue_, Index_, Scalar_> >(std::move(scalar), options);
+}
+
 template<bool right_, typename OutputValue_ = double, typename InputValue_ = double, typename Index_ = int, typename Scalar_>
 std::shared_ptr<DelayedUnaryIsometricOperationHelper<OutputValue_, InputValue_, Index_> > make_DelayedUnaryIsometricIntegerDivideScalar(Scalar_ scalar) {
     return std::make_shared<DelayedUnaryIsometricIntegerDivideScalarHelper<right_, OutputValue_, InputValue_, Index_, Scalar_> >(std::move(scalar));
@@ -306,20 +335,81 @@ public:
      * If true, each element of the vector is assumed to correspond to a row, and that element is used as an operand with all entries in the same row of the matrix.
      * If false, each element of the vector is assumed to correspond to a column instead.
      */
-    DelayedUnaryIsometricArithmeticVectorHelper(Vector_ vector, const bool by_row) : my_vector(std::move(vector)), my_by_row(by_row) {
+    DelayedUnaryIsometricArithmeticVectorHelper(Vector_ vector, const bool by_row) :
+        DelayedUnaryIsometricArithmeticVectorHelper(std::move(vector), by_row, DelayedUnaryIsometricArithmeticOptions()) {}
+
+    /**
+     * @param vector Vector of values to use in the operation. 
+     * This should be of length equal to the number of rows if `by_row == true`, otherwise it should be of length equal to the number of columns.
+     * @param by_row Whether `vector` corresponds to the rows.
+     * If true, each element of the vector is assumed to correspond to a row, and that element is used as an operand with all entries in the same row of the matrix.
+     * If false, each element of the vector is assumed to correspond to a column instead.
+     * @param options Further options.
+     */
+    DelayedUnaryIsometricArithmeticVectorHelper(Vector_ vector, const bool by_row, const DelayedUnaryIsometricArithmeticOptions& options) :
+        my_vector(std::move(vector)),
+        my_by_row(by_row),
+        my_allow_inexact(options.allow_inexact)
+    {
         for (const auto x : my_vector) {
             if (!delayed_arithmetic_actual_sparse<op_, right_, OutputValue_, InputValue_>(x)) {
                 my_sparse = false;
                 break;
             }
         }
+
+        // Precomputing the reciprocals for division along the other dimension, 
+        // where each element of the input is divided by a different value.
+        if constexpr(right_ && op_ == ArithmeticOperation::DIVIDE && std::numeric_limits<Product>::is_iec559) {
+            if (my_allow_inexact) {
+                const auto nvec = my_vector.size();
+                my_reciprocals.reserve(nvec);
+                for (const auto x : my_vector) {
+                    const Product recip = static_cast<Product>(1) / static_cast<Product>(x);
+                    if (!std::isfinite(recip) || recip == 0) {
+                        my_reciprocals.clear();
+                        break;
+                    }
+                    my_reciprocals.push_back(recip);
+                }
+                my_use_reciprocals = (my_reciprocals.size() == static_cast<decltype(my_reciprocals.size())>(nvec));
+            }
+        }
+
+        // Precomputing the kernels for operations along the same dimension as the vector,
+        // so that we don't have to repeat the kernel choice in each call.
+        if constexpr(precompute_kernels) {
+            my_kernels.reserve(my_vector.size());
+            for (const auto x : my_vector) {
+                my_kernels.emplace_back(x, my_allow_inexact);
+            }
+        }
     }
 
 private:
     Vector_ my_vector;
     bool my_by_row;
+    bool my_allow_inexact;
     bool my_sparse = true;
 
+    typedef DelayedArithmeticScalarKernel<op_, right_, InputValue_, I<decltype(std::declval<const Vector_&>()[0])> > Kernel;
+    typedef typename Kernel::Product Product;
+    std::vector<Product> my_reciprocals;
+    bool my_use_reciprocals = false;
+
+    // Only the right-hand division and power operations have specialized kernels, so there's no need to precompute anything for the others.
+    static constexpr bool precompute_kernels = right_ && (op_ == ArithmeticOperation::DIVIDE || op_ == ArithmeticOperation::POWER) && std::numeric_limits<Product>::is_iec559;
+    std::vector<Kernel> my_kernels;
+
+    template<typename Input_, typename Output_>
+    void run_kernel(const Index_ idx, const Input_* const input, const Index_ length, Output_* const output) const {
+        if constexpr(precompute_kernels) {
+            my_kernels[idx].run(input, length, output);
+        } else {
+            Kernel(my_vector[idx], my_allow_inexact).run(input, length, output);
+        }
+    }
+
 public:
     std::optional<Index_> nrow() const {
         if (my_by_row) {
@@ -357,11 +447,17 @@ public:
 public:
     void dense(const bool row, const Index_ idx, const Index_ start, const Index_ length, const InputValue_* input, OutputValue_* const output) const {
         if (row == my_by_row) {
-            delayed_arithmetic_run_simple<op_, right_>(input, length, my_vector[idx], output);
+            run_kernel(idx, input, length, output);
         } else {
             if constexpr(std::is_same<InputValue_, OutputValue_>::value) {
                 input = output; // basically an assertion to the compiler to skip aliasing protection.
             }
+            if (my_use_reciprocals) {
+                for (Index_ i = 0; i < length; ++i) {
+                    output[i] = input[i] * my_reciprocals[i + start];
+                }
+                return;
+            }
             for (Index_ i = 0; i < length; ++i) {
                 output[i] = delayed_arithmetic<op_, right_>(input[i], my_vector[i + start]);
             }
@@ -370,12 +466,18 @@ public:
 
     void dense(const bool row, const Index_ idx, const std::vector<Index_>& indices, const InputValue_* input, OutputValue_* const output) const {
         if (row == my_by_row) {
-            delayed_arithmetic_run_simple<op_, right_>(input, static_cast<Index_>(indices.size()), my_vector[idx], output);
+            run_kernel(idx, input, static_cast<Index_>(indices.size()), output);
         } else {
             if constexpr(std::is_same<InputValue_, OutputValue_>::value) {
                 input = output; // basically an assertion to the compiler to skip aliasing protection.
             }
             Index_ length = indices.size();
+            if (my_use_reciprocals) {
+                for (Index_ i = 0; i < length; ++i) {
+                    output[i] = input[i] * my_reciprocals[indices[i]];
+                }
+                return;
+            }
             for (Index_ i = 0; i < length; ++i) {
                 output[i] = delayed_arithmetic<op_, right_>(input[i], my_vector[indices[i]]);
             }
@@ -396,11 +498,17 @@ public:
         OutputValue_* const output_value)
     const {
         if (row == my_by_row) {
-            delayed_arithmetic_run_simple<op_, right_>(input_value, number, my_vector[idx], output_value);
+            run_kernel(idx, input_value, number, output_value);
         } else {
             if constexpr(std::is_same<InputValue_, OutputValue_>::value) {
                 input_value = output_value; // basically an assertion to the compiler to skip aliasing protection.
             }
+            if (my_use_reciprocals) {
+                for (Index_ i = 0; i < number; ++i) {
+                    output_value[i] = input_value[i] * my_reciprocals[index[i]];
+                }
+                return;
+            }
             for (Index_ i = 0; i < number; ++i) {
                 output_value[i] = delayed_arithmetic<op_, right_>(input_value[i], my_vector[index[i]]);
             }
@@ -524,6 +632,11 @@ std::shared_ptr<DelayedUnaryIsometricOperationHelper<OutputValue_, InputValue_,
     return std::make_shared<DelayedUnaryIsometricDivideVectorHelper<right_, OutputValue_, InputValue_, Index_, Vector_> >(std::move(vector), by_row);
 }
 
+template<bool right_, typename OutputValue_ = double, typename InputValue_ = double, typename Index_ = int, typename Vector_>
+std::shared_ptr<DelayedUnaryIsometricOperationHelper<OutputValue_, InputValue_, Index_> > make_DelayedUnaryIsometricDivideVector(Vector_ vector, bool by_row, const DelayedUnaryIsometricArithmeticOptions& options) {
+    return std::make_shared<DelayedUnaryIsometricDivideVectorHelper<right_, OutputValue_, InputValue_, Index_, Vector_> >(std::move(vector), by_row, options);
+}
+
 template<bool right_, typename OutputValue_ = double, typename InputValue_ = double, typename Index_ = int, typename Vector_>
 std::shared_ptr<DelayedUnaryIsometricOperationHelper<OutputValue_, InputValue_, Index_> > make_DelayedUnaryIsometricModuloVector(Vector_ vector, bool by_row) {
     return std::make_shared<DelayedUnaryIsometricModuloVectorHelper<right_, OutputValue_, InputValue_, Index_, Vector_> >(std::move(vector), by_row);
@@ -534,6 +647,11 @@ std::shared_ptr<DelayedUnaryIsometricOperationHelper<OutputValue_, InputValue_,
     return std::make_shared<DelayedUnaryIsometricPowerVectorHelper<right_, OutputValue_, InputValue_, Index_, Vector_> >(std::move(vector), by_row);
 }
 
+template<bool right_, typename OutputValue_ = double, typename InputValue_ = double, typename Index_ = int, typename Vector_>
+std::shared_ptr<DelayedUnaryIsometricOperationHelper<OutputValue_, InputValue_, Index_> > make_DelayedUnaryIsometricPowerVector(Vector_ vector, bool by_row, const DelayedUnaryIsometricArithmeticOptions& options) {
+    return std::make_shared<DelayedUnaryIsometricPowerVectorHelper<right_, OutputValue_, InputValue_, Index_, Vector_> >(std::move(vector), by_row, options);
+}
+
 template<bool right_, typename OutputValue_ = double, typename InputValue_ = double, typename Index_ = int, typename Vector_>
 std::shared_ptr<DelayedUnaryIsometricOperationHelper<OutputValue_, InputValue_, Index_> > make_DelayedUnaryIsometricIntegerDivideVector(Vector_ vector, bool by_row) {
     return std::make_shared<DelayedUnaryIsometricIntegerDivideVectorHelper<right_, OutputValue_, InputValue_, Index_, Vector_> >(std::move(vector), by_row);
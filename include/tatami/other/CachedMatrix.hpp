@@ -0,0 +1,656 @@
+#ifndef TATAMI_CACHED_MATRIX_HPP
+#define TATAMI_CACHED_MATRIX_HPP
+
+#include "../base/Matrix.hpp"
+#include "../utils/PseudoOracularExtractor.hpp"
+#include "../utils/copy.hpp"
+
+#include <memory>
+#include <mutex>
+#include <future>
+#include <list>
+#include <unordered_map>
+#include <functional>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @file CachedMatrix.hpp
+ * @brief Memoize the rows/columns extracted from a matrix.
+ */
+
+namespace tatami {
+
+/**
+ * @cond
+ */
+namespace CachedMatrix_internal {
+
+template<typename Value_, typename Index_>
+struct Slab {
+    std::vector<Value_> values;
+    std::vector<Index_> indices;
+    Index_ number = 0;
+};
+
+inline std::size_t combine_hash(const std::size_t seed, const std::size_t value) {
+    return seed ^ (value + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2));
+}
+
+template<typename Index_>
+struct Selection {
+    bool row;
+    bool sparse;
+    bool needs_value;
+    bool needs_index;
+    DimensionSelectionType type;
+    Index_ block_start;
+    Index_ block_length;
+    VectorPtr<Index_> indices; // also keeps the indices alive so that the address cannot be re-used by a different selection.
+    std::size_t hash;
+
+    // This should be called (outside of the cache's lock) once all other members are set.
+    void compute_hash() {
+        std::size_t out = combine_hash(row, sparse);
+        if (sparse) {
+            out = combine_hash(out, needs_value);
+            out = combine_hash(out, needs_index);
+        }
+        out = combine_hash(out, static_cast<std::size_t>(type));
+        if (type == DimensionSelectionType::BLOCK) {
+            out = combine_hash(out, std::hash<Index_>()(block_start));
+            out = combine_hash(out, std::hash<Index_>()(block_length));
+        } else if (type == DimensionSelectionType::INDEX) {
+            out = combine_hash(out, indices->size());
+            for (const auto i : *indices) {
+                out = combine_hash(out, std::hash<Index_>()(i));
+            }
+        }
+        hash = out;
+    }
+
+    bool operator==(const Selection& other) const {
+        if (hash != other.hash || row != other.row || sparse != other.sparse || type != other.type) {
+            return false;
+        }
+        if (sparse && (needs_value != other.needs_value || needs_index != other.needs_index)) {
+            return false;
+        }
+        if (type == DimensionSelectionType::BLOCK) {
+            return block_start == other.block_start && block_length == other.block_length;
+        } else if (type == DimensionSelectionType::INDEX) {
+            return indices == other.indices || *indices == *(other.indices);
+        }
+        return true;
+    }
+};
+
+template<typename Value_, typename Index_>
+class SharedCache {
+public:
+    SharedCache(std::size_t maximum_size) : my_maximum_size(maximum_size) {}
+
+private:
+    std::mutex my_mut;
+    std::size_t my_maximum_size;
+    std::size_t my_current_size = 0;
+
+    struct SelectionState;
+
+public:
+    typedef typename std::list<SelectionState>::iterator SelectionHandle;
+
+private:
+    struct Entry {
+        Entry(SelectionHandle selection, Index_ element, std::shared_ptr<const Slab<Value_, Index_> > slab, std::size_t size) :
+            selection(selection), element(element), slab(std::move(slab)), size(size) {}
+        SelectionHandle selection;
+        Index_ element;
+        std::shared_ptr<const Slab<Value_, Index_> > slab;
+        std::size_t size;
+    };
+
+    typedef std::unordered_map<Index_, typename std::list<Entry>::iterator> Lookup;
+
+    struct SelectionState {
+        SelectionState(Selection<Index_> selection) : selection(std::move(selection)) {
+            footprint = sizeof(SelectionState);
+            if (this->selection.indices) {
+                footprint += this->selection.indices->size() * sizeof(Index_);
+            }
+        }
+        Selection<Index_> selection;
+        Lookup lookup;
+        std::unordered_map<Index_, std::shared_future<std::shared_ptr<const Slab<Value_, Index_> > > > pending;
+        std::size_t users = 0;
+        std::size_t footprint;
+    };
+
+    // Most recently used entries are at the front.
+    std::list<Entry> my_lru;
+
+    // A selection is kept for as long as it is used by an extractor or it has any entries in the cache.
+    // Its footprint is only counted towards the cache size while it has entries, as the other selections are bounded by the number of live extractors.
+    std::list<SelectionState> my_selections;
+    std::unordered_multimap<std::size_t, SelectionHandle> my_selection_hashes;
+
+    void remove_selection(const SelectionHandle selection) {
+        auto range = my_selection_hashes.equal_range(selection->selection.hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == selection) {
+                my_selection_hashes.erase(it);
+                break;
+            }
+        }
+        my_selections.erase(selection);
+    }
+
+    void evict_last() {
+        const auto& last = my_lru.back();
+        const auto selection = last.selection;
+        selection->lookup.erase(last.element);
+        my_current_size -= last.size;
+        my_lru.pop_back();
+
+        if (selection->lookup.empty()) {
+            my_current_size -= selection->footprint;
+            if (selection->users == 0) {
+                remove_selection(selection);
+            }
+        }
+    }
+
+public:
+    SelectionHandle acquire_selection(Selection<Index_> selection) {
+        std::lock_guard<std::mutex> lck(my_mut);
+        auto range = my_selection_hashes.equal_range(selection.hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second->selection == selection) {
+                ++(it->second->users);
+                return it->second;
+            }
+        }
+
+        const auto hash = selection.hash;
+        my_selections.emplace_front(std::move(selection));
+        auto handle = my_selections.begin();
+        handle->users = 1;
+        my_selection_hashes.emplace(hash, handle);
+        return handle;
+    }
+
+    void release_selection(const SelectionHandle selection) {
+        std::lock_guard<std::mutex> lck(my_mut);
+        --(selection->users);
+        if (selection->users == 0 && selection->lookup.empty()) {
+            remove_selection(selection);
+        }
+    }
+
+    // Returns the cached slab for 'element' if it is available.
+    // Otherwise, if another thread is already computing the slab for the same 'element', we wait for and re-use its result.
+    // If neither is the case, we call 'compute' ourselves and add its result to the cache.
+    template<class Compute_>
+    std::shared_ptr<const Slab<Value_, Index_> > fetch(const SelectionHandle selection, const Index_ element, Compute_ compute) {
+        std::promise<std::shared_ptr<const Slab<Value_, Index_> > > promise;
+        std::shared_future<std::shared_ptr<const Slab<Value_, Index_> > > in_flight;
+
+        {
+            std::lock_guard<std::mutex> lck(my_mut);
+            const auto& lookup = selection->lookup;
+            auto it = lookup.find(element);
+            if (it != lookup.end()) {
+                my_lru.splice(my_lru.begin(), my_lru, it->second);
+                return it->second->slab;
+            }
+
+            auto& pending = selection->pending;
+            auto pit = pending.find(element);
+            if (pit != pending.end()) {
+                in_flight = pit->second;
+            } else {
+                pending.emplace(element, promise.get_future().share());
+            }
+        }
+
+        if (in_flight.valid()) {
+            return in_flight.get(); // waiting outside of the lock so that other threads can still use the cache.
+        }
+
+        std::shared_ptr<const Slab<Value_, Index_> > slab;
+        try {
+            slab = compute();
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lck(my_mut);
+                selection->pending.erase(element);
+            }
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+
+        insert(selection, element, slab);
+        promise.set_value(slab);
+        return slab;
+    }
+
+private:
+    void insert(const SelectionHandle selection, const Index_ element, std::shared_ptr<const Slab<Value_, Index_> > slab) {
+        // Also counting the bookkeeping for each entry in the LRU list and the lookup map.
+        const std::size_t size = sizeof(Slab<Value_, Index_>) + slab->values.size() * sizeof(Value_) + slab->indices.size() * sizeof(Index_)
+            + sizeof(Entry) + sizeof(typename Lookup::value_type);
+
+        std::lock_guard<std::mutex> lck(my_mut);
+        selection->pending.erase(element);
+        if (size > my_maximum_size || selection->footprint > my_maximum_size - size) {
+            return;
+        }
+
+        // Evicting entries can empty this selection's lookup, so its footprint needs to be re-checked on every iteration.
+        // This loop must terminate as the required size is no greater than the maximum size when the LRU list is empty.
+        auto& lookup = selection->lookup;
+        while (my_current_size + size + (lookup.empty() ? selection->footprint : 0) > my_maximum_size) {
+            evict_last();
+        }
+
+        if (lookup.empty()) {
+            my_current_size += selection->footprint;
+        }
+        my_lru.emplace_front(selection, element, std::move(slab), size);
+        lookup[element] = my_lru.begin();
+        my_current_size += size;
+    }
+
+public:
+    std::size_t size() {
+        std::lock_guard<std::mutex> lck(my_mut);
+        return my_current_size;
+    }
+
+    std::size_t num_selections() {
+        std::lock_guard<std::mutex> lck(my_mut);
+        return my_selections.size();
+    }
+};
+
+template<typename Value_, typename Index_>
+class Dense final : public MyopicDenseExtractor<Value_, Index_> {
+public:
+    Dense(
+        std::shared_ptr<SharedCache<Value_, Index_> > cache,
+        Selection<Index_> selection,
+        std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > ext,
+        const Index_ extent
+    ) :
+        my_cache(std::move(cache)),
+        my_selection(my_cache->acquire_selection(std::move(selection))),
+        my_ext(std::move(ext)),
+        my_extent(extent)
+    {}
+
+    ~Dense() {
+        my_cache->release_selection(my_selection);
+    }
+
+    Dense(const Dense&) = delete;
+    Dense& operator=(const Dense&) = delete;
+
+    const Value_* fetch(const Index_ i, Value_* const buffer) {
+        // Holding onto the slab ensures that the returned pointer is valid
+        // until the next fetch(), even if the slab is evicted in the meantime.
+        my_last = my_cache->fetch(my_selection, i, [&]() -> std::shared_ptr<const Slab<Value_, Index_> > {
+            auto slab = std::make_shared<Slab<Value_, Index_> >();
+            auto ptr = my_ext->fetch(i, buffer);
+            slab->values.insert(slab->values.end(), ptr, ptr + my_extent);
+            return slab;
+        });
+        return my_last->values.data();
+    }
+
+private:
+    std::shared_ptr<SharedCache<Value_, Index_> > my_cache;
+    typename SharedCache<Value_, Index_>::SelectionHandle my_selection;
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > my_ext;
+    Index_ my_extent;
+    std::shared_ptr<const Slab<Value_, Index_> > my_last;
+};
+
+template<typename Value_, typename Index_>
+class Sparse final : public MyopicSparseExtractor<Value_, Index_> {
+public:
+    Sparse(
+        std::shared_ptr<SharedCache<Value_, Index_> > cache,
+        Selection<Index_> selection,
+        std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > ext,
+        const Options& opt
+    ) :
+        my_cache(std::move(cache)),
+        my_selection(my_cache->acquire_selection(std::move(selection))),
+        my_ext(std::move(ext)),
+        my_needs_value(opt.sparse_extract_value),
+        my_needs_index(opt.sparse_extract_index)
+    {}
+
+    ~Sparse() {
+        my_cache->release_selection(my_selection);
+    }
+
+    Sparse(const Sparse&) = delete;
+    Sparse& operator=(const Sparse&) = delete;
+
+    SparseRange<Value_, Index_> fetch(const Index_ i, Value_* const value_buffer, Index_* const index_buffer) {
+        my_last = my_cache->fetch(my_selection, i, [&]() -> std::shared_ptr<const Slab<Value_, Index_> > {
+            auto slab = std::make_shared<Slab<Value_, Index_> >();
+            auto range = my_ext->fetch(i, value_buffer, index_buffer);
+            slab->number = range.number;
+            if (my_needs_value) {
+                slab->values.insert(slab->values.end(), range.value, range.value + range.number);
+            }
+            if (my_needs_index) {
+                slab->indices.insert(slab->indices.end(), range.index, range.index + range.number);
+            }
+            return slab;
+        });
+        return SparseRange<Value_, Index_>(
+            my_last->number,
+            (my_needs_value ? my_last->values.data() : NULL),
+            (my_needs_index ? my_last->indices.data() : NULL)
+        );
+    }
+
+private:
+    std::shared_ptr<SharedCache<Value_, Index_> > my_cache;
+    typename SharedCache<Value_, Index_>::SelectionHandle my_selection;
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > my_ext;
+    bool my_needs_value, my_needs_index;
+    std::shared_ptr<const Slab<Value_, Index_> > my_last;
+};
+
+}
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Options for `CachedMatrix`.
+ */
+struct CachedMatrixOptions {
+    /**
+     * Maximum size of the cache, in bytes.
+     * Once this is exceeded, the least recently used rows/columns are evicted from the cache.
+     * Rows/columns that are larger than this limit are never cached.
+     */
+    std::size_t maximum_cache_size = 100000000;
+};
+
+/**
+ * @brief Memoize the rows/columns extracted from a matrix.
+ *
+ * This wraps a `Matrix` that is expensive to extract from, e.g., a `DelayedUnaryIsometricOperation` or `DelayedBinaryIsometricOperation` with costly arithmetic.
+ * Each extracted row/column is stored in a cache that is shared by all extractors created from the same `CachedMatrix`,
+ * such that repeated requests for the same row/column will return the cached result instead of recomputing it.
+ * The cache is limited in size and evicts the least recently used rows/columns when this limit is reached.
+ *
+ * Rows/columns are only shared between extractors that use the same selection of the non-target dimension,
+ * i.e., both extractors extract the full non-target dimension, or the same block, or the same indices.
+ * Dense and sparse extraction are also cached separately, as are sparse extractions that request different combinations of values and indices.
+ * Sparse results are always returned with sorted indices.
+ *
+ * Access to the cache is protected by a mutex, so extractors created from the same `CachedMatrix` can be used in different threads.
+ * This allows concurrent consumers of the same rows/columns to re-use each other's results.
+ * If a requested row/column is currently being extracted by another thread, the requesting thread will wait for that extraction to finish instead of repeating it.
+ * Note that each extractor should still only be used in a single thread.
+ *
+ * Oracles are not passed to the underlying matrix as the cache may skip some predicted rows/columns.
+ * Accordingly, `uses_oracle()` always returns false, regardless of whether the underlying matrix can use an oracle.
+ *
+ * The maximum cache size also accounts for the selections of the non-target dimension that are associated with the cached rows/columns,
+ * e.g., the vector of indices for an indexed extractor.
+ * Each selection is discarded once there are no extractors that use it and all of its rows/columns have been evicted from the cache.
+ *
+ * @tparam Value_ Type of the matrix values.
+ * @tparam Index_ Type of the row/column indices.
+ */
+template<typename Value_, typename Index_>
+class CachedMatrix final : public Matrix<Value_, Index_> {
+public:
+    /**
+     * @param matrix Pointer to the `Matrix` to be cached.
+     * @param options Further options.
+     */
+    CachedMatrix(std::shared_ptr<const Matrix<Value_, Index_> > matrix, const CachedMatrixOptions& options) :
+        my_matrix(std::move(matrix)),
+        my_cache(std::make_shared<CachedMatrix_internal::SharedCache<Value_, Index_> >(options.maximum_cache_size))
+    {}
+
+    /**
+     * @param matrix Pointer to the `Matrix` to be cached.
+     */
+    CachedMatrix(std::shared_ptr<const Matrix<Value_, Index_> > matrix) : CachedMatrix(std::move(matrix), CachedMatrixOptions()) {}
+
+private:
+    std::shared_ptr<const Matrix<Value_, Index_> > my_matrix;
+    std::shared_ptr<CachedMatrix_internal::SharedCache<Value_, Index_> > my_cache;
+
+public:
+    /**
+     * @return Current size of the cache in bytes.
+     * This includes the cached rows/columns as well as the storage for the selections that they were extracted with.
+     */
+    std::size_t cache_size() const {
+        return my_cache->size();
+    }
+
+    /**
+     * @return Number of distinct selections of the non-target dimension that are currently tracked by the cache.
+     * A selection is discarded once it is no longer used by any extractor and all of its rows/columns have been evicted.
+     */
+    std::size_t cache_selections() const {
+        return my_cache->num_selections();
+    }
+
+public:
+    Index_ nrow() const {
+        return my_matrix->nrow();
+    }
+
+    Index_ ncol() const {
+        return my_matrix->ncol();
+    }
+
+    bool is_sparse() const {
+        return my_matrix->is_sparse();
+    }
+
+    double is_sparse_proportion() const {
+        return my_matrix->is_sparse_proportion();
+    }
+
+    bool prefer_rows() const {
+        return my_matrix->prefer_rows();
+    }
+
+    double prefer_rows_proportion() const {
+        return my_matrix->prefer_rows_proportion();
+    }
+
+    bool uses_oracle(const bool) const {
+        // Oracles are never passed to the underlying matrix, so there is no benefit from supplying one.
+        return false;
+    }
+
+    using Matrix<Value_, Index_>::dense;
+
+    using Matrix<Value_, Index_>::sparse;
+
+private:
+    CachedMatrix_internal::Selection<Index_> define_selection(
+        const bool row,
+        const bool sparse,
+        const DimensionSelectionType type,
+        const Index_ block_start,
+        const Index_ block_length,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt)
+    const {
+        CachedMatrix_internal::Selection<Index_> selection;
+        selection.row = row;
+        selection.sparse = sparse;
+        selection.needs_value = opt.sparse_extract_value;
+        selection.needs_index = opt.sparse_extract_index;
+        selection.type = type;
+        selection.block_start = block_start;
+        selection.block_length = block_length;
+        selection.indices = std::move(indices_ptr);
+        selection.compute_hash();
+        return selection;
+    }
+
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense_internal(
+        std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > ext,
+        CachedMatrix_internal::Selection<Index_> selection,
+        const Index_ extent)
+    const {
+        return std::make_unique<CachedMatrix_internal::Dense<Value_, Index_> >(my_cache, std::move(selection), std::move(ext), extent);
+    }
+
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse_internal(
+        std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > ext,
+        CachedMatrix_internal::Selection<Index_> selection,
+        const Options& opt)
+    const {
+        return std::make_unique<CachedMatrix_internal::Sparse<Value_, Index_> >(my_cache, std::move(selection), std::move(ext), opt);
+    }
+
+    static Options sparse_options(const Options& opt) {
+        // Sorting the indices so that any consumer can use the cached result.
+        auto copy = opt;
+        copy.sparse_ordered_index = true;
+        return copy;
+    }
+
+    /********************
+     *** Myopic dense ***
+     ********************/
+public:
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(const bool row, const Options& opt) const {
+        return dense_internal(
+            my_matrix->dense(row, opt),
+            define_selection(row, false, DimensionSelectionType::FULL, 0, 0, nullptr, opt),
+            row ? my_matrix->ncol() : my_matrix->nrow()
+        );
+    }
+
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(const bool row, const Index_ block_start, const Index_ block_length, const Options& opt) const {
+        return dense_internal(
+            my_matrix->dense(row, block_start, block_length, opt),
+            define_selection(row, false, DimensionSelectionType::BLOCK, block_start, block_length, nullptr, opt),
+            block_length
+        );
+    }
+
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(const bool row, VectorPtr<Index_> indices_ptr, const Options& opt) const {
+        const auto extent = static_cast<Index_>(indices_ptr->size());
+        auto ext = my_matrix->dense(row, indices_ptr, opt);
+        return dense_internal(
+            std::move(ext),
+            define_selection(row, false, DimensionSelectionType::INDEX, 0, 0, std::move(indices_ptr), opt),
+            extent
+        );
+    }
+
+    /*********************
+     *** Myopic sparse ***
+     *********************/
+public:
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(const bool row, const Options& opt) const {
+        return sparse_internal(
+            my_matrix->sparse(row, sparse_options(opt)),
+            define_selection(row, true, DimensionSelectionType::FULL, 0, 0, nullptr, opt),
+            opt
+        );
+    }
+
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(const bool row, const Index_ block_start, const Index_ block_length, const Options& opt) const {
+        return sparse_internal(
+            my_matrix->sparse(row, block_start, block_length, sparse_options(opt)),
+            define_selection(row, true, DimensionSelectionType::BLOCK, block_start, block_length, nullptr, opt),
+            opt
+        );
+    }
+
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(const bool row, VectorPtr<Index_> indices_ptr, const Options& opt) const {
+        auto ext = my_matrix->sparse(row, indices_ptr, sparse_options(opt));
+        return sparse_internal(
+            std::move(ext),
+            define_selection(row, true, DimensionSelectionType::INDEX, 0, 0, std::move(indices_ptr), opt),
+            opt
+        );
+    }
+
+    /**********************
+     *** Oracular dense ***
+     **********************/
+public:
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Options& opt
+    ) const {
+        return std::make_unique<PseudoOracularDenseExtractor<Value_, Index_> >(std::move(oracle), dense(row, opt));
+    }
+
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return std::make_unique<PseudoOracularDenseExtractor<Value_, Index_> >(std::move(oracle), dense(row, block_start, block_length, opt));
+    }
+
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return std::make_unique<PseudoOracularDenseExtractor<Value_, Index_> >(std::move(oracle), dense(row, std::move(indices_ptr), opt));
+    }
+
+    /***********************
+     *** Oracular sparse ***
+     ***********************/
+public:
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Options& opt
+    ) const {
+        return std::make_unique<PseudoOracularSparseExtractor<Value_, Index_> >(std::move(oracle), sparse(row, opt));
+    }
+
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return std::make_unique<PseudoOracularSparseExtractor<Value_, Index_> >(std::move(oracle), sparse(row, block_start, block_length, opt));
+    }
+
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return std::make_unique<PseudoOracularSparseExtractor<Value_, Index_> >(std::move(oracle), sparse(row, std::move(indices_ptr), opt));
+    }
+};
+
+}
+
+#endif
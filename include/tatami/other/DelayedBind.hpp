@@ -8,6 +8,7 @@
 #include "../utils/PseudoOracularExtractor.hpp"
 #include "../utils/copy.hpp"
 #include "../utils/Index_to_container.hpp"
+#include "../utils/ThreadPool.hpp"
 
 #include <numeric>
 #include <algorithm>
@@ -15,6 +16,7 @@
 #include <array>
 #include <type_traits>
 #include <cstddef>
+#include <functional>
 
 /**
  * @file DelayedBind.hpp
@@ -103,6 +105,7 @@ public:
         const std::vector<std::shared_ptr<const Matrix<Value_, Index_> > >& matrices, 
         const bool row,
         MaybeOracle<oracle_, Index_> oracle,
+        ThreadPool* const pool,
         const Options& opt
     ) {
         my_exts.reserve(matrices.size());
@@ -111,6 +114,7 @@ public:
             my_count.emplace_back(row ? m->ncol() : m->nrow());
             my_exts.emplace_back(new_extractor<false, oracle_>(m.get(), row, oracle, opt));
         }
+        prepare_pool(pool);
     }
 
     ParallelDense(
@@ -119,6 +123,7 @@ public:
         const std::vector<std::shared_ptr<const Matrix<Value_, Index_> > >& matrices, 
         const bool row,
         MaybeOracle<oracle_, Index_> oracle,
+        ThreadPool* const pool,
         const Index_ block_start, 
         const Index_ block_length, 
         const Options& opt
@@ -135,6 +140,7 @@ public:
                 my_exts.emplace_back(new_extractor<false, oracle_>(matrices[i].get(), row, oracle, sub_block_start, sub_block_length, opt));
             }
         );
+        prepare_pool(pool);
     }
 
     ParallelDense(
@@ -143,6 +149,7 @@ public:
         const std::vector<std::shared_ptr<const Matrix<Value_, Index_> > >& matrices, 
         const bool row,
         MaybeOracle<oracle_, Index_> oracle,
+        ThreadPool* const pool,
         VectorPtr<Index_> indices_ptr,
         const Options& opt
     ) {
@@ -157,12 +164,40 @@ public:
                 my_exts.emplace_back(new_extractor<false, oracle_>(matrices[i].get(), row, oracle, std::move(sub_indices_ptr), opt));
             }
         );
+        prepare_pool(pool);
+    }
+
+private:
+    void prepare_pool(ThreadPool* const pool) {
+        const Index_ nmats = my_count.size();
+        if (pool == NULL || nmats < 2) {
+            return;
+        }
+        my_pool = pool;
+        my_offsets.reserve(nmats);
+        Index_ sofar = 0;
+        for (const auto c : my_count) {
+            my_offsets.push_back(sofar);
+            sofar += c;
+        }
     }
 
 public:
     const Value_* fetch(const Index_ i, Value_* const buffer) {
-        auto copy = buffer;
         const Index_ nmats = my_count.size();
+        if (my_pool) {
+            // Each child writes to its own section of the buffer, so they can be fetched concurrently.
+            my_pool->run([&](const int, const Index_ start, const Index_ length) -> void {
+                for (Index_ x = start, end = start + length; x < end; ++x) {
+                    const auto dest = buffer + my_offsets[x];
+                    const auto ptr = my_exts[x]->fetch(i, dest);
+                    copy_n(ptr, my_count[x], dest);
+                }
+            }, nmats, my_pool->num_threads());
+            return buffer;
+        }
+
+        auto copy = buffer;
         for (Index_ x = 0; x < nmats; ++x) {
             const auto ptr = my_exts[x]->fetch(i, copy); 
             const auto num = my_count[x];
@@ -175,12 +210,81 @@ public:
 private:
     std::vector<std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > > my_exts;
     std::vector<Index_> my_count;
+    ThreadPool* my_pool = NULL;
+    std::vector<Index_> my_offsets;
 };
 
 /***********************
  *** Sparse parallel ***
  ***********************/
 
+// Fetches from each child concurrently into its own section of the buffers,
+// and then compacts the results in order of the children.
+template<bool oracle_, typename Value_, typename Index_>
+class ParallelSparsePool {
+public:
+    void prepare(ThreadPool* const pool, const std::vector<Index_>& extents) {
+        const Index_ nmats = extents.size();
+        if (pool == NULL || nmats < 2) {
+            return;
+        }
+        my_pool = pool;
+        my_offsets.reserve(nmats);
+        Index_ sofar = 0;
+        for (const auto e : extents) {
+            my_offsets.push_back(sofar);
+            sofar += e;
+        }
+        my_ranges.resize(nmats);
+    }
+
+    bool active() const {
+        return my_pool != NULL;
+    }
+
+    template<class IndexOffset_>
+    SparseRange<Value_, Index_> fetch(
+        std::vector<std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > >& exts,
+        const Index_ i,
+        Value_* const value_buffer,
+        Index_* const index_buffer,
+        const bool needs_value,
+        const bool needs_index,
+        IndexOffset_ index_offset
+    ) {
+        const Index_ nmats = exts.size();
+        my_pool->run([&](const int, const Index_ start, const Index_ length) -> void {
+            for (Index_ x = start, end = start + length; x < end; ++x) {
+                const auto off = my_offsets[x];
+                my_ranges[x] = exts[x]->fetch(i, (needs_value ? value_buffer + off : value_buffer), (needs_index ? index_buffer + off : index_buffer));
+            }
+        }, nmats, my_pool->num_threads());
+
+        // Each child's results are shifted towards the start of the buffer, so a forward copy never overwrites anything that is yet to be read.
+        Index_ count = 0;
+        for (Index_ x = 0; x < nmats; ++x) {
+            const auto& range = my_ranges[x];
+            if (needs_value) {
+                copy_n(range.value, range.number, value_buffer + count);
+            }
+            if (needs_index) {
+                const Index_ offset = index_offset(x);
+                for (Index_ y = 0; y < range.number; ++y) {
+                    index_buffer[count + y] = range.index[y] + offset;
+                }
+            }
+            count += range.number;
+        }
+
+        return SparseRange<Value_, Index_>(count, (needs_value ? value_buffer : NULL), (needs_index ? index_buffer : NULL));
+    }
+
+private:
+    ThreadPool* my_pool = NULL;
+    std::vector<Index_> my_offsets;
+    std::vector<SparseRange<Value_, Index_> > my_ranges;
+};
+
 template<bool oracle_, typename Value_, typename Index_>
 class ParallelFullSparse final : public SparseExtractor<oracle_, Value_, Index_> {
 public:
@@ -190,6 +294,7 @@ public:
         const std::vector<std::shared_ptr<const Matrix<Value_, Index_> > >& matrices, 
         const bool row,
         MaybeOracle<oracle_, Index_> oracle,
+        ThreadPool* const pool,
         const Options& opt
     ) : 
         my_cumulative(cumulative),
@@ -200,9 +305,22 @@ public:
         for (const auto& m : matrices) {
             my_exts.emplace_back(new_extractor<true, oracle_>(m.get(), row, oracle, opt));
         }
+
+        if (pool) {
+            std::vector<Index_> extents;
+            extents.reserve(matrices.size());
+            for (const auto& m : matrices) {
+                extents.push_back(row ? m->ncol() : m->nrow());
+            }
+            my_pool.prepare(pool, extents);
+        }
     }
 
     SparseRange<Value_, Index_> fetch(const Index_ i, Value_* const value_buffer, Index_* const index_buffer) {
+        if (my_pool.active()) {
+            return my_pool.fetch(my_exts, i, value_buffer, index_buffer, my_needs_value, my_needs_index, [&](const Index_ x) -> Index_ { return my_cumulative[x]; });
+        }
+
         auto vcopy = value_buffer;
         auto icopy = index_buffer;
         Index_ accumulated = 0;
@@ -231,6 +349,7 @@ private:
     const std::vector<Index_>& my_cumulative;
     bool my_needs_value, my_needs_index;
     std::vector<std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > > my_exts;
+    ParallelSparsePool<oracle_, Value_, Index_> my_pool;
 };
 
 template<bool oracle_, typename Value_, typename Index_>
@@ -242,6 +361,7 @@ public:
         const std::vector<std::shared_ptr<const Matrix<Value_, Index_> > >& matrices, 
         const bool row,
         MaybeOracle<oracle_, Index_> oracle,
+        ThreadPool* const pool,
         const Index_ block_start, 
         const Index_ block_length, 
         const Options& opt
@@ -251,18 +371,25 @@ public:
         my_needs_index(opt.sparse_extract_index) 
     {
         my_exts.reserve(matrices.size());
+        std::vector<Index_> extents;
         my_start_matrix = initialize_parallel_block(
             my_cumulative, 
             mapping,
             block_start, 
             block_length,
             [&](const Index_ i, const Index_ sub_block_start, const Index_ sub_block_length) -> void {
+                extents.push_back(sub_block_length);
                 my_exts.emplace_back(new_extractor<true, oracle_>(matrices[i].get(), row, oracle, sub_block_start, sub_block_length, opt));
             }
         );
+        my_pool.prepare(pool, extents);
     }
 
     SparseRange<Value_, Index_> fetch(const Index_ i, Value_* const value_buffer, Index_* const index_buffer) {
+        if (my_pool.active()) {
+            return my_pool.fetch(my_exts, i, value_buffer, index_buffer, my_needs_value, my_needs_index, [&](const Index_ x) -> Index_ { return my_cumulative[x + my_start_matrix]; });
+        }
+
         auto vcopy = value_buffer;
         auto icopy = index_buffer;
         Index_ count = 0;
@@ -292,6 +419,7 @@ private:
     bool my_needs_value, my_needs_index;
     std::vector<std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > > my_exts;
     Index_ my_start_matrix;
+    ParallelSparsePool<oracle_, Value_, Index_> my_pool;
 };
 
 template<bool oracle_, typename Value_, typename Index_>
@@ -303,6 +431,7 @@ public:
         const std::vector<std::shared_ptr<const Matrix<Value_, Index_> > >& matrices, 
         const bool row,
         MaybeOracle<oracle_, Index_> oracle,
+        ThreadPool* const pool,
         VectorPtr<Index_> indices_ptr,
         const Options& opt
     ) : 
@@ -312,18 +441,25 @@ public:
     {
         my_exts.reserve(matrices.size());
         my_which_matrix.reserve(matrices.size());
+        std::vector<Index_> extents;
         initialize_parallel_index(
             my_cumulative, 
             mapping,
             *indices_ptr,
             [&](const Index_ i, VectorPtr<Index_> sub_indices_ptr) -> void {
                 my_which_matrix.emplace_back(i);
+                extents.push_back(sub_indices_ptr->size());
                 my_exts.emplace_back(new_extractor<true, oracle_>(matrices[i].get(), row, oracle, std::move(sub_indices_ptr), opt));
             }
         );
+        my_pool.prepare(pool, extents);
     }
 
     SparseRange<Value_, Index_> fetch(const Index_ i, Value_* const value_buffer, Index_* const index_buffer) {
+        if (my_pool.active()) {
+            return my_pool.fetch(my_exts, i, value_buffer, index_buffer, my_needs_value, my_needs_index, [&](const Index_ x) -> Index_ { return my_cumulative[my_which_matrix[x]]; });
+        }
+
         auto vcopy = value_buffer;
         auto icopy = index_buffer;
         Index_ count = 0;
@@ -354,12 +490,63 @@ private:
     bool my_needs_value, my_needs_index;
     std::vector<std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > > my_exts;
     std::vector<Index_> my_which_matrix;
+    ParallelSparsePool<oracle_, Value_, Index_> my_pool;
 };
 
 /*********************
  *** Perpendicular ***
  *********************/
 
+// Child extractors are only created upon first use. This avoids paying for the construction of every child's extractor
+// when only a few rows/columns are extracted from a combined matrix with many children.
+template<bool sparse_, bool oracle_, typename Value_, typename Index_>
+class LazyChildExtractors {
+public:
+    template<typename ... Args_>
+    LazyChildExtractors(
+        const std::vector<std::shared_ptr<const Matrix<Value_, Index_> > >& matrices, 
+        const bool row, 
+        const Args_& ... args
+    ) :
+        my_matrices(matrices),
+        my_factory([row, args...](const Matrix<Value_, Index_>& mat, MaybeOracle<oracle_, Index_> oracle) -> Extractor {
+            return new_extractor<sparse_, oracle_>(mat, row, std::move(oracle), args...);
+        })
+    {
+        resize_container_to_Index_size(my_exts, matrices.size()); // number of matrices should fit in an Index_, so this call is legal.
+        if constexpr(oracle_) {
+            resize_container_to_Index_size(my_oracles, matrices.size());
+        }
+    }
+
+    void set_oracle(const Index_ x, std::shared_ptr<const Oracle<Index_> > oracle) {
+        my_oracles[x] = std::move(oracle);
+    }
+
+    auto& get(const Index_ x) {
+        auto& current = my_exts[x];
+        if (!current) {
+            if constexpr(oracle_) {
+                current = my_factory(*(my_matrices[x]), std::move(my_oracles[x]));
+            } else {
+                current = my_factory(*(my_matrices[x]), false);
+            }
+        }
+        return *current;
+    }
+
+private:
+    typedef typename std::conditional<sparse_, 
+        std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> >,
+        std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> >
+    >::type Extractor;
+
+    const std::vector<std::shared_ptr<const Matrix<Value_, Index_> > >& my_matrices;
+    std::function<Extractor(const Matrix<Value_, Index_>&, MaybeOracle<oracle_, Index_>)> my_factory;
+    std::vector<Extractor> my_exts;
+    std::vector<std::shared_ptr<const Oracle<Index_> > > my_oracles;
+};
+
 template<typename Value_, typename Index_>
 class MyopicPerpendicularDense final : public MyopicDenseExtractor<Value_, Index_> {
 public:
@@ -372,23 +559,19 @@ public:
         const Args_& ... args
     ) : 
         my_cumulative(cumulative),
-        my_mapping(mapping)
-    {
-        my_exts.reserve(matrices.size());
-        for (const auto& m : matrices) {
-            my_exts.emplace_back(m->dense(row, args...));
-        }
-    }
+        my_mapping(mapping),
+        my_exts(matrices, row, args...)
+    {}
 
     const Value_* fetch(const Index_ i, Value_* const buffer) {
         const Index_ chosen = my_mapping[i];
-        return my_exts[chosen]->fetch(i - my_cumulative[chosen], buffer);
+        return my_exts.get(chosen).fetch(i - my_cumulative[chosen], buffer);
     }
 
 private:
     const std::vector<Index_>& my_cumulative;
     const std::vector<Index_>& my_mapping;
-    std::vector<std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > > my_exts;
+    LazyChildExtractors<false, false, Value_, Index_> my_exts;
 };
 
 template<typename Value_, typename Index_>
@@ -403,23 +586,19 @@ public:
         const Args_& ... args
     ) : 
         my_cumulative(cumulative),
-        my_mapping(mapping)
-    {
-        my_exts.reserve(matrices.size());
-        for (const auto& m : matrices) {
-            my_exts.emplace_back(m->sparse(row, args...));
-        }
-    }
+        my_mapping(mapping),
+        my_exts(matrices, row, args...)
+    {}
 
     SparseRange<Value_, Index_> fetch(const Index_ i, Value_* const vbuffer, Index_* const ibuffer) {
         const Index_ chosen = my_mapping[i];
-        return my_exts[chosen]->fetch(i - my_cumulative[chosen], vbuffer, ibuffer);
+        return my_exts.get(chosen).fetch(i - my_cumulative[chosen], vbuffer, ibuffer);
     }
 
 private:
     const std::vector<Index_>& my_cumulative;
     const std::vector<Index_>& my_mapping;
-    std::vector<std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > > my_exts;
+    LazyChildExtractors<true, false, Value_, Index_> my_exts;
 };
 
 template<typename Index_, class Initialize_>
@@ -433,52 +612,52 @@ void initialize_perp_oracular(
     const auto ntotal = oracle.total();
     chosen.reserve(ntotal);
 
-    struct Predictions {
-        bool consecutive = true;
-        Index_ start = 0;
-        Index_ number = 0;
-        std::vector<Index_> predictions;
-
-        void add(const Index_ p) {
-            if (consecutive) {
-                if (number == 0) {
-                    start = p;
-                    number = 1;
-                    return;
-                }
-                if (number + start == p) {
-                    ++number;
-                    return;
-                }
-                consecutive = false;
-                resize_container_to_Index_size(predictions, number);
-                std::iota(predictions.begin(), predictions.end(), start);
-            }
-
-            predictions.push_back(p);
-        }
-    };
-
+    // Counting sort of the predictions by child, so that the predictions for all children are stored in a single pooled buffer.
     const auto nmats = cumulative.size() - 1;
-    auto predictions = create_container_of_Index_size<std::vector<Predictions> >(nmats); // nmats should fit in an Index_, so this call is legal.
+    auto offsets = sanisizer::create<std::vector<PredictionIndex> >(sanisizer::sum<std::size_t>(nmats, 1));
     for (I<decltype(ntotal)> i = 0; i < ntotal; ++i) {
-        const auto prediction = oracle.get(i);
-        const Index_ choice = mapping[prediction];
+        const Index_ choice = mapping[oracle.get(i)];
         chosen.push_back(choice);
-        predictions[choice].add(prediction - cumulative[choice]);
+        ++offsets[choice + 1];
+    }
+    for (I<decltype(nmats)> x = 0; x < nmats; ++x) {
+        offsets[x + 1] += offsets[x];
     }
 
+    auto pooled = std::make_shared<std::vector<Index_> >(sanisizer::cast<typename std::vector<Index_>::size_type>(ntotal));
+    {
+        auto positions = offsets;
+        for (I<decltype(ntotal)> i = 0; i < ntotal; ++i) {
+            const auto choice = chosen[i];
+            (*pooled)[positions[choice]++] = oracle.get(i) - cumulative[choice];
+        }
+    }
+
+    // Untouched children don't get an oracle at all.
     for (I<decltype(nmats)> x = 0; x < nmats; ++x) {
-        auto& current = predictions[x];
-        if (current.consecutive) {
-            if (current.number) {
-                init(x, std::make_shared<ConsecutiveOracle<Index_> >(current.start, current.number));
+        const auto first = offsets[x], last = offsets[x + 1];
+        if (first == last) {
+            continue;
+        }
+
+        const auto start = (*pooled)[first];
+        bool consecutive = true;
+        for (auto p = first + 1; p < last; ++p) {
+            if ((*pooled)[p] != static_cast<Index_>(start + (p - first))) {
+                consecutive = false;
+                break;
             }
+        }
+
+        std::shared_ptr<Oracle<Index_> > subora;
+        if (consecutive) {
+            subora = std::make_shared<ConsecutiveOracle<Index_> >(start, last - first);
         } else {
-            if (!current.predictions.empty()) {
-                init(x, std::make_shared<FixedVectorOracle<Index_> >(std::move(current.predictions)));
-            }
+            std::shared_ptr<const Index_[]> view(pooled, pooled->data() + first); // aliasing the pooled buffer to keep it alive.
+            subora = std::make_shared<FixedViewOracle<Index_, std::shared_ptr<const Index_[]> > >(std::move(view), last - first);
         }
+        subora->set_max_lookahead(oracle.max_lookahead());
+        init(x, std::move(subora));
     }
 }
 
@@ -493,29 +672,30 @@ public:
         const bool row,
         std::shared_ptr<const Oracle<Index_> > ora, 
         const Args_& ... args
-    ) {
-        resize_container_to_Index_size(my_exts, matrices.size()); // number of matrices should fit in an I ndex_, so this call is allowed.
+    ) :
+        my_exts(matrices, row, args...)
+    {
         initialize_perp_oracular(
             cumulative,
             mapping,
             *ora,
             my_segments,
             [&](const Index_ x, std::shared_ptr<const Oracle<Index_> > subora) -> void {
-                my_exts[x] = matrices[x]->dense(row, std::move(subora), args...);
+                my_exts.set_oracle(x, std::move(subora));
             }
         );
     }
 
     const Value_* fetch(const Index_ i, Value_* const buffer) {
         const auto chosen = my_segments[my_used];
-        const auto output = my_exts[chosen]->fetch(i, buffer);
+        const auto output = my_exts.get(chosen).fetch(i, buffer);
         ++my_used;
         return output;
     }
 
 private:
     std::vector<Index_> my_segments;
-    std::vector<std::unique_ptr<OracularDenseExtractor<Value_, Index_> > > my_exts;
+    LazyChildExtractors<false, true, Value_, Index_> my_exts;
     PredictionIndex my_used = 0;
 };
 
@@ -530,29 +710,30 @@ public:
         const bool row,
         std::shared_ptr<const Oracle<Index_> > ora, 
         const Args_& ... args
-    ) {
-        resize_container_to_Index_size(my_exts, matrices.size()); // number of matrices should fit in an Index_, so this call is legal.
+    ) :
+        my_exts(matrices, row, args...)
+    {
         initialize_perp_oracular(
             cumulative,
             mapping,
             *ora,
             my_segments,
             [&](const Index_ x, std::shared_ptr<const Oracle<Index_> > subora) -> void {
-                my_exts[x] = matrices[x]->sparse(row, std::move(subora), args...);
+                my_exts.set_oracle(x, std::move(subora));
             }
         );
     }
 
     SparseRange<Value_, Index_> fetch(Index_ i, Value_* vbuffer, Index_* ibuffer) {
         const auto chosen = my_segments[my_used];
-        const auto output = my_exts[chosen]->fetch(i, vbuffer, ibuffer);
+        const auto output = my_exts.get(chosen).fetch(i, vbuffer, ibuffer);
         ++my_used;
         return output;
     }
 
 private:
     std::vector<Index_> my_segments;
-    std::vector<std::unique_ptr<OracularSparseExtractor<Value_, Index_> > > my_exts;
+    LazyChildExtractors<true, true, Value_, Index_> my_exts;
     PredictionIndex my_used = 0;
 };
 
@@ -561,6 +742,25 @@ private:
  * @endcond
  */
 
+/**
+ * @brief Options for `DelayedBind`.
+ */
+struct DelayedBindOptions {
+    /**
+     * Thread pool for fetching from the child matrices in parallel.
+     * This only affects extraction of rows (if combining by column) or columns (if combining by row),
+     * where each call to `fetch()` needs to extract data from each of the child matrices.
+     * If provided, each `fetch()` distributes the child extractions across the threads of the pool and waits for them to finish before returning.
+     * This is most useful when there are a few large children where each `fetch()` is expensive, e.g., file-backed matrices;
+     * for small or in-memory children, the synchronization overhead will probably outweigh any benefit.
+     *
+     * If this is non-null, all child matrices should support concurrent calls to `fetch()` on different extractors from different threads,
+     * as is already required for use with `parallelize()`.
+     * If null, fetching from the children is performed sequentially in the calling thread.
+     */
+    std::shared_ptr<ThreadPool> child_thread_pool;
+};
+
 /**
  * @brief Delayed combining of a matrix.
  *
@@ -580,7 +780,17 @@ public:
      * If false, combining is applied by the columns.
      */
     DelayedBind(std::vector<std::shared_ptr<const Matrix<Value_, Index_> > > matrices, const bool by_row) : 
-        my_matrices(std::move(matrices)), my_by_row(by_row)
+        DelayedBind(std::move(matrices), by_row, DelayedBindOptions()) {}
+
+    /**
+     * @param matrices Pointers to the matrices to be combined.
+     * All matrices to be combined should have the same number of columns (if `row = true`) or rows (otherwise).
+     * @param by_row Whether to combine matrices by the rows (i.e., the output matrix has number of rows equal to the sum of the number of rows in `matrices`).
+     * If false, combining is applied by the columns.
+     * @param options Further options.
+     */
+    DelayedBind(std::vector<std::shared_ptr<const Matrix<Value_, Index_> > > matrices, const bool by_row, const DelayedBindOptions& options) : 
+        my_matrices(std::move(matrices)), my_by_row(by_row), my_child_pool(options.child_thread_pool)
     {
         auto nmats = my_matrices.size();
         my_cumulative.reserve(sanisizer::sum<I<decltype(my_cumulative.size())> >(nmats, 1));
@@ -671,6 +881,8 @@ private:
     double my_sparse_prop = 0, my_by_row_prop = 0;
     std::array<bool, 2> my_uses_oracle;
 
+    std::shared_ptr<ThreadPool> my_child_pool;
+
 public:
     Index_ nrow() const {
         if (my_by_row) {
@@ -737,6 +949,7 @@ public:
                 my_matrices,
                 row,
                 false,
+                my_child_pool.get(),
                 opt
             );
         }
@@ -767,6 +980,7 @@ public:
                 my_matrices,
                 row,
                 false,
+                my_child_pool.get(),
                 block_start,
                 block_length,
                 opt
@@ -797,6 +1011,7 @@ public:
                 my_matrices,
                 row,
                 false,
+                my_child_pool.get(),
                 std::move(indices_ptr),
                 opt
             );
@@ -828,6 +1043,7 @@ private:
                 my_matrices,
                 row,
                 false,
+                my_child_pool.get(),
                 opt
             );
         }
@@ -858,6 +1074,7 @@ private:
                 my_matrices,
                 row,
                 false,
+                my_child_pool.get(),
                 block_start,
                 block_length,
                 opt
@@ -888,6 +1105,7 @@ private:
                 my_matrices,
                 row,
                 false,
+                my_child_pool.get(),
                 std::move(indices_ptr),
                 opt
             );
@@ -926,6 +1144,7 @@ public:
                 my_matrices,
                 row,
                 std::move(oracle),
+                my_child_pool.get(),
                 opt
             );
         }
@@ -963,6 +1182,7 @@ public:
                 my_matrices,
                 row,
                 std::move(oracle),
+                my_child_pool.get(),
                 block_start,
                 block_length,
                 opt
@@ -1000,6 +1220,7 @@ public:
                 my_matrices,
                 row,
                 std::move(oracle),
+                my_child_pool.get(),
                 std::move(indices_ptr),
                 opt
             );
@@ -1038,6 +1259,7 @@ private:
                 my_matrices,
                 row,
                 std::move(oracle),
+                my_child_pool.get(),
                 opt
             );
         }
@@ -1075,6 +1297,7 @@ private:
                 my_matrices,
                 row,
                 std::move(oracle),
+                my_child_pool.get(),
                 block_start,
                 block_length,
                 opt
@@ -1112,6 +1335,7 @@ private:
                 my_matrices,
                 row,
                 std::move(oracle),
+                my_child_pool.get(),
                 std::move(indices_ptr),
                 opt
             );
@@ -26,7 +26,9 @@ namespace DelayedCast_internal {
 template<typename IndexIn_, typename IndexOut_>
 class CastOracle final : public Oracle<IndexIn_> {
 public:
-    CastOracle(std::shared_ptr<const Oracle<IndexOut_> > oracle) : my_oracle(std::move(oracle)) {}
+    CastOracle(std::shared_ptr<const Oracle<IndexOut_> > oracle) : my_oracle(std::move(oracle)) {
+        this->set_max_lookahead(my_oracle->max_lookahead());
+    }
 
     IndexIn_ get(const PredictionIndex i) const {
         return my_oracle->get(i);
@@ -36,6 +38,22 @@ public:
         return my_oracle->total();
     }
 
+    bool is_consecutive() const {
+        return my_oracle->is_consecutive();
+    }
+
+    bool is_strided() const {
+        return my_oracle->is_strided();
+    }
+
+    IndexIn_ stride() const {
+        return my_oracle->stride();
+    }
+
+    bool is_increasing() const {
+        return my_oracle->is_increasing();
+    }
+
 private:
     std::shared_ptr<const Oracle<IndexOut_> > my_oracle;
 };
@@ -0,0 +1,210 @@
+#ifndef TATAMI_DELAYED_PIPELINE_STAGE_HPP
+#define TATAMI_DELAYED_PIPELINE_STAGE_HPP
+
+#include "../base/Matrix.hpp"
+#include "../utils/AsyncPrefetchExtractor.hpp"
+
+#include <memory>
+
+/**
+ * @file DelayedPipelineStage.hpp
+ * @brief Run the extraction of a delayed subtree in its own thread.
+ */
+
+namespace tatami {
+
+/**
+ * @brief Pipeline stage in a tree of delayed operations.
+ *
+ * In a tree of delayed operations, each node pulls data synchronously from its child during extraction,
+ * so the work for each row/column is performed serially along the tree.
+ * Wrapping a node in a `DelayedPipelineStage` allows its extraction to run concurrently with the rest of the tree.
+ * Specifically, each oracle-aware extractor from this class extracts batches of rows/columns from the wrapped matrix in a helper thread,
+ * passing them to the parent through a bounded queue (see `AsyncPrefetchDenseExtractor` and `AsyncPrefetchSparseExtractor` for details).
+ * By inserting stages at multiple levels of the tree, each level is processed by a different thread,
+ * converting the depth of the tree into parallelism for a single consumer thread - for example, when a single extractor iterates over all rows of the matrix.
+ *
+ * This wrapper reports that it uses oracles so that parents will pass their predictions to it.
+ * Extractors without an oracle do not have any predictions to pipeline, so they are obtained directly from the wrapped matrix.
+ * Each oracle-aware extractor creates its own helper thread, so stages are most useful for expensive operations where the thread creation and synchronization overhead is negligible.
+ * The wrapped matrix should support extraction from a thread other than the one that created the extractor.
+ *
+ * @tparam Value_ Type of matrix value.
+ * @tparam Index_ Type of index value.
+ */
+template<typename Value_, typename Index_>
+class DelayedPipelineStage final : public Matrix<Value_, Index_> {
+public:
+    /**
+     * @param matrix Pointer to the matrix to be wrapped.
+     * @param options Options for the prefetching in each oracle-aware extractor,
+     * where `AsyncPrefetchExtractorOptions::num_buffers` is the maximum number of batches in the queue between this stage and its parent.
+     */
+    DelayedPipelineStage(std::shared_ptr<const Matrix<Value_, Index_> > matrix, const AsyncPrefetchExtractorOptions& options) :
+        my_matrix(std::move(matrix)), my_options(options) {}
+
+    /**
+     * @param matrix Pointer to the matrix to be wrapped.
+     */
+    DelayedPipelineStage(std::shared_ptr<const Matrix<Value_, Index_> > matrix) :
+        DelayedPipelineStage(std::move(matrix), AsyncPrefetchExtractorOptions()) {}
+
+private:
+    std::shared_ptr<const Matrix<Value_, Index_> > my_matrix;
+    AsyncPrefetchExtractorOptions my_options;
+
+public:
+    Index_ nrow() const {
+        return my_matrix->nrow();
+    }
+
+    Index_ ncol() const {
+        return my_matrix->ncol();
+    }
+
+    bool is_sparse() const {
+        return my_matrix->is_sparse();
+    }
+
+    double is_sparse_proportion() const {
+        return my_matrix->is_sparse_proportion();
+    }
+
+    bool prefer_rows() const {
+        return my_matrix->prefer_rows();
+    }
+
+    double prefer_rows_proportion() const {
+        return my_matrix->prefer_rows_proportion();
+    }
+
+    bool uses_oracle(const bool) const {
+        return true;
+    }
+
+    using Matrix<Value_, Index_>::dense;
+
+    using Matrix<Value_, Index_>::sparse;
+
+    /********************
+     *** Myopic dense ***
+     ********************/
+public:
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        const Options& opt
+    ) const {
+        return my_matrix->dense(row, opt);
+    }
+
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return my_matrix->dense(row, block_start, block_length, opt);
+    }
+
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return my_matrix->dense(row, std::move(indices_ptr), opt);
+    }
+
+    /*********************
+     *** Myopic sparse ***
+     *********************/
+public:
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        const Options& opt
+    ) const {
+        return my_matrix->sparse(row, opt);
+    }
+
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return my_matrix->sparse(row, block_start, block_length, opt);
+    }
+
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return my_matrix->sparse(row, std::move(indices_ptr), opt);
+    }
+
+    /**********************
+     *** Oracular dense ***
+     **********************/
+public:
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Options& opt
+    ) const {
+        return new_async_prefetch_extractor<false>(*my_matrix, row, std::move(oracle), my_options, opt);
+    }
+
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return new_async_prefetch_extractor<false>(*my_matrix, row, std::move(oracle), my_options, block_start, block_length, opt);
+    }
+
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return new_async_prefetch_extractor<false>(*my_matrix, row, std::move(oracle), my_options, std::move(indices_ptr), opt);
+    }
+
+    /***********************
+     *** Oracular sparse ***
+     ***********************/
+public:
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Options& opt
+    ) const {
+        return new_async_prefetch_extractor<true>(*my_matrix, row, std::move(oracle), my_options, opt);
+    }
+
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return new_async_prefetch_extractor<true>(*my_matrix, row, std::move(oracle), my_options, block_start, block_length, opt);
+    }
+
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return new_async_prefetch_extractor<true>(*my_matrix, row, std::move(oracle), my_options, std::move(indices_ptr), opt);
+    }
+};
+
+}
+
+#endif
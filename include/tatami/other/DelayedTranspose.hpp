@@ -34,6 +34,14 @@ public:
 private:
     std::shared_ptr<const Matrix<Value_, Index_> > my_matrix;
 
+public:
+    /**
+     * @return Pointer to the underlying (pre-transposition) matrix.
+     */
+    const std::shared_ptr<const Matrix<Value_, Index_> >& underlying_matrix() const {
+        return my_matrix;
+    }
+
 public:
     Index_ nrow() const {
         return my_matrix->ncol();
@@ -0,0 +1,512 @@
+#ifndef TATAMI_SPARSE_PLUS_OFFSET_MATRIX_HPP
+#define TATAMI_SPARSE_PLUS_OFFSET_MATRIX_HPP
+
+#include "../base/Matrix.hpp"
+#include "../utils/new_extractor.hpp"
+#include "../utils/Index_to_container.hpp"
+#include "../utils/copy.hpp"
+
+#include <vector>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <algorithm>
+
+/**
+ * @file SparsePlusOffsetMatrix.hpp
+ * @brief Sparse matrix plus scalar, row and column offsets.
+ */
+
+namespace tatami {
+
+/**
+ * @cond
+ */
+namespace SparsePlusOffsetMatrix_internal {
+
+template<typename Value_, typename Index_>
+std::vector<Value_> define_other_offsets(const std::vector<Value_>& other, const Index_ extent) {
+    if (other.empty()) {
+        return std::vector<Value_>();
+    } else {
+        return std::vector<Value_>(other.begin(), other.begin() + extent);
+    }
+}
+
+template<typename Value_, typename Index_>
+std::vector<Value_> define_other_offsets(const std::vector<Value_>& other, const Index_ block_start, const Index_ block_length) {
+    if (other.empty()) {
+        return std::vector<Value_>();
+    } else {
+        return std::vector<Value_>(other.begin() + block_start, other.begin() + block_start + block_length);
+    }
+}
+
+template<typename Value_, typename Index_>
+std::vector<Value_> define_other_offsets(const std::vector<Value_>& other, const std::vector<Index_>& indices) {
+    std::vector<Value_> output;
+    if (!other.empty()) {
+        output.reserve(indices.size());
+        for (auto i : indices) {
+            output.push_back(other[i]);
+        }
+    }
+    return output;
+}
+
+template<bool oracle_, typename Value_, typename Index_>
+class Dense final : public DenseExtractor<oracle_, Value_, Index_> {
+public:
+    template<typename ... Args_>
+    Dense(
+        const Matrix<Value_, Index_>& core,
+        const Value_ scalar,
+        const std::vector<Value_>& target_offsets,
+        std::vector<Value_> other_offsets,
+        const Index_ extent,
+        const bool row,
+        MaybeOracle<oracle_, Index_> oracle,
+        Args_&& ... args
+    ) :
+        my_scalar(scalar),
+        my_target_offsets(target_offsets),
+        my_other_offsets(std::move(other_offsets)),
+        my_extent(extent)
+    {
+        if constexpr(oracle_) {
+            if (!my_target_offsets.empty()) {
+                my_oracle = oracle;
+            }
+        }
+        my_ext = new_extractor<false, oracle_>(core, row, std::move(oracle), std::forward<Args_>(args)...);
+    }
+
+private:
+    Value_ my_scalar;
+    const std::vector<Value_>& my_target_offsets;
+    std::vector<Value_> my_other_offsets;
+    Index_ my_extent;
+    std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > my_ext;
+
+    MaybeOracle<oracle_, Index_> my_oracle;
+    typename std::conditional<oracle_, PredictionIndex, bool>::type my_used = 0;
+
+public:
+    const Value_* fetch(Index_ i, Value_* const buffer) {
+        if constexpr(oracle_) {
+            if (my_oracle) {
+                i = my_oracle->get(my_used++);
+            }
+        }
+
+        const auto ptr = my_ext->fetch(i, buffer);
+        const Value_ shift = my_scalar + (my_target_offsets.empty() ? static_cast<Value_>(0) : my_target_offsets[i]);
+
+        // Keeping the loops simple so that the broadcasts can be vectorized.
+        if (my_other_offsets.empty()) {
+            for (Index_ j = 0; j < my_extent; ++j) {
+                buffer[j] = ptr[j] + shift;
+            }
+        } else {
+            const auto optr = my_other_offsets.data();
+            for (Index_ j = 0; j < my_extent; ++j) {
+                buffer[j] = ptr[j] + optr[j] + shift;
+            }
+        }
+        return buffer;
+    }
+};
+
+// If any offsets are present, all elements are structural non-zeros,
+// so we just report the dense results in sparse form.
+template<bool oracle_, typename Value_, typename Index_>
+class Sparse final : public SparseExtractor<oracle_, Value_, Index_> {
+public:
+    Sparse(
+        std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > dense,
+        std::vector<Index_> indices,
+        const Options& opt
+    ) :
+        my_dense(std::move(dense)),
+        my_indices(std::move(indices)),
+        my_needs_value(opt.sparse_extract_value),
+        my_needs_index(opt.sparse_extract_index)
+    {}
+
+private:
+    std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > my_dense;
+    std::vector<Index_> my_indices;
+    bool my_needs_value, my_needs_index;
+
+public:
+    SparseRange<Value_, Index_> fetch(const Index_ i, Value_* const value_buffer, Index_* const) {
+        SparseRange<Value_, Index_> output(my_indices.size(), NULL, NULL);
+        if (my_needs_value) {
+            output.value = my_dense->fetch(i, value_buffer);
+        }
+        if (my_needs_index) {
+            output.index = my_indices.data();
+        }
+        return output;
+    }
+};
+
+}
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Sparse matrix plus scalar, row and column offsets.
+ *
+ * This class represents a matrix of the form \f$X + a + r 1^T + 1 c^T\f$ where \f$X\f$ is a (typically sparse) "core" matrix,
+ * \f$a\f$ is a scalar, \f$r\f$ is a vector of row-specific offsets and \f$c\f$ is a vector of column-specific offsets.
+ * This is most useful for representing the result of centering or shifting a sparse matrix,
+ * e.g., subtracting the column means from a sparse count matrix.
+ * Unlike a `DelayedUnaryIsometricOperation` that adds a scalar or vector, the structure of the result is retained and can be queried via `core()` and the offset methods.
+ * Downstream applications can then exploit the sparsity of the core matrix directly,
+ * e.g., a matrix product can be computed as the product with the sparse core plus a rank-1 correction for each set of offsets.
+ *
+ * Dense extraction simply adds the offsets to the values extracted from the core matrix.
+ * If any offsets are present, all elements are considered to be structurally non-zero, so `is_sparse()` will return false.
+ * In that case, sparse extraction will report all elements in the requested row/column.
+ * If the scalar is zero and all row/column offsets are zero (or absent), all extraction is directly forwarded to the core matrix.
+ *
+ * @tparam Value_ Type of the matrix values.
+ * @tparam Index_ Type of the row/column indices.
+ */
+template<typename Value_, typename Index_>
+class SparsePlusOffsetMatrix final : public Matrix<Value_, Index_> {
+public:
+    /**
+     * @param core Pointer to the core matrix.
+     * @param scalar Scalar offset to add to all elements of `core`.
+     * @param row_offsets Vector of row-specific offsets, of length equal to the number of rows in `core`.
+     * Alternatively, this may be empty if no row-specific offsets are to be added.
+     * @param column_offsets Vector of column-specific offsets, of length equal to the number of columns in `core`.
+     * Alternatively, this may be empty if no column-specific offsets are to be added.
+     */
+    SparsePlusOffsetMatrix(
+        std::shared_ptr<const Matrix<Value_, Index_> > core,
+        const Value_ scalar,
+        std::vector<Value_> row_offsets,
+        std::vector<Value_> column_offsets
+    ) :
+        my_core(std::move(core)),
+        my_scalar(scalar),
+        my_row_offsets(std::move(row_offsets)),
+        my_column_offsets(std::move(column_offsets))
+    {
+        if (!my_row_offsets.empty() && !safe_non_negative_equal(my_row_offsets.size(), my_core->nrow())) {
+            throw std::runtime_error("length of 'row_offsets' should be equal to the number of rows in 'core'");
+        }
+        if (!my_column_offsets.empty() && !safe_non_negative_equal(my_column_offsets.size(), my_core->ncol())) {
+            throw std::runtime_error("length of 'column_offsets' should be equal to the number of columns in 'core'");
+        }
+        // Offset vectors that are all zero have no effect, so we can treat them as if they were absent.
+        const auto is_nonzero = [](const Value_ x) -> bool { return x != 0; };
+        my_has_offsets = (
+            my_scalar != 0 ||
+            std::any_of(my_row_offsets.begin(), my_row_offsets.end(), is_nonzero) ||
+            std::any_of(my_column_offsets.begin(), my_column_offsets.end(), is_nonzero)
+        );
+    }
+
+private:
+    std::shared_ptr<const Matrix<Value_, Index_> > my_core;
+    Value_ my_scalar;
+    std::vector<Value_> my_row_offsets, my_column_offsets;
+    bool my_has_offsets;
+
+public:
+    /**
+     * @return Pointer to the core matrix.
+     */
+    const std::shared_ptr<const Matrix<Value_, Index_> >& core() const {
+        return my_core;
+    }
+
+    /**
+     * @return Scalar offset that is added to all elements of the core matrix.
+     */
+    Value_ scalar_offset() const {
+        return my_scalar;
+    }
+
+    /**
+     * @return Vector of row-specific offsets.
+     * This is empty if no row-specific offsets are present.
+     */
+    const std::vector<Value_>& row_offsets() const {
+        return my_row_offsets;
+    }
+
+    /**
+     * @return Vector of column-specific offsets.
+     * This is empty if no column-specific offsets are present.
+     */
+    const std::vector<Value_>& column_offsets() const {
+        return my_column_offsets;
+    }
+
+public:
+    Index_ nrow() const {
+        return my_core->nrow();
+    }
+
+    Index_ ncol() const {
+        return my_core->ncol();
+    }
+
+    bool is_sparse() const {
+        return !my_has_offsets && my_core->is_sparse();
+    }
+
+    double is_sparse_proportion() const {
+        return (my_has_offsets ? 0 : my_core->is_sparse_proportion());
+    }
+
+    bool prefer_rows() const {
+        return my_core->prefer_rows();
+    }
+
+    double prefer_rows_proportion() const {
+        return my_core->prefer_rows_proportion();
+    }
+
+    bool uses_oracle(const bool row) const {
+        return my_core->uses_oracle(row);
+    }
+
+    using Matrix<Value_, Index_>::dense;
+
+    using Matrix<Value_, Index_>::sparse;
+
+private:
+    template<bool oracle_>
+    std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > dense_internal(
+        const bool row,
+        MaybeOracle<oracle_, Index_> oracle,
+        const Options& opt
+    ) const {
+        if (!my_has_offsets) {
+            return new_extractor<false, oracle_>(*my_core, row, std::move(oracle), opt);
+        }
+        const Index_ extent = (row ? my_core->ncol() : my_core->nrow());
+        const auto& other = (row ? my_column_offsets : my_row_offsets);
+        return std::make_unique<SparsePlusOffsetMatrix_internal::Dense<oracle_, Value_, Index_> >(
+            *my_core,
+            my_scalar,
+            (row ? my_row_offsets : my_column_offsets),
+            SparsePlusOffsetMatrix_internal::define_other_offsets(other, extent),
+            extent,
+            row,
+            std::move(oracle),
+            opt
+        );
+    }
+
+    template<bool oracle_>
+    std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > dense_internal(
+        const bool row,
+        MaybeOracle<oracle_, Index_> oracle,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        if (!my_has_offsets) {
+            return new_extractor<false, oracle_>(*my_core, row, std::move(oracle), block_start, block_length, opt);
+        }
+        const auto& other = (row ? my_column_offsets : my_row_offsets);
+        return std::make_unique<SparsePlusOffsetMatrix_internal::Dense<oracle_, Value_, Index_> >(
+            *my_core,
+            my_scalar,
+            (row ? my_row_offsets : my_column_offsets),
+            SparsePlusOffsetMatrix_internal::define_other_offsets(other, block_start, block_length),
+            block_length,
+            row,
+            std::move(oracle),
+            block_start,
+            block_length,
+            opt
+        );
+    }
+
+    template<bool oracle_>
+    std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > dense_internal(
+        const bool row,
+        MaybeOracle<oracle_, Index_> oracle,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        if (!my_has_offsets) {
+            return new_extractor<false, oracle_>(*my_core, row, std::move(oracle), std::move(indices_ptr), opt);
+        }
+        const auto& other = (row ? my_column_offsets : my_row_offsets);
+        auto other_offsets = SparsePlusOffsetMatrix_internal::define_other_offsets(other, *indices_ptr);
+        const auto extent = static_cast<Index_>(indices_ptr->size());
+        return std::make_unique<SparsePlusOffsetMatrix_internal::Dense<oracle_, Value_, Index_> >(
+            *my_core,
+            my_scalar,
+            (row ? my_row_offsets : my_column_offsets),
+            std::move(other_offsets),
+            extent,
+            row,
+            std::move(oracle),
+            std::move(indices_ptr),
+            opt
+        );
+    }
+
+    template<bool oracle_>
+    std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > sparse_internal(
+        const bool row,
+        MaybeOracle<oracle_, Index_> oracle,
+        const Options& opt
+    ) const {
+        if (!my_has_offsets) {
+            return new_extractor<true, oracle_>(*my_core, row, std::move(oracle), opt);
+        }
+        std::vector<Index_> indices;
+        resize_container_to_Index_size(indices, (row ? my_core->ncol() : my_core->nrow()));
+        std::iota(indices.begin(), indices.end(), static_cast<Index_>(0));
+        return std::make_unique<SparsePlusOffsetMatrix_internal::Sparse<oracle_, Value_, Index_> >(dense_internal<oracle_>(row, std::move(oracle), opt), std::move(indices), opt);
+    }
+
+    template<bool oracle_>
+    std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > sparse_internal(
+        const bool row,
+        MaybeOracle<oracle_, Index_> oracle,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        if (!my_has_offsets) {
+            return new_extractor<true, oracle_>(*my_core, row, std::move(oracle), block_start, block_length, opt);
+        }
+        std::vector<Index_> indices;
+        resize_container_to_Index_size(indices, block_length);
+        std::iota(indices.begin(), indices.end(), block_start);
+        return std::make_unique<SparsePlusOffsetMatrix_internal::Sparse<oracle_, Value_, Index_> >(
+            dense_internal<oracle_>(row, std::move(oracle), block_start, block_length, opt),
+            std::move(indices),
+            opt
+        );
+    }
+
+    template<bool oracle_>
+    std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > sparse_internal(
+        const bool row,
+        MaybeOracle<oracle_, Index_> oracle,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        if (!my_has_offsets) {
+            return new_extractor<true, oracle_>(*my_core, row, std::move(oracle), std::move(indices_ptr), opt);
+        }
+        std::vector<Index_> indices(indices_ptr->begin(), indices_ptr->end());
+        return std::make_unique<SparsePlusOffsetMatrix_internal::Sparse<oracle_, Value_, Index_> >(
+            dense_internal<oracle_>(row, std::move(oracle), std::move(indices_ptr), opt),
+            std::move(indices),
+            opt
+        );
+    }
+
+    /********************
+     *** Myopic dense ***
+     ********************/
+public:
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(const bool row, const Options& opt) const {
+        return dense_internal<false>(row, false, opt);
+    }
+
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(const bool row, const Index_ block_start, const Index_ block_length, const Options& opt) const {
+        return dense_internal<false>(row, false, block_start, block_length, opt);
+    }
+
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(const bool row, VectorPtr<Index_> indices_ptr, const Options& opt) const {
+        return dense_internal<false>(row, false, std::move(indices_ptr), opt);
+    }
+
+    /*********************
+     *** Myopic sparse ***
+     *********************/
+public:
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(const bool row, const Options& opt) const {
+        return sparse_internal<false>(row, false, opt);
+    }
+
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(const bool row, const Index_ block_start, const Index_ block_length, const Options& opt) const {
+        return sparse_internal<false>(row, false, block_start, block_length, opt);
+    }
+
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(const bool row, VectorPtr<Index_> indices_ptr, const Options& opt) const {
+        return sparse_internal<false>(row, false, std::move(indices_ptr), opt);
+    }
+
+    /**********************
+     *** Oracular dense ***
+     **********************/
+public:
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Options& opt
+    ) const {
+        return dense_internal<true>(row, std::move(oracle), opt);
+    }
+
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return dense_internal<true>(row, std::move(oracle), block_start, block_length, opt);
+    }
+
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return dense_internal<true>(row, std::move(oracle), std::move(indices_ptr), opt);
+    }
+
+    /***********************
+     *** Oracular sparse ***
+     ***********************/
+public:
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Options& opt
+    ) const {
+        return sparse_internal<true>(row, std::move(oracle), opt);
+    }
+
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return sparse_internal<true>(row, std::move(oracle), block_start, block_length, opt);
+    }
+
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return sparse_internal<true>(row, std::move(oracle), std::move(indices_ptr), opt);
+    }
+};
+
+}
+
+#endif
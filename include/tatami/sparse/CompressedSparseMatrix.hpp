@@ -7,6 +7,7 @@
 #include <utility>
 #include <stdexcept>
 #include <cstddef>
+#include <optional>
 
 #include "sanisizer/sanisizer.hpp"
 
@@ -14,6 +15,9 @@
 #include "../utils/ElementType.hpp"
 #include "../utils/copy.hpp"
 #include "../utils/PseudoOracularExtractor.hpp"
+#include "../utils/Index_to_container.hpp"
+#include "../utils/parallelize.hpp"
+#include "../subset/SubsetMaterializable.hpp"
 
 #include "primary_extraction.hpp"
 #include "secondary_extraction.hpp"
@@ -536,6 +540,133 @@ private:
     bool my_needs_value, my_needs_index;
 };
 
+/**********************
+ *** Subset helpers ***
+ **********************/
+
+// For each secondary index of the stored matrix, this holds the positions in the secondary subset that refer to that index.
+// Positions for a given index are stored in increasing order, so the mapping is monotonic if the subset is sorted.
+template<typename Index_>
+struct SecondarySubsetMap {
+    std::vector<std::size_t> pointers;
+    std::vector<Index_> positions;
+};
+
+template<typename Index_>
+SecondarySubsetMap<Index_> create_secondary_subset_map(const std::vector<Index_>& subset, const Index_ secondary) {
+    SecondarySubsetMap<Index_> output;
+    output.pointers.resize(sanisizer::sum<I<decltype(output.pointers.size())> >(attest_for_Index(secondary), 1));
+    for (const auto s : subset) {
+        ++(output.pointers[s + 1]);
+    }
+    for (Index_ s = 0; s < secondary; ++s) {
+        output.pointers[s + 1] += output.pointers[s];
+    }
+
+    const Index_ len = subset.size();
+    resize_container_to_Index_size(output.positions, len);
+    std::vector<std::size_t> offsets(output.pointers.begin(), output.pointers.begin() + secondary);
+    for (Index_ i = 0; i < len; ++i) {
+        auto& pos = offsets[subset[i]];
+        output.positions[pos] = i;
+        ++pos;
+    }
+
+    return output;
+}
+
+// Calls 'fun' on each structural non-zero of the stored primary dimension element 'p' whose secondary index is in the subset described by 'map',
+// passing the position in the secondary subset and the value. If 'map' is NULL, the secondary index is passed directly.
+template<typename Index_, class ValueStorage_, class IndexStorage_, class PointerStorage_, class Function_>
+void scan_subset_primary(
+    const ValueStorage_& values,
+    const IndexStorage_& indices,
+    const PointerStorage_& pointers,
+    const Index_ p,
+    const SecondarySubsetMap<Index_>* const map,
+    Function_ fun
+) {
+    const auto start = pointers[p], end = pointers[p + 1];
+    for (auto x = start; x < end; ++x) {
+        const Index_ s = indices[x];
+        if (map) {
+            const auto pstart = map->pointers[s], pend = map->pointers[s + 1];
+            for (auto y = pstart; y < pend; ++y) {
+                fun(map->positions[y], values[x]);
+            }
+        } else {
+            fun(s, values[x]);
+        }
+    }
+}
+
+template<typename Value_, typename Index_, class ValueStorage_, class IndexStorage_, class PointerStorage_>
+class CompressedSubsetScanner final : public SubsetScanner<Value_, Index_> {
+public:
+    CompressedSubsetScanner(
+        const ValueStorage_& values,
+        const IndexStorage_& indices,
+        const PointerStorage_& pointers,
+        const bool csr,
+        const Index_ num_primary,
+        const Index_ num_secondary,
+        const std::vector<Index_>* const primary_subset,
+        const std::vector<Index_>* const secondary_subset
+    ) :
+        my_values(values),
+        my_indices(indices),
+        my_pointers(pointers),
+        my_csr(csr),
+        my_primary_subset(primary_subset),
+        my_num_primary(primary_subset ? primary_subset->size() : num_primary),
+        my_num_secondary(secondary_subset ? secondary_subset->size() : num_secondary),
+        // Positions are only guaranteed to be increasing if the secondary subset is sorted.
+        my_sorted(secondary_subset == NULL || std::is_sorted(secondary_subset->begin(), secondary_subset->end()))
+    {
+        if (secondary_subset) {
+            my_map = create_secondary_subset_map(*secondary_subset, num_secondary);
+        }
+    }
+
+private:
+    const ValueStorage_& my_values;
+    const IndexStorage_& my_indices;
+    const PointerStorage_& my_pointers;
+    bool my_csr;
+    const std::vector<Index_>* my_primary_subset;
+    Index_ my_num_primary, my_num_secondary;
+    bool my_sorted;
+    std::optional<SecondarySubsetMap<Index_> > my_map;
+
+public:
+    bool by_row() const {
+        return my_csr;
+    }
+
+    Index_ primary() const {
+        return my_num_primary;
+    }
+
+    Index_ secondary() const {
+        return my_num_secondary;
+    }
+
+    bool sorted() const {
+        return my_sorted;
+    }
+
+    Index_ scan(const Index_ p, Value_* const value_buffer, Index_* const index_buffer) const {
+        const Index_ stored = (my_primary_subset ? (*my_primary_subset)[p] : p);
+        Index_ count = 0;
+        scan_subset_primary(my_values, my_indices, my_pointers, stored, (my_map.has_value() ? &(*my_map) : NULL), [&](const Index_ s, const auto& v) -> void {
+            value_buffer[count] = v;
+            index_buffer[count] = s;
+            ++count;
+        });
+        return count;
+    }
+};
+
 }
 /**
  * @endcond
@@ -577,7 +708,7 @@ struct CompressedSparseMatrixOptions {
  * Methods should be available for `size()`, `begin()`, `end()` and `[]`.
  */
 template<typename Value_, typename Index_, class ValueStorage_, class IndexStorage_, class PointerStorage_>
-class CompressedSparseMatrix : public Matrix<Value_, Index_> {
+class CompressedSparseMatrix : public Matrix<Value_, Index_>, public SubsetMaterializable<Value_, Index_> {
 public:
     /**
      * @param nrow Number of rows.
@@ -719,6 +850,84 @@ private:
         }
     }
 
+    /*************************
+     ******* Subsetting ******
+     *************************/
+public:
+    /**
+     * @cond
+     */
+    std::unique_ptr<SubsetScanner<Value_, Index_> > subset_scanner(
+        const std::vector<Index_>* const row_subset,
+        const std::vector<Index_>* const column_subset
+    ) const {
+        return std::make_unique<CompressedSparseMatrix_internal::CompressedSubsetScanner<Value_, Index_, ValueStorage_, IndexStorage_, PointerStorage_> >(
+            my_values,
+            my_indices,
+            my_pointers,
+            my_csr,
+            (my_csr ? my_nrow : my_ncol),
+            secondary(),
+            (my_csr ? row_subset : column_subset),
+            (my_csr ? column_subset : row_subset)
+        );
+    }
+
+    void subset_materialize(
+        const std::vector<Index_>* row_subset,
+        const std::vector<Index_>* column_subset,
+        const bool row_major,
+        Value_* const store,
+        const int num_threads
+    ) const {
+        const auto primary_subset = (my_csr ? row_subset : column_subset);
+        const auto secondary_subset = (my_csr ? column_subset : row_subset);
+        const Index_ num_primary = (primary_subset ? primary_subset->size() : (my_csr ? my_nrow : my_ncol));
+        const Index_ num_secondary = (secondary_subset ? secondary_subset->size() : secondary());
+
+        std::optional<CompressedSparseMatrix_internal::SecondarySubsetMap<Index_> > map;
+        if (secondary_subset) {
+            map = CompressedSparseMatrix_internal::create_secondary_subset_map(*secondary_subset, secondary());
+        }
+        const auto mptr = (map.has_value() ? &(*map) : NULL);
+        const auto get_primary = [&](const Index_ p) -> Index_ {
+            return (primary_subset ? (*primary_subset)[p] : p);
+        };
+
+        // We assume that 'store' was allocated correctly, in which case the product of 'num_primary' and 'num_secondary' is known to fit inside a std::size_t.
+        if (row_major == my_csr) {
+            parallelize([&](const int, const Index_ start, const Index_ length) -> void {
+                for (Index_ p = start, end = start + length; p < end; ++p) {
+                    const auto output = store + sanisizer::product_unsafe<std::size_t>(p, num_secondary);
+                    std::fill_n(output, num_secondary, 0);
+                    CompressedSparseMatrix_internal::scan_subset_primary(my_values, my_indices, my_pointers, get_primary(p), mptr, [&](const Index_ s, const auto& v) -> void { output[s] = v; });
+                }
+            }, num_primary, num_threads);
+
+        } else {
+            // Zeroing in parallel so that pages are first touched by the workers, see convert_to_dense() for details.
+            parallelize([&](const int, const Index_ start, const Index_ length) -> void {
+                std::fill_n(
+                    store + sanisizer::product_unsafe<std::size_t>(start, num_primary),
+                    sanisizer::product_unsafe<std::size_t>(length, num_primary),
+                    0
+                );
+            }, num_secondary, num_threads);
+
+            // Workers handle disjoint ranges of the stored primary dimension, which are written to disjoint positions of the output.
+            parallelize([&](const int, const Index_ start, const Index_ length) -> void {
+                for (Index_ p = start, end = start + length; p < end; ++p) {
+                    CompressedSparseMatrix_internal::scan_subset_primary(my_values, my_indices, my_pointers, get_primary(p), mptr, [&](const Index_ s, const auto& v) -> void {
+                        store[sanisizer::nd_offset<std::size_t>(p, num_primary, s)] = v;
+                    });
+                }
+            }, num_primary, num_threads);
+        }
+    }
+    /**
+     * @endcond
+     */
+
     /*****************************
      ******* Dense myopic ********
      *****************************/
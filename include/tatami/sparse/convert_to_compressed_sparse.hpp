@@ -11,9 +11,11 @@
 #include "convert_to_sparse_utils.hpp"
 
 #include "../utils/parallelize.hpp"
+#include "../utils/parallelize_weighted.hpp"
 #include "../utils/consecutive_extractor.hpp"
 #include "../utils/Index_to_container.hpp"
 #include "../utils/copy.hpp"
+#include "../subset/subset_materialize.hpp"
 
 /**
  * @file convert_to_compressed_sparse.hpp
@@ -111,7 +113,9 @@ void fill_compressed_sparse_matrix_consistent(
         Options opt;
         opt.sparse_ordered_index = false;
 
-        parallelize([&](const int, const InputIndex_ start, const InputIndex_ length) -> void {
+        // The cost of each primary dimension element is proportional to its number of non-zeros,
+        // so we use the pointers to balance the load across threads for matrices with skewed densities.
+        parallelize_by_pointers([&](const int, const InputIndex_ start, const InputIndex_ length) -> void {
             auto wrk = consecutive_extractor<true>(matrix, row, start, length, opt);
             auto buffer_v = create_container_of_Index_size<std::vector<InputValue_> >(secondary);
             auto buffer_i = create_container_of_Index_size<std::vector<InputIndex_> >(secondary);
@@ -127,7 +131,7 @@ void fill_compressed_sparse_matrix_consistent(
                 std::copy_n(range.value, range.number, output_value + offset);
                 std::copy_n(range.index, range.number, output_index + offset);
             }
-        }, primary, threads);
+        }, pointers, primary, threads);
 
     } else {
         parallelize([&](const int, const InputIndex_ start, const InputIndex_ length) -> void {
@@ -317,6 +321,11 @@ CompressedSparseContents<StoredValue_, StoredIndex_, StoredPointer_> retrieve_co
     auto& output_i = output.index;
     auto& output_p = output.pointers;
 
+    // Delayed subsets and transpositions of a concrete matrix can be materialized directly from its storage, e.g., for a transposed CompressedSparseMatrix.
+    if (subset_materialize(matrix, row, output_v, output_i, output_p, options.num_threads)) {
+        return output;
+    }
+
     const InputIndex_ NR = matrix.nrow();
     const InputIndex_ NC = matrix.ncol();
     const InputIndex_ primary = (row ? NR : NC);
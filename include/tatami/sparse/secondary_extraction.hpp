@@ -7,11 +7,29 @@
 #include <vector>
 #include <type_traits>
 #include <algorithm>
+#include <functional>
+#include <utility>
 
 namespace tatami {
 
 namespace sparse_utils {
 
+// Decide whether to track the cursors in a heap, based on the expected number of matches per request.
+// Each match in the heap costs O(log(primary_length)) while the linear scan costs O(primary_length) per request,
+// so the heap is only worthwhile if the primary elements are sparse enough that most of them are skipped.
+template<typename Index_, typename Count_>
+bool use_secondary_heap(const Count_ total_nnz, const Index_ primary_length, const Index_ max_index) {
+    if (primary_length <= 1) {
+        return false;
+    }
+
+    double log_length = 0;
+    for (auto x = primary_length; x > 0; x /= 2) {
+        ++log_length;
+    }
+    return static_cast<double>(total_nnz) * log_length < static_cast<double>(primary_length) * static_cast<double>(max_index);
+}
+
 template<typename Index_, class IndexServer_> 
 class SecondaryExtractionCache {
 private:
@@ -52,6 +70,14 @@ private:
     // Was the last requested index greater than its predecessor?
     bool my_last_increasing = true;
 
+    // For sparse primary elements, we store a min-heap of '(my_cached_indices[i], i)' for all 'i' where 'my_cached_indices[i] < my_max_index'.
+    // This allows increasing requests to only visit the primary elements that might contain the requested index,
+    // such that the cost of each request scales with the number of non-zeros rather than the number of primary elements.
+    // The heap is only valid when 'my_last_increasing = true' and is rebuilt whenever we switch back from decreasing requests.
+    bool my_use_heap = false;
+    std::vector<std::pair<Index_, Index_> > my_heap;
+    std::vector<Index_> my_heap_found;
+
 public:
     template<class PrimaryFunction_>
     SecondaryExtractionCache(
@@ -65,21 +91,48 @@ public:
         my_cached_pointers(cast_Index_to_container_size<decltype(my_cached_pointers)>(primary_length)),
         my_cached_indices(cast_Index_to_container_size<decltype(my_cached_indices)>(primary_length))
     {
+        std::size_t total_nnz = 0;
         for (Index_ p = 0; p < primary_length; ++p) {
             const auto primary = to_primary(p);
             auto& curptr = my_cached_pointers[p];
             curptr = my_indices_server.start_offset(primary);
-            my_cached_indices[p] = (curptr == my_indices_server.end_offset(primary) ? my_max_index : *(my_indices_server.raw(primary) + curptr));
+            const auto endptr = my_indices_server.end_offset(primary);
+            my_cached_indices[p] = (curptr == endptr ? my_max_index : *(my_indices_server.raw(primary) + curptr));
+            total_nnz += endptr - curptr;
         }
         if (primary_length) {
             my_closest_cached_index = *(std::min_element(my_cached_indices.begin(), my_cached_indices.end()));
         }
+
+        my_use_heap = use_secondary_heap(total_nnz, primary_length, max_index);
+        if (my_use_heap) {
+            rebuild_heap();
+        }
     }
 
     auto size() const {
         return my_cached_indices.size();
     }
 
+    bool uses_heap() const {
+        return my_use_heap;
+    }
+
+private:
+    void rebuild_heap() {
+        my_heap.clear();
+        for (Index_ p = 0, plen = my_cached_indices.size(); p < plen; ++p) {
+            if (my_cached_indices[p] != my_max_index) {
+                my_heap.emplace_back(my_cached_indices[p], p);
+            }
+        }
+        std::make_heap(my_heap.begin(), my_heap.end(), std::greater<std::pair<Index_, Index_> >());
+    }
+
+    Index_ heap_closest_index() const {
+        return (my_heap.empty() ? my_max_index : my_heap.front().first);
+    }
+
 private:
     template<class Store_>
     void search_above(
@@ -229,6 +282,43 @@ private:
         return;
     }
 
+private:
+    template<class PrimaryFunction_, class Store_>
+    void search_heap(
+        const Index_ secondary,
+        const PrimaryFunction_ to_primary,
+        const Store_ store,
+        bool& found
+    ) {
+        // Only popping the primary elements whose cached index is not greater than 'secondary',
+        // as all other elements cannot contain 'secondary' and do not need to be updated.
+        const std::greater<std::pair<Index_, Index_> > cmp;
+        my_heap_found.clear();
+        while (!my_heap.empty() && my_heap.front().first <= secondary) {
+            const Index_ p = my_heap.front().second;
+            std::pop_heap(my_heap.begin(), my_heap.end(), cmp);
+            my_heap.pop_back();
+
+            bool hit = false;
+            search_above(secondary, p, to_primary(p), [](Index_, Index_, const Pointer&) -> void {}, hit);
+            if (hit) {
+                my_heap_found.push_back(p);
+            } else if (my_cached_indices[p] != my_max_index) {
+                my_heap.emplace_back(my_cached_indices[p], p);
+                std::push_heap(my_heap.begin(), my_heap.end(), cmp);
+            }
+        }
+
+        // Callers expect the matches in order of increasing primary element.
+        std::sort(my_heap_found.begin(), my_heap_found.end());
+        for (const auto p : my_heap_found) {
+            store(to_primary(p), p, my_cached_pointers[p]);
+            my_heap.emplace_back(secondary, p);
+            std::push_heap(my_heap.begin(), my_heap.end(), cmp);
+        }
+        found = !my_heap_found.empty();
+    }
+
 public:
     template<class PrimaryFunction_, class Store_>
     bool search(
@@ -244,8 +334,12 @@ public:
                     my_last_request = secondary;
                     return false; 
                 }
-                for (Index_ p = 0, plen = my_cached_indices.size(); p < plen; ++p) {
-                    search_above(secondary, p, to_primary(p), store, found);
+                if (my_use_heap) {
+                    search_heap(secondary, to_primary, store, found);
+                } else {
+                    for (Index_ p = 0, plen = my_cached_indices.size(); p < plen; ++p) {
+                        search_above(secondary, p, to_primary(p), store, found);
+                    }
                 }
 
             } else {
@@ -257,10 +351,15 @@ public:
                     my_cached_indices[p] = (curptr == my_indices_server.end_offset(primary) ? my_max_index : *(my_indices_server.raw(primary) + curptr));
                     search_above(secondary, p, primary, store, found);
                 }
+                if (my_use_heap) {
+                    rebuild_heap();
+                }
             }
 
             if (found) {
                 my_closest_cached_index = secondary;
+            } else if (my_use_heap) {
+                my_closest_cached_index = heap_closest_index();
             } else if (!my_cached_indices.empty()) {
                 my_closest_cached_index = *(std::min_element(my_cached_indices.begin(), my_cached_indices.end()));
             }
@@ -331,6 +430,10 @@ public:
         return my_cache.size();
     }
 
+    bool uses_heap() const {
+        return my_cache.uses_heap();
+    }
+
 private:
     SecondaryExtractionCache<Index_, IndexServer_> my_cache;
 
@@ -364,6 +467,10 @@ public:
         return my_cache.size();
     }
 
+    bool uses_heap() const {
+        return my_cache.uses_heap();
+    }
+
 private:
     SecondaryExtractionCache<Index_, IndexServer_> my_cache;
     Index_ my_block_start;
@@ -399,6 +506,10 @@ public:
         return my_cache.size();
     }
 
+    bool uses_heap() const {
+        return my_cache.uses_heap();
+    }
+
 private:
     SecondaryExtractionCache<Index_, IndexServer_> my_cache;
     VectorPtr<Index_> my_indices_ptr;
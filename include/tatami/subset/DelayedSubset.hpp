@@ -3,6 +3,7 @@
 
 #include "utils.hpp"
 #include "../utils/Index_to_container.hpp"
+#include "../utils/gather.hpp"
 
 #include <algorithm>
 #include <memory>
@@ -116,7 +117,7 @@ private:
     ) {
         resize_container_to_Index_size(my_holding_vbuffer, processed.collapsed.size()); // processed.collapsed.size() should fit in an Index_, so this cast is safe.
         my_ext = new_extractor<false, oracle_>(matrix, row, std::move(oracle), std::move(processed.collapsed), opt);
-        my_reindex.swap(processed.reindex);
+        my_reindex = GatherIndices<Index_>(std::make_shared<const std::vector<Index_> >(std::move(processed.reindex)));
     }
 
 public:
@@ -124,19 +125,13 @@ public:
         const auto src = my_ext->fetch(i, my_holding_vbuffer.data());
 
         // 'src' and 'buffer' should not point to the same array.
-        auto copy = buffer;
-        for (auto p : my_reindex) {
-            *copy= src[p];
-            ++copy;
-        }
-
-        return buffer;
+        return my_reindex.gather(src, buffer);
     }
 
 private:
     std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > my_ext;
     std::vector<Value_> my_holding_vbuffer;
-    std::vector<Index_> my_reindex;
+    GatherIndices<Index_> my_reindex;
 };
 
 template<typename Index_>
@@ -226,7 +221,7 @@ public:
         const Options& opt
     ) {
         auto processed = format_sparse_parallel_base<Index_>(subset, subset.size(), [](const Index_ i) -> Index_ { return i; });
-        initialize(mat, std::move(processed), subset.size(), row, std::move(oracle), opt);
+        initialize(mat, std::move(processed), subset.size(), 0, subset.size(), row, std::move(oracle), opt);
     }
 
     template<class SubsetStorage_>
@@ -240,7 +235,7 @@ public:
         const Options& opt
     ) {
         auto processed = format_sparse_parallel_base<Index_>(subset, block_length, [&](const Index_ i) -> Index_ { return i + block_start; });
-        initialize(mat, std::move(processed), block_length, row, std::move(oracle), opt);
+        initialize(mat, std::move(processed), block_length, block_start, block_start + block_length, row, std::move(oracle), opt);
     }
 
     template<class SubsetStorage_>
@@ -254,7 +249,11 @@ public:
     ) {
         const auto& indices = *indices_ptr;
         auto processed = format_sparse_parallel_base<Index_>(subset, indices.size(), [&](const Index_ i) -> Index_ { return indices[i]; });
-        initialize(mat, std::move(processed), indices.size(), row, std::move(oracle), opt);
+        if (indices.empty()) {
+            initialize(mat, std::move(processed), 0, 0, 0, row, std::move(oracle), opt);
+        } else {
+            initialize(mat, std::move(processed), indices.size(), indices.front(), indices.back() + 1, row, std::move(oracle), opt);
+        }
     }
 
 private:
@@ -262,6 +261,8 @@ private:
         const Matrix<Value_, Index_>& mat,
         SparseParallelResults<Index_> processed,
         const Index_ extent,
+        const Index_ first_position,
+        const Index_ past_last_position,
         const bool row,
         MaybeOracle<oracle_, Index_> oracle,
         Options opt
@@ -273,9 +274,14 @@ private:
         my_needs_index = opt.sparse_extract_index;
         my_needs_sort = opt.sparse_ordered_index;
 
-        if (my_needs_sort && my_needs_value) {
-            my_sortspace.reserve(extent);
-        } 
+        if (my_needs_sort) {
+            if (my_needs_value) {
+                my_sortspace.reserve(extent);
+            }
+            if (my_needs_value || my_needs_index) {
+                my_scan = subset_utils::ScanSorter<Value_, Index_>(first_position, past_last_position, my_needs_value);
+            }
+        }
 
         // We need to extract indices for sorting and expansion purposes, even if they weren't actually requested.
         opt.sparse_extract_index = true;
@@ -342,6 +348,27 @@ public:
                 input.index = NULL;
             }
 
+        } else if (my_needs_value && my_scan.preferred(input.number)) {
+            // Same as below, but using a linear scan instead of a sort. Again,
+            // all of 'input' is copied into 'my_scan' before being copied back
+            // into the buffers, so overlaps are not a concern. 
+            Index_ count = 0;
+            for (Index_ i = 0; i < input.number; ++i) {
+                const auto val = input.value[i];
+                const auto lookup = input.index[i] - my_reindex.offset;
+                const auto start = my_reindex.pool_ptrs[lookup];
+                const auto end = my_reindex.pool_ptrs[lookup + 1];
+                for (Index_ j = start; j < end; ++j) {
+                    my_scan.add(my_reindex.pool_indices[j], val);
+                }
+                count += end - start;
+            }
+
+            my_scan.emit(vbuffer, (my_needs_index ? ibuffer : NULL));
+            input.number = count;
+            input.value = vbuffer;
+            input.index = (my_needs_index ? ibuffer : NULL);
+
         } else if (my_needs_value) {
             // This does not require any careful consideration of the overlaps
             // between 'input' and 'buffers', as we're copying things into
@@ -377,6 +404,22 @@ public:
                 input.index = NULL;
             }
 
+        } else if (my_needs_index && my_scan.preferred(input.number)) {
+            Index_ count = 0;
+            for (Index_ i = 0; i < input.number; ++i) {
+                const auto lookup = input.index[i] - my_reindex.offset;
+                const auto start = my_reindex.pool_ptrs[lookup];
+                const auto end = my_reindex.pool_ptrs[lookup + 1];
+                for (Index_ j = start; j < end; ++j) {
+                    my_scan.add(my_reindex.pool_indices[j]);
+                }
+                count += end - start;
+            }
+
+            my_scan.emit(NULL, ibuffer);
+            input.number = count;
+            input.index = ibuffer;
+
         } else {
             // Again, 'input.index' and 'ibuffer' may point to overlapping arrays,
             // as long as the latter precedes the former; expansion into the latter
@@ -414,6 +457,7 @@ private:
     bool my_needs_value, my_needs_index, my_needs_sort;
     SparseParallelReindex<Index_> my_reindex;
     std::vector<std::pair<Index_, Value_> > my_sortspace;
+    subset_utils::ScanSorter<Value_, Index_> my_scan;
     std::vector<Index_> my_holding_ibuffer;
     Index_ my_shift;
 };
@@ -435,7 +479,7 @@ private:
  * Any class implementing `[`, `size()`, `begin()` and `end()` can be used here.
  */
 template<typename Value_, typename Index_, class SubsetStorage_>
-class DelayedSubset final : public Matrix<Value_, Index_> {
+class DelayedSubset final : public Matrix<Value_, Index_>, public subset_utils::Collapsible<Value_, Index_> {
 public:
     /**
      * @param matrix Pointer to the underlying (pre-subset) matrix.
@@ -462,6 +506,25 @@ private:
     SubsetStorage_ my_subset;
     bool my_by_row;
 
+    /**
+     * @cond
+     */
+public:
+    const std::shared_ptr<const Matrix<Value_, Index_> >& underlying_matrix() const {
+        return my_matrix;
+    }
+
+    bool subset_by_row() const {
+        return my_by_row;
+    }
+
+    Index_ subset_index(const Index_ i) const {
+        return my_subset[i];
+    }
+    /**
+     * @endcond
+     */
+
 public:
     Index_ nrow() const {
         if (my_by_row) {
@@ -621,6 +684,7 @@ private:
             return std::make_unique<subset_utils::OracularPerpendicularDense<Value_, Index_> >(
                 *my_matrix,
                 my_subset,
+                subset_utils::SubsetStructure<Index_>(),
                 row,
                 std::move(oracle),
                 std::forward<Args_>(args)...
@@ -678,6 +742,7 @@ private:
             return std::make_unique<subset_utils::OracularPerpendicularSparse<Value_, Index_> >(
                 *my_matrix,
                 my_subset,
+                subset_utils::SubsetStructure<Index_>(),
                 row,
                 std::move(oracle),
                 std::forward<Args_>(args)...
@@ -0,0 +1,318 @@
+#ifndef TATAMI_DELAYED_SUBSET_2D_HPP
+#define TATAMI_DELAYED_SUBSET_2D_HPP
+
+#include "../base/Matrix.hpp"
+#include "make_DelayedSubset.hpp"
+#include "utils.hpp"
+
+#include <vector>
+#include <memory>
+
+#include "sanisizer/sanisizer.hpp"
+
+/**
+ * @file DelayedSubset2D.hpp
+ *
+ * @brief Delayed subsetting on both rows and columns.
+ */
+
+namespace tatami {
+
+/**
+ * @brief Delayed subsetting on both rows and columns.
+ *
+ * Implements delayed subsetting of a matrix on its rows and columns simultaneously.
+ * This operation is "delayed" in that it is only evaluated when data is extracted from the matrix.
+ *
+ * Each extractor passes the subset on the non-target dimension to the underlying matrix as a block or index selection,
+ * composed with any block or index selection requested by the caller.
+ * This is done with the same specialized classes as `make_DelayedSubset()`, e.g., a `DelayedSubsetBlock` if the column subset is a contiguous block.
+ * Thus, the underlying matrix only needs to extract the intersection of the requested rows and columns.
+ *
+ * `make_DelayedSubset()` will automatically create an instance of this class when subsetting a matrix that has already been subsetted on the other dimension,
+ * and will compose the indices when subsetting an existing instance of this class.
+ * This ensures that repeated subsetting does not increase the depth of the tree of delayed operations.
+ *
+ * @tparam Value_ Type of matrix value.
+ * @tparam Index_ Integer type for the row/column indices.
+ */
+template<typename Value_, typename Index_>
+class DelayedSubset2D final : public Matrix<Value_, Index_> {
+public:
+    /**
+     * @param matrix Pointer to the underlying (pre-subset) matrix.
+     * @param row_subset Vector of 0-based row indices to use for subsetting.
+     * These may be duplicated and/or unsorted.
+     * @param column_subset Vector of 0-based column indices to use for subsetting.
+     * These may be duplicated and/or unsorted.
+     */
+    DelayedSubset2D(
+        std::shared_ptr<const Matrix<Value_, Index_> > matrix,
+        std::vector<Index_> row_subset,
+        std::vector<Index_> column_subset
+    ) :
+        my_matrix(std::move(matrix)),
+        my_row_subset(std::move(row_subset)),
+        my_column_subset(std::move(column_subset))
+    {
+        // Check that we can still report the dimension extents of the subsetted matrix.
+        sanisizer::can_cast<Index_>(my_row_subset.size());
+        sanisizer::can_cast<Index_>(my_column_subset.size());
+
+        // Extraction of each row (or column) is performed from a view where the column (or row) subset has already been applied.
+        // The view's extractors are responsible for passing the subset to 'my_matrix' as a block or index selection.
+        MakeDelayedSubsetOptions mopt;
+        mopt.collapse = false;
+        my_row_view = make_DelayedSubset<Value_, Index_>(my_matrix, my_column_subset, false, mopt);
+        my_column_view = make_DelayedSubset<Value_, Index_>(my_matrix, my_row_subset, true, mopt);
+
+        // Precomputing the structure of each subset so that oracles on the target dimension can report it to the underlying matrix.
+        my_row_structure = subset_utils::compute_subset_structure(my_row_subset, my_matrix->nrow());
+        my_column_structure = subset_utils::compute_subset_structure(my_column_subset, my_matrix->ncol());
+    }
+
+private:
+    std::shared_ptr<const Matrix<Value_, Index_> > my_matrix;
+    std::vector<Index_> my_row_subset, my_column_subset;
+    std::shared_ptr<const Matrix<Value_, Index_> > my_row_view, my_column_view;
+    subset_utils::SubsetStructure<Index_> my_row_structure, my_column_structure;
+
+public:
+    /**
+     * @return Pointer to the underlying (pre-subset) matrix.
+     */
+    const std::shared_ptr<const Matrix<Value_, Index_> >& underlying_matrix() const {
+        return my_matrix;
+    }
+
+    /**
+     * @return Vector of row indices used for subsetting.
+     */
+    const std::vector<Index_>& row_subset() const {
+        return my_row_subset;
+    }
+
+    /**
+     * @return Vector of column indices used for subsetting.
+     */
+    const std::vector<Index_>& column_subset() const {
+        return my_column_subset;
+    }
+
+public:
+    Index_ nrow() const {
+        return my_row_subset.size();
+    }
+
+    Index_ ncol() const {
+        return my_column_subset.size();
+    }
+
+    bool is_sparse() const {
+        return my_matrix->is_sparse();
+    }
+
+    double is_sparse_proportion() const {
+        return my_matrix->is_sparse_proportion();
+    }
+
+    bool prefer_rows() const {
+        return my_matrix->prefer_rows();
+    }
+
+    double prefer_rows_proportion() const {
+        return my_matrix->prefer_rows_proportion();
+    }
+
+    bool uses_oracle(const bool row) const {
+        return my_matrix->uses_oracle(row);
+    }
+
+    using Matrix<Value_, Index_>::dense;
+
+    using Matrix<Value_, Index_>::sparse;
+
+    /********************
+     *** Myopic dense ***
+     ********************/
+private:
+    template<typename ... Args_>
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > populate_myopic_dense(
+        const bool row,
+        Args_&& ... args
+    ) const {
+        return std::make_unique<subset_utils::MyopicPerpendicularDense<Value_, Index_, std::vector<Index_> > >(
+            (row ? *my_row_view : *my_column_view),
+            (row ? my_row_subset : my_column_subset),
+            row,
+            std::forward<Args_>(args)...
+        );
+    }
+
+public:
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        const Options& opt
+    ) const {
+        return populate_myopic_dense(row, opt);
+    }
+
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return populate_myopic_dense(row, block_start, block_length, opt);
+    }
+
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return populate_myopic_dense(row, std::move(indices_ptr), opt);
+    }
+
+    /*********************
+     *** Myopic sparse ***
+     *********************/
+private:
+    template<typename ... Args_>
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > populate_myopic_sparse(
+        const bool row,
+        Args_&& ... args
+    ) const {
+        return std::make_unique<subset_utils::MyopicPerpendicularSparse<Value_, Index_, std::vector<Index_> > >(
+            (row ? *my_row_view : *my_column_view),
+            (row ? my_row_subset : my_column_subset),
+            row,
+            std::forward<Args_>(args)...
+        );
+    }
+
+public:
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        const Options& opt
+    ) const {
+        return populate_myopic_sparse(row, opt);
+    }
+
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return populate_myopic_sparse(row, block_start, block_length, opt);
+    }
+
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return populate_myopic_sparse(row, std::move(indices_ptr), opt);
+    }
+
+    /**********************
+     *** Oracular dense ***
+     **********************/
+private:
+    template<typename ... Args_>
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > populate_oracular_dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        Args_&& ... args
+    ) const {
+        return std::make_unique<subset_utils::OracularPerpendicularDense<Value_, Index_> >(
+            (row ? *my_row_view : *my_column_view),
+            (row ? my_row_subset : my_column_subset),
+            (row ? my_row_structure : my_column_structure),
+            row,
+            std::move(oracle),
+            std::forward<Args_>(args)...
+        );
+    }
+
+public:
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Options& opt
+    ) const {
+        return populate_oracular_dense(row, std::move(oracle), opt);
+    }
+
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return populate_oracular_dense(row, std::move(oracle), block_start, block_length, opt);
+    }
+
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return populate_oracular_dense(row, std::move(oracle), std::move(indices_ptr), opt);
+    }
+
+    /***********************
+     *** Oracular sparse ***
+     ***********************/
+private:
+    template<typename ... Args_>
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > populate_oracular_sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        Args_&& ... args
+    ) const {
+        return std::make_unique<subset_utils::OracularPerpendicularSparse<Value_, Index_> >(
+            (row ? *my_row_view : *my_column_view),
+            (row ? my_row_subset : my_column_subset),
+            (row ? my_row_structure : my_column_structure),
+            row,
+            std::move(oracle),
+            std::forward<Args_>(args)...
+        );
+    }
+
+public:
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Options& opt
+    ) const {
+        return populate_oracular_sparse(row, std::move(oracle), opt);
+    }
+
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return populate_oracular_sparse(row, std::move(oracle), block_start, block_length, opt);
+    }
+
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return populate_oracular_sparse(row, std::move(oracle), std::move(indices_ptr), opt);
+    }
+};
+
+}
+
+#endif
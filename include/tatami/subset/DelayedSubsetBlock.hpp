@@ -3,6 +3,7 @@
 
 #include "../base/Matrix.hpp"
 #include "../utils/new_extractor.hpp"
+#include "utils.hpp"
 
 #include <vector>
 #include <algorithm>
@@ -151,7 +152,9 @@ public:
     ) :
         my_oracle(std::move(oracle)),
         my_shift(shift)
-    {}
+    {
+        this->set_max_lookahead(my_oracle->max_lookahead());
+    }
 
     PredictionIndex total() const {
         return my_oracle->total();
@@ -161,6 +164,30 @@ public:
         return my_oracle->get(i) + my_shift;
     }
 
+    const Index_* span(const PredictionIndex start, const PredictionIndex number, Index_* const buffer) const {
+        const auto ptr = my_oracle->span(start, number, buffer);
+        for (PredictionIndex i = 0; i < number; ++i) {
+            buffer[i] = ptr[i] + my_shift;
+        }
+        return buffer;
+    }
+
+    bool is_consecutive() const {
+        return my_oracle->is_consecutive();
+    }
+
+    bool is_strided() const {
+        return my_oracle->is_strided();
+    }
+
+    Index_ stride() const {
+        return my_oracle->stride();
+    }
+
+    bool is_increasing() const {
+        return my_oracle->is_increasing();
+    }
+
 private:
     std::shared_ptr<const Oracle<Index_> > my_oracle;
     Index_ my_shift;
@@ -238,7 +265,7 @@ private:
  * @tparam Index_ Integer type for the row/column indices.
  */
 template<typename Value_, typename Index_>
-class DelayedSubsetBlock final : public Matrix<Value_, Index_> {
+class DelayedSubsetBlock final : public Matrix<Value_, Index_>, public subset_utils::Collapsible<Value_, Index_> {
 public:
     /**
      * @param matrix Pointer to the underlying (pre-subset) matrix.
@@ -264,6 +291,25 @@ private:
     Index_ my_subset_start, my_subset_length;
     bool my_by_row;
 
+    /**
+     * @cond
+     */
+public:
+    const std::shared_ptr<const Matrix<Value_, Index_> >& underlying_matrix() const {
+        return my_matrix;
+    }
+
+    bool subset_by_row() const {
+        return my_by_row;
+    }
+
+    Index_ subset_index(const Index_ i) const {
+        return my_subset_start + i;
+    }
+    /**
+     * @endcond
+     */
+
 public:
     Index_ nrow() const {
         if (my_by_row) {
@@ -0,0 +1,607 @@
+#ifndef TATAMI_DELAYED_SUBSET_MULTI_BLOCK_HPP
+#define TATAMI_DELAYED_SUBSET_MULTI_BLOCK_HPP
+
+#include "../base/Matrix.hpp"
+#include "../utils/new_extractor.hpp"
+#include "../utils/copy.hpp"
+#include "utils.hpp"
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @file DelayedSubsetMultiBlock.hpp
+ *
+ * @brief Delayed subsetting to multiple contiguous blocks of rows/columns.
+ *
+ * This is a specialized implementation that is more efficient than the `tatami::DelayedSubset` class.
+ */
+
+namespace tatami {
+
+/**
+ * @cond
+ */
+namespace DelayedSubsetMultiBlock_internal {
+
+// Portion of a block that overlaps with the requested interval of the subset.
+template<typename Index_>
+struct Piece {
+    Piece(const Index_ start, const Index_ length, const Index_ offset) : start(start), length(length), offset(offset) {}
+    Index_ start; // on the underlying matrix.
+    Index_ length;
+    Index_ offset; // on the subsetted dimension.
+};
+
+template<typename Index_>
+std::vector<Piece<Index_> > create_pieces(
+    const std::vector<Index_>& starts,
+    const std::vector<Index_>& cumulative,
+    const Index_ block_start,
+    const Index_ block_length
+) {
+    std::vector<Piece<Index_> > output;
+    if (block_length == 0) {
+        return output;
+    }
+
+    const Index_ block_end = block_start + block_length;
+    const auto nblocks = starts.size();
+    auto b = (std::upper_bound(cumulative.begin(), cumulative.end(), block_start) - cumulative.begin()) - 1; // cumulative[0] = 0 so this is always non-negative.
+    for (; static_cast<std::size_t>(b) < nblocks && cumulative[b] < block_end; ++b) {
+        const Index_ lower = std::max(cumulative[b], block_start);
+        const Index_ upper = std::min(cumulative[b + 1], block_end);
+        if (lower < upper) {
+            output.emplace_back(starts[b] + (lower - cumulative[b]), upper - lower, lower);
+        }
+    }
+
+    return output;
+}
+
+template<bool oracle_, typename Value_, typename Index_>
+class ParallelDense final : public DenseExtractor<oracle_, Value_, Index_> {
+public:
+    ParallelDense(
+        const Matrix<Value_, Index_>& matrix,
+        std::vector<Piece<Index_> > pieces,
+        const Index_ block_start,
+        const bool row,
+        MaybeOracle<oracle_, Index_> oracle,
+        const Options& opt
+    ) :
+        my_pieces(std::move(pieces))
+    {
+        my_exts.reserve(my_pieces.size());
+        for (auto& p : my_pieces) {
+            my_exts.emplace_back(new_extractor<false, oracle_>(matrix, row, oracle, p.start, p.length, opt));
+            p.offset -= block_start;
+        }
+    }
+
+    const Value_* fetch(const Index_ i, Value_* const buffer) {
+        const auto npieces = my_pieces.size();
+        for (I<decltype(npieces)> p = 0; p < npieces; ++p) {
+            const auto& current = my_pieces[p];
+            const auto output = buffer + current.offset;
+            const auto ptr = my_exts[p]->fetch(i, output);
+            copy_n(ptr, current.length, output);
+        }
+        return buffer;
+    }
+
+private:
+    std::vector<Piece<Index_> > my_pieces;
+    std::vector<std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > > my_exts;
+};
+
+template<bool oracle_, typename Value_, typename Index_>
+class ParallelSparse final : public SparseExtractor<oracle_, Value_, Index_> {
+public:
+    ParallelSparse(
+        const Matrix<Value_, Index_>& matrix,
+        std::vector<Piece<Index_> > pieces,
+        const bool row,
+        MaybeOracle<oracle_, Index_> oracle,
+        const Options& opt
+    ) :
+        my_pieces(std::move(pieces)),
+        my_needs_value(opt.sparse_extract_value),
+        my_needs_index(opt.sparse_extract_index)
+    {
+        my_exts.reserve(my_pieces.size());
+        for (const auto& p : my_pieces) {
+            my_exts.emplace_back(new_extractor<true, oracle_>(matrix, row, oracle, p.start, p.length, opt));
+        }
+    }
+
+    SparseRange<Value_, Index_> fetch(const Index_ i, Value_* const value_buffer, Index_* const index_buffer) {
+        auto vcopy = value_buffer;
+        auto icopy = index_buffer;
+        Index_ accumulated = 0;
+
+        const auto npieces = my_pieces.size();
+        for (I<decltype(npieces)> p = 0; p < npieces; ++p) {
+            const auto range = my_exts[p]->fetch(i, vcopy, icopy);
+            accumulated += range.number;
+            if (my_needs_value) {
+                copy_n(range.value, range.number, vcopy);
+                vcopy += range.number;
+            }
+            if (my_needs_index) {
+                const auto& current = my_pieces[p];
+                for (Index_ y = 0; y < range.number; ++y) {
+                    icopy[y] = range.index[y] - current.start + current.offset;
+                }
+                icopy += range.number;
+            }
+        }
+
+        return SparseRange<Value_, Index_>(accumulated, (my_needs_value ? value_buffer : NULL), (my_needs_index ? index_buffer : NULL));
+    }
+
+private:
+    std::vector<Piece<Index_> > my_pieces;
+    bool my_needs_value, my_needs_index;
+    std::vector<std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > > my_exts;
+};
+
+template<typename Index_>
+VectorPtr<Index_> create_indices(const std::vector<Index_>& mapping, const VectorPtr<Index_>& indices_ptr) {
+    auto output = std::make_shared<std::vector<Index_> >();
+    output->reserve(indices_ptr->size());
+    for (auto i : *indices_ptr) {
+        output->push_back(mapping[i]);
+    }
+    return output;
+}
+
+template<bool oracle_, typename Value_, typename Index_>
+class ParallelIndexSparse final : public SparseExtractor<oracle_, Value_, Index_> {
+public:
+    ParallelIndexSparse(
+        const Matrix<Value_, Index_>& matrix,
+        const std::vector<Index_>& starts,
+        const std::vector<Index_>& cumulative,
+        const std::vector<Index_>& mapping,
+        const bool row,
+        MaybeOracle<oracle_, Index_> oracle,
+        const VectorPtr<Index_>& indices_ptr,
+        const Options& opt
+    ) :
+        my_ext(new_extractor<true, oracle_>(matrix, row, std::move(oracle), create_indices(mapping, indices_ptr), opt)),
+        my_starts(starts),
+        my_cumulative(cumulative)
+    {}
+
+    SparseRange<Value_, Index_> fetch(const Index_ i, Value_* const value_buffer, Index_* const index_buffer) {
+        auto out = my_ext->fetch(i, value_buffer, index_buffer);
+        if (out.index) {
+            for (Index_ j = 0; j < out.number; ++j) {
+                const auto original = out.index[j];
+                const auto b = (std::upper_bound(my_starts.begin(), my_starts.end(), original) - my_starts.begin()) - 1;
+                index_buffer[j] = original - my_starts[b] + my_cumulative[b];
+            }
+            out.index = index_buffer;
+        }
+        return out;
+    }
+
+private:
+    std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > my_ext;
+    const std::vector<Index_>& my_starts;
+    const std::vector<Index_>& my_cumulative;
+};
+
+}
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Delayed subsetting to multiple contiguous blocks.
+ *
+ * Implements delayed subsetting of a matrix to a set of non-overlapping contiguous blocks of rows or columns, e.g., after removing a few rows/columns from a matrix.
+ * This operation is "delayed" in that it is only evaluated when data is extracted from the matrix.
+ *
+ * When extracting along the non-subsetted dimension, this class requests each block separately from the underlying matrix,
+ * allowing backends to perform range reads instead of processing an arbitrary vector of indices.
+ * As a separate extractor is created for each block, this is most effective when there are only a few blocks.
+ *
+ * @tparam Value_ Type of matrix value.
+ * @tparam Index_ Integer type for the row/column indices.
+ */
+template<typename Value_, typename Index_>
+class DelayedSubsetMultiBlock final : public Matrix<Value_, Index_>, public subset_utils::Collapsible<Value_, Index_> {
+public:
+    /**
+     * @param matrix Pointer to the underlying (pre-subset) matrix.
+     * @param block_starts Vector containing the index of the first row (if `by_row = true`) or column (otherwise) of each block.
+     * @param block_lengths Vector of length equal to `block_starts`, containing the number of rows/columns in each block.
+     * Blocks should be sorted by their starts and should not overlap.
+     * @param by_row Whether to apply the subset to the rows.
+     * If false, the subset is applied to the columns.
+     */
+    DelayedSubsetMultiBlock(
+        std::shared_ptr<const Matrix<Value_, Index_> > matrix,
+        std::vector<Index_> block_starts,
+        std::vector<Index_> block_lengths,
+        const bool by_row
+    ) :
+        my_matrix(std::move(matrix)),
+        my_starts(std::move(block_starts)),
+        my_lengths(std::move(block_lengths)),
+        my_by_row(by_row)
+    {
+        const auto nblocks = my_starts.size();
+        if (nblocks != my_lengths.size()) {
+            throw std::runtime_error("'block_starts' and 'block_lengths' should have the same length");
+        }
+
+        const Index_ full = (my_by_row ? my_matrix->nrow() : my_matrix->ncol());
+        Index_ last_end = 0;
+        my_cumulative.reserve(nblocks + 1);
+        my_cumulative.push_back(0);
+        for (I<decltype(nblocks)> b = 0; b < nblocks; ++b) {
+            const auto start = my_starts[b], length = my_lengths[b];
+            if (start < last_end) {
+                throw std::runtime_error("blocks should be sorted and non-overlapping");
+            }
+            if (start > full || length > full - start) {
+                throw std::runtime_error("blocks should lie within the matrix");
+            }
+            last_end = start + length;
+            my_cumulative.push_back(my_cumulative.back() + length);
+        }
+
+        my_mapping.reserve(my_cumulative.back());
+        for (I<decltype(nblocks)> b = 0; b < nblocks; ++b) {
+            const auto start = my_starts[b], length = my_lengths[b];
+            for (Index_ j = 0; j < length; ++j) {
+                my_mapping.push_back(start + j);
+            }
+        }
+
+        // The mapping is always sorted and unique, but we still need to check whether it happens to be strided.
+        my_structure = subset_utils::compute_subset_structure(my_mapping, full);
+    }
+
+private:
+    std::shared_ptr<const Matrix<Value_, Index_> > my_matrix;
+    std::vector<Index_> my_starts, my_lengths;
+    bool my_by_row;
+    std::vector<Index_> my_cumulative;
+    std::vector<Index_> my_mapping;
+    subset_utils::SubsetStructure<Index_> my_structure;
+
+    /**
+     * @cond
+     */
+public:
+    const std::shared_ptr<const Matrix<Value_, Index_> >& underlying_matrix() const {
+        return my_matrix;
+    }
+
+    bool subset_by_row() const {
+        return my_by_row;
+    }
+
+    Index_ subset_index(const Index_ i) const {
+        return my_mapping[i];
+    }
+    /**
+     * @endcond
+     */
+
+public:
+    Index_ nrow() const {
+        if (my_by_row) {
+            return my_cumulative.back();
+        } else {
+            return my_matrix->nrow();
+        }
+    }
+
+    Index_ ncol() const {
+        if (my_by_row) {
+            return my_matrix->ncol();
+        } else {
+            return my_cumulative.back();
+        }
+    }
+
+    bool is_sparse() const {
+        return my_matrix->is_sparse();
+    }
+
+    double is_sparse_proportion() const {
+        return my_matrix->is_sparse_proportion();
+    }
+
+    bool prefer_rows() const {
+        return my_matrix->prefer_rows();
+    }
+
+    double prefer_rows_proportion() const {
+        return my_matrix->prefer_rows_proportion();
+    }
+
+    bool uses_oracle(const bool row) const {
+        return my_matrix->uses_oracle(row);
+    }
+
+    using Matrix<Value_, Index_>::dense;
+
+    using Matrix<Value_, Index_>::sparse;
+
+    /***************************
+     *** Parallel extractors ***
+     ***************************/
+private:
+    template<bool oracle_>
+    std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > create_parallel_dense(const bool row, MaybeOracle<oracle_, Index_> oracle, const Options& opt) const {
+        return create_parallel_dense<oracle_>(row, std::move(oracle), 0, my_cumulative.back(), opt);
+    }
+
+    template<bool oracle_>
+    std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > create_parallel_dense(
+        const bool row,
+        MaybeOracle<oracle_, Index_> oracle,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return std::make_unique<DelayedSubsetMultiBlock_internal::ParallelDense<oracle_, Value_, Index_> >(
+            *my_matrix,
+            DelayedSubsetMultiBlock_internal::create_pieces(my_starts, my_cumulative, block_start, block_length),
+            block_start,
+            row,
+            std::move(oracle),
+            opt
+        );
+    }
+
+    template<bool oracle_>
+    std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > create_parallel_dense(const bool row, MaybeOracle<oracle_, Index_> oracle, VectorPtr<Index_> indices_ptr, const Options& opt) const {
+        // Arbitrary indices don't form contiguous blocks, so we just forward them to the underlying matrix.
+        return new_extractor<false, oracle_>(*my_matrix, row, std::move(oracle), DelayedSubsetMultiBlock_internal::create_indices(my_mapping, indices_ptr), opt);
+    }
+
+    template<bool oracle_>
+    std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > create_parallel_sparse(const bool row, MaybeOracle<oracle_, Index_> oracle, const Options& opt) const {
+        return create_parallel_sparse<oracle_>(row, std::move(oracle), 0, my_cumulative.back(), opt);
+    }
+
+    template<bool oracle_>
+    std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > create_parallel_sparse(
+        const bool row,
+        MaybeOracle<oracle_, Index_> oracle,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return std::make_unique<DelayedSubsetMultiBlock_internal::ParallelSparse<oracle_, Value_, Index_> >(
+            *my_matrix,
+            DelayedSubsetMultiBlock_internal::create_pieces(my_starts, my_cumulative, block_start, block_length),
+            row,
+            std::move(oracle),
+            opt
+        );
+    }
+
+    template<bool oracle_>
+    std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > create_parallel_sparse(const bool row, MaybeOracle<oracle_, Index_> oracle, VectorPtr<Index_> indices_ptr, const Options& opt) const {
+        return std::make_unique<DelayedSubsetMultiBlock_internal::ParallelIndexSparse<oracle_, Value_, Index_> >(
+            *my_matrix,
+            my_starts,
+            my_cumulative,
+            my_mapping,
+            row,
+            std::move(oracle),
+            indices_ptr,
+            opt
+        );
+    }
+
+    /********************
+     *** Myopic dense ***
+     ********************/
+private:
+    template<typename ... Args_>
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > populate_myopic_dense(
+        const bool row,
+        Args_&& ... args
+    ) const {
+        if (row == my_by_row) {
+            return std::make_unique<subset_utils::MyopicPerpendicularDense<Value_, Index_, std::vector<Index_> > >(
+                *my_matrix,
+                my_mapping,
+                row,
+                std::forward<Args_>(args)...
+            );
+        } else {
+            return create_parallel_dense<false>(row, false, std::forward<Args_>(args)...);
+        }
+    }
+
+public:
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        const Options& opt
+    ) const {
+        return populate_myopic_dense(row, opt);
+    }
+
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return populate_myopic_dense(row, block_start, block_length, opt);
+    }
+
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return populate_myopic_dense(row, std::move(indices_ptr), opt);
+    }
+
+    /*********************
+     *** Myopic sparse ***
+     *********************/
+private:
+    template<typename ... Args_>
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > populate_myopic_sparse(
+        const bool row,
+        Args_&& ... args
+    ) const {
+        if (row == my_by_row) {
+            return std::make_unique<subset_utils::MyopicPerpendicularSparse<Value_, Index_, std::vector<Index_> > >(
+                *my_matrix,
+                my_mapping,
+                row,
+                std::forward<Args_>(args)...
+            );
+        } else {
+            return create_parallel_sparse<false>(row, false, std::forward<Args_>(args)...);
+        }
+    }
+
+public:
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        const Options& opt
+    ) const {
+        return populate_myopic_sparse(row, opt);
+    }
+
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return populate_myopic_sparse(row, block_start, block_length, opt);
+    }
+
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return populate_myopic_sparse(row, std::move(indices_ptr), opt);
+    }
+
+    /**********************
+     *** Oracular dense ***
+     **********************/
+private:
+    template<typename ... Args_>
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > populate_oracular_dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        Args_&& ... args
+    ) const {
+        if (row == my_by_row) {
+            return std::make_unique<subset_utils::OracularPerpendicularDense<Value_, Index_> >(
+                *my_matrix,
+                my_mapping,
+                my_structure,
+                row,
+                std::move(oracle),
+                std::forward<Args_>(args)...
+            );
+        } else {
+            return create_parallel_dense<true>(row, std::move(oracle), std::forward<Args_>(args)...);
+        }
+    }
+
+public:
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Options& opt
+    ) const {
+        return populate_oracular_dense(row, std::move(oracle), opt);
+    }
+
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return populate_oracular_dense(row, std::move(oracle), block_start, block_length, opt);
+    }
+
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return populate_oracular_dense(row, std::move(oracle), std::move(indices_ptr), opt);
+    }
+
+    /***********************
+     *** Oracular sparse ***
+     ***********************/
+private:
+    template<typename ... Args_>
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > populate_oracular_sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        Args_&& ... args
+    ) const {
+        if (row == my_by_row) {
+            return std::make_unique<subset_utils::OracularPerpendicularSparse<Value_, Index_> >(
+                *my_matrix,
+                my_mapping,
+                my_structure,
+                row,
+                std::move(oracle),
+                std::forward<Args_>(args)...
+            );
+        } else {
+            return create_parallel_sparse<true>(row, std::move(oracle), std::forward<Args_>(args)...);
+        }
+    }
+
+public:
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Options& opt
+    ) const {
+        return populate_oracular_sparse(row, std::move(oracle), opt);
+    }
+
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return populate_oracular_sparse(row, std::move(oracle), block_start, block_length, opt);
+    }
+
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return populate_oracular_sparse(row, std::move(oracle), std::move(indices_ptr), opt);
+    }
+};
+
+}
+
+#endif
@@ -410,7 +410,7 @@ private:
  * Any class implementing `[`, `size()`, `begin()` and `end()` can be used here.
  */
 template<typename Value_, typename Index_, class SubsetStorage_>
-class DelayedSubsetSorted final : public Matrix<Value_, Index_> {
+class DelayedSubsetSorted final : public Matrix<Value_, Index_>, public subset_utils::Collapsible<Value_, Index_> {
 public:
     /**
      * @param matrix Pointer to the underlying (pre-subset) matrix.
@@ -456,6 +456,25 @@ private:
         }
     }
 
+    /**
+     * @cond
+     */
+public:
+    const std::shared_ptr<const Matrix<Value_, Index_> >& underlying_matrix() const {
+        return my_matrix;
+    }
+
+    bool subset_by_row() const {
+        return my_by_row;
+    }
+
+    Index_ subset_index(const Index_ i) const {
+        return my_subset[i];
+    }
+    /**
+     * @endcond
+     */
+
 public:
     Index_ nrow() const {
         if (my_by_row) {
@@ -646,6 +665,7 @@ private:
             return std::make_unique<subset_utils::OracularPerpendicularDense<Value_, Index_> >(
                 *my_matrix,
                 my_subset,
+                subset_utils::SubsetStructure<Index_>{ true, false, 0 },
                 row,
                 std::move(oracle),
                 std::forward<Args_>(args)...
@@ -703,6 +723,7 @@ private:
             return std::make_unique<subset_utils::OracularPerpendicularSparse<Value_, Index_> >(
                 *my_matrix,
                 my_subset,
+                subset_utils::SubsetStructure<Index_>{ true, false, 0 },
                 row,
                 std::move(oracle),
                 std::forward<Args_>(args)...
@@ -161,7 +161,7 @@ private:
  * @tparam SubsetStorage_ Vector containing the subset indices.
  */
 template<typename Value_, typename Index_, class SubsetStorage_>
-class DelayedSubsetSortedUnique final : public Matrix<Value_, Index_> {
+class DelayedSubsetSortedUnique final : public Matrix<Value_, Index_>, public subset_utils::Collapsible<Value_, Index_> {
 public:
     /**
      * @param matrix Pointer to the underlying (pre-subset) matrix.
@@ -203,6 +203,25 @@ private:
     bool my_by_row;
     std::vector<Index_> my_mapping_single;
 
+    /**
+     * @cond
+     */
+public:
+    const std::shared_ptr<const Matrix<Value_, Index_> >& underlying_matrix() const {
+        return my_matrix;
+    }
+
+    bool subset_by_row() const {
+        return my_by_row;
+    }
+
+    Index_ subset_index(const Index_ i) const {
+        return my_subset[i];
+    }
+    /**
+     * @endcond
+     */
+
 public:
     Index_ nrow() const {
         if (my_by_row) {
@@ -363,6 +382,7 @@ private:
             return std::make_unique<subset_utils::OracularPerpendicularDense<Value_, Index_> >(
                 *my_matrix,
                 my_subset,
+                subset_utils::SubsetStructure<Index_>{ true, true, 0 },
                 row,
                 std::move(oracle),
                 std::forward<Args_>(args)...
@@ -420,6 +440,7 @@ private:
             return std::make_unique<subset_utils::OracularPerpendicularSparse<Value_, Index_> >(
                 *my_matrix,
                 my_subset,
+                subset_utils::SubsetStructure<Index_>{ true, true, 0 },
                 row,
                 std::move(oracle),
                 std::forward<Args_>(args)...
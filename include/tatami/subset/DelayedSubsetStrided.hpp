@@ -0,0 +1,600 @@
+#ifndef TATAMI_DELAYED_SUBSET_STRIDED_HPP
+#define TATAMI_DELAYED_SUBSET_STRIDED_HPP
+
+#include "../base/Matrix.hpp"
+#include "../utils/new_extractor.hpp"
+#include "../utils/Index_to_container.hpp"
+#include "utils.hpp"
+
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+/**
+ * @file DelayedSubsetStrided.hpp
+ *
+ * @brief Delayed subsetting to a strided sequence of rows/columns.
+ *
+ * This is a specialized implementation that is more efficient than the `tatami::DelayedSubset` class.
+ */
+
+namespace tatami {
+
+/**
+ * @cond
+ */
+namespace DelayedSubsetStrided_internal {
+
+template<typename Index_>
+struct StridedSubset {
+    StridedSubset(const Index_ start, const Index_ stride, const Index_ length) : start(start), stride(stride), length(length) {}
+    Index_ start, stride, length;
+
+    Index_ operator[](const Index_ i) const {
+        return start + stride * i;
+    }
+
+    Index_ size() const {
+        return length;
+    }
+};
+
+template<typename Index_>
+Index_ span(const Index_ stride, const Index_ length) {
+    return (length ? (length - 1) * stride + 1 : 0);
+}
+
+template<bool oracle_, typename Value_, typename Index_>
+class ParallelDense final : public DenseExtractor<oracle_, Value_, Index_> {
+public:
+    ParallelDense(
+        const Matrix<Value_, Index_>& matrix,
+        const Index_ first,
+        const Index_ stride,
+        const Index_ length,
+        const bool row,
+        MaybeOracle<oracle_, Index_> oracle,
+        const Options& opt
+    ) :
+        my_stride(stride),
+        my_length(length)
+    {
+        const Index_ extent = span(stride, length);
+        my_ext = new_extractor<false, oracle_>(matrix, row, std::move(oracle), first, extent, opt);
+        resize_container_to_Index_size(my_holding, extent);
+    }
+
+    const Value_* fetch(const Index_ i, Value_* const buffer) {
+        const auto ptr = my_ext->fetch(i, my_holding.data());
+        for (Index_ j = 0; j < my_length; ++j) {
+            buffer[j] = ptr[j * my_stride];
+        }
+        return buffer;
+    }
+
+private:
+    std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > my_ext;
+    Index_ my_stride, my_length;
+    std::vector<Value_> my_holding;
+};
+
+template<bool oracle_, typename Value_, typename Index_>
+class ParallelSparse final : public SparseExtractor<oracle_, Value_, Index_> {
+public:
+    ParallelSparse(
+        const Matrix<Value_, Index_>& matrix,
+        const Index_ first,
+        const Index_ stride,
+        const Index_ length,
+        const Index_ offset,
+        const bool row,
+        MaybeOracle<oracle_, Index_> oracle,
+        const Options& opt
+    ) :
+        my_first(first),
+        my_stride(stride),
+        my_offset(offset),
+        my_needs_value(opt.sparse_extract_value),
+        my_needs_index(opt.sparse_extract_index)
+    {
+        // We always need the indices to figure out which elements lie on the stride.
+        auto copy = opt;
+        copy.sparse_extract_index = true;
+
+        const Index_ extent = span(stride, length);
+        my_ext = new_extractor<true, oracle_>(matrix, row, std::move(oracle), first, extent, copy);
+        resize_container_to_Index_size(my_holding_index, extent);
+        if (my_needs_value) {
+            resize_container_to_Index_size(my_holding_value, extent);
+        }
+    }
+
+    SparseRange<Value_, Index_> fetch(const Index_ i, Value_* const value_buffer, Index_* const index_buffer) {
+        const auto range = my_ext->fetch(i, my_holding_value.data(), my_holding_index.data());
+        Index_ count = 0;
+        for (Index_ j = 0; j < range.number; ++j) {
+            const Index_ relative = range.index[j] - my_first;
+            if (relative % my_stride == 0) {
+                if (my_needs_value) {
+                    value_buffer[count] = range.value[j];
+                }
+                if (my_needs_index) {
+                    index_buffer[count] = relative / my_stride + my_offset;
+                }
+                ++count;
+            }
+        }
+        return SparseRange<Value_, Index_>(count, (my_needs_value ? value_buffer : NULL), (my_needs_index ? index_buffer : NULL));
+    }
+
+private:
+    std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > my_ext;
+    Index_ my_first, my_stride, my_offset;
+    bool my_needs_value, my_needs_index;
+    std::vector<Value_> my_holding_value;
+    std::vector<Index_> my_holding_index;
+};
+
+template<typename Index_>
+VectorPtr<Index_> create_indices(const StridedSubset<Index_>& subset, const VectorPtr<Index_>& indices_ptr) {
+    auto output = std::make_shared<std::vector<Index_> >();
+    output->reserve(indices_ptr->size());
+    for (auto i : *indices_ptr) {
+        output->push_back(subset[i]);
+    }
+    return output;
+}
+
+template<bool oracle_, typename Value_, typename Index_>
+class ParallelIndexSparse final : public SparseExtractor<oracle_, Value_, Index_> {
+public:
+    ParallelIndexSparse(
+        const Matrix<Value_, Index_>& matrix,
+        const StridedSubset<Index_>& subset,
+        const bool row,
+        MaybeOracle<oracle_, Index_> oracle,
+        const VectorPtr<Index_>& indices_ptr,
+        const Options& opt
+    ) :
+        my_ext(new_extractor<true, oracle_>(matrix, row, std::move(oracle), create_indices(subset, indices_ptr), opt)),
+        my_start(subset.start),
+        my_stride(subset.stride)
+    {}
+
+    SparseRange<Value_, Index_> fetch(const Index_ i, Value_* const value_buffer, Index_* const index_buffer) {
+        auto out = my_ext->fetch(i, value_buffer, index_buffer);
+        if (out.index) {
+            for (Index_ j = 0; j < out.number; ++j) {
+                index_buffer[j] = (out.index[j] - my_start) / my_stride;
+            }
+            out.index = index_buffer;
+        }
+        return out;
+    }
+
+private:
+    std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > my_ext;
+    Index_ my_start, my_stride;
+};
+
+template<bool oracle_, typename Value_, typename Index_>
+std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > create_parallel_dense(
+    const Matrix<Value_, Index_>& matrix,
+    const StridedSubset<Index_>& subset,
+    const bool row,
+    MaybeOracle<oracle_, Index_> oracle,
+    const Options& opt
+) {
+    // An empty subset might not have a valid start, so we use an empty block at zero instead.
+    return std::make_unique<ParallelDense<oracle_, Value_, Index_> >(matrix, (subset.length ? subset.start : 0), subset.stride, subset.length, row, std::move(oracle), opt);
+}
+
+template<bool oracle_, typename Value_, typename Index_>
+std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > create_parallel_dense(
+    const Matrix<Value_, Index_>& matrix,
+    const StridedSubset<Index_>& subset,
+    const bool row,
+    MaybeOracle<oracle_, Index_> oracle,
+    const Index_ block_start,
+    const Index_ block_length,
+    const Options& opt
+) {
+    // 'block_start' may be equal to the subset length for an empty block, in which case 'subset[block_start]' lies past the end of the subset.
+    return std::make_unique<ParallelDense<oracle_, Value_, Index_> >(matrix, (block_length ? subset[block_start] : 0), subset.stride, block_length, row, std::move(oracle), opt);
+}
+
+template<bool oracle_, typename Value_, typename Index_>
+std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > create_parallel_dense(
+    const Matrix<Value_, Index_>& matrix,
+    const StridedSubset<Index_>& subset,
+    const bool row,
+    MaybeOracle<oracle_, Index_> oracle,
+    VectorPtr<Index_> indices_ptr,
+    const Options& opt
+) {
+    // Arbitrary indices don't form a regular stride, so we just forward them to the underlying matrix.
+    return new_extractor<false, oracle_>(matrix, row, std::move(oracle), create_indices(subset, indices_ptr), opt);
+}
+
+template<bool oracle_, typename Value_, typename Index_>
+std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > create_parallel_sparse(
+    const Matrix<Value_, Index_>& matrix,
+    const StridedSubset<Index_>& subset,
+    const bool row,
+    MaybeOracle<oracle_, Index_> oracle,
+    const Options& opt
+) {
+    return std::make_unique<ParallelSparse<oracle_, Value_, Index_> >(matrix, (subset.length ? subset.start : 0), subset.stride, subset.length, 0, row, std::move(oracle), opt);
+}
+
+template<bool oracle_, typename Value_, typename Index_>
+std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > create_parallel_sparse(
+    const Matrix<Value_, Index_>& matrix,
+    const StridedSubset<Index_>& subset,
+    const bool row,
+    MaybeOracle<oracle_, Index_> oracle,
+    const Index_ block_start,
+    const Index_ block_length,
+    const Options& opt
+) {
+    return std::make_unique<ParallelSparse<oracle_, Value_, Index_> >(matrix, (block_length ? subset[block_start] : 0), subset.stride, block_length, block_start, row, std::move(oracle), opt);
+}
+
+template<bool oracle_, typename Value_, typename Index_>
+std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > create_parallel_sparse(
+    const Matrix<Value_, Index_>& matrix,
+    const StridedSubset<Index_>& subset,
+    const bool row,
+    MaybeOracle<oracle_, Index_> oracle,
+    VectorPtr<Index_> indices_ptr,
+    const Options& opt
+) {
+    return std::make_unique<ParallelIndexSparse<oracle_, Value_, Index_> >(matrix, subset, row, std::move(oracle), indices_ptr, opt);
+}
+
+}
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Delayed subsetting to a strided sequence.
+ *
+ * Implements delayed subsetting of a matrix to a strided sequence of rows or columns, i.e., every `stride`-th row/column starting from `start`.
+ * This operation is "delayed" in that it is only evaluated when data is extracted from the matrix.
+ *
+ * When extracting along the non-subsetted dimension, this class requests a contiguous block from the underlying matrix that spans the strided sequence,
+ * and then picks out the every `stride`-th element from the block.
+ * This allows backends to perform range reads instead of processing an arbitrary vector of indices.
+ * It is most effective for small strides where the cost of reading the intervening elements is negligible.
+ *
+ * @tparam Value_ Type of matrix value.
+ * @tparam Index_ Integer type for the row/column indices.
+ */
+template<typename Value_, typename Index_>
+class DelayedSubsetStrided final : public Matrix<Value_, Index_>, public subset_utils::Collapsible<Value_, Index_> {
+public:
+    /**
+     * @param matrix Pointer to the underlying (pre-subset) matrix.
+     * @param subset_start Index of the first row (if `by_row = true`) or column (otherwise) in the subset.
+     * This should be non-negative.
+     * @param subset_stride Distance between consecutive rows/columns in the subset.
+     * This should be positive.
+     * @param subset_length Number of rows/columns in the subset.
+     * @param by_row Whether to apply the subset to the rows.
+     * If false, the subset is applied to the columns.
+     */
+    DelayedSubsetStrided(
+        std::shared_ptr<const Matrix<Value_, Index_> > matrix,
+        const Index_ subset_start,
+        const Index_ subset_stride,
+        const Index_ subset_length,
+        const bool by_row
+    ) :
+        my_matrix(std::move(matrix)),
+        my_subset(subset_start, subset_stride, subset_length),
+        my_by_row(by_row)
+    {
+        if (subset_start < 0) {
+            throw std::runtime_error("start of the strided subset should be non-negative");
+        }
+        if (subset_stride <= 0) {
+            throw std::runtime_error("stride should be positive");
+        }
+        if (subset_length) {
+            const Index_ full = (my_by_row ? my_matrix->nrow() : my_matrix->ncol());
+            if (subset_start >= full || (full - 1 - subset_start) / subset_stride < subset_length - 1) {
+                throw std::runtime_error("strided subset should lie within the matrix");
+            }
+        }
+    }
+
+private:
+    std::shared_ptr<const Matrix<Value_, Index_> > my_matrix;
+    DelayedSubsetStrided_internal::StridedSubset<Index_> my_subset;
+    bool my_by_row;
+
+    /**
+     * @cond
+     */
+public:
+    const std::shared_ptr<const Matrix<Value_, Index_> >& underlying_matrix() const {
+        return my_matrix;
+    }
+
+    bool subset_by_row() const {
+        return my_by_row;
+    }
+
+    Index_ subset_index(const Index_ i) const {
+        return my_subset[i];
+    }
+    /**
+     * @endcond
+     */
+
+public:
+    Index_ nrow() const {
+        if (my_by_row) {
+            return my_subset.length;
+        } else {
+            return my_matrix->nrow();
+        }
+    }
+
+    Index_ ncol() const {
+        if (my_by_row) {
+            return my_matrix->ncol();
+        } else {
+            return my_subset.length;
+        }
+    }
+
+    bool is_sparse() const {
+        return my_matrix->is_sparse();
+    }
+
+    double is_sparse_proportion() const {
+        return my_matrix->is_sparse_proportion();
+    }
+
+    bool prefer_rows() const {
+        return my_matrix->prefer_rows();
+    }
+
+    double prefer_rows_proportion() const {
+        return my_matrix->prefer_rows_proportion();
+    }
+
+    bool uses_oracle(const bool row) const {
+        return my_matrix->uses_oracle(row);
+    }
+
+    using Matrix<Value_, Index_>::dense;
+
+    using Matrix<Value_, Index_>::sparse;
+
+    /********************
+     *** Myopic dense ***
+     ********************/
+private:
+    template<typename ... Args_>
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > populate_myopic_dense(
+        const bool row,
+        Args_&& ... args
+    ) const {
+        if (row == my_by_row) {
+            return std::make_unique<subset_utils::MyopicPerpendicularDense<Value_, Index_, I<decltype(my_subset)> > >(
+                *my_matrix,
+                my_subset,
+                row,
+                std::forward<Args_>(args)...
+            );
+        } else {
+            return DelayedSubsetStrided_internal::create_parallel_dense<false>(
+                *my_matrix,
+                my_subset,
+                row,
+                false,
+                std::forward<Args_>(args)...
+            );
+        }
+    }
+
+public:
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        const Options& opt
+    ) const {
+        return populate_myopic_dense(row, opt);
+    }
+
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return populate_myopic_dense(row, block_start, block_length, opt);
+    }
+
+    std::unique_ptr<MyopicDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return populate_myopic_dense(row, std::move(indices_ptr), opt);
+    }
+
+    /*********************
+     *** Myopic sparse ***
+     *********************/
+private:
+    template<typename ... Args_>
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > populate_myopic_sparse(
+        const bool row,
+        Args_&& ... args
+    ) const {
+        if (row == my_by_row) {
+            return std::make_unique<subset_utils::MyopicPerpendicularSparse<Value_, Index_, I<decltype(my_subset)> > >(
+                *my_matrix,
+                my_subset,
+                row,
+                std::forward<Args_>(args)...
+            );
+        } else {
+            return DelayedSubsetStrided_internal::create_parallel_sparse<false>(
+                *my_matrix,
+                my_subset,
+                row,
+                false,
+                std::forward<Args_>(args)...
+            );
+        }
+    }
+
+public:
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        const Options& opt
+    ) const {
+        return populate_myopic_sparse(row, opt);
+    }
+
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return populate_myopic_sparse(row, block_start, block_length, opt);
+    }
+
+    std::unique_ptr<MyopicSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return populate_myopic_sparse(row, std::move(indices_ptr), opt);
+    }
+
+    /**********************
+     *** Oracular dense ***
+     **********************/
+private:
+    template<typename ... Args_>
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > populate_oracular_dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        Args_&& ... args
+    ) const {
+        if (row == my_by_row) {
+            return std::make_unique<subset_utils::OracularPerpendicularDense<Value_, Index_> >(
+                *my_matrix,
+                my_subset,
+                subset_utils::SubsetStructure<Index_>{ true, true, my_subset.stride },
+                row,
+                std::move(oracle),
+                std::forward<Args_>(args)...
+            );
+        } else {
+            return DelayedSubsetStrided_internal::create_parallel_dense<true>(
+                *my_matrix,
+                my_subset,
+                row,
+                std::move(oracle),
+                std::forward<Args_>(args)...
+            );
+        }
+    }
+
+public:
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Options& opt
+    ) const {
+        return populate_oracular_dense(row, std::move(oracle), opt);
+    }
+
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return populate_oracular_dense(row, std::move(oracle), block_start, block_length, opt);
+    }
+
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > dense(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return populate_oracular_dense(row, std::move(oracle), std::move(indices_ptr), opt);
+    }
+
+    /***********************
+     *** Oracular sparse ***
+     ***********************/
+private:
+    template<typename ... Args_>
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > populate_oracular_sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        Args_&& ... args
+    ) const {
+        if (row == my_by_row) {
+            return std::make_unique<subset_utils::OracularPerpendicularSparse<Value_, Index_> >(
+                *my_matrix,
+                my_subset,
+                subset_utils::SubsetStructure<Index_>{ true, true, my_subset.stride },
+                row,
+                std::move(oracle),
+                std::forward<Args_>(args)...
+            );
+        } else {
+            return DelayedSubsetStrided_internal::create_parallel_sparse<true>(
+                *my_matrix,
+                my_subset,
+                row,
+                std::move(oracle),
+                std::forward<Args_>(args)...
+            );
+        }
+    }
+
+public:
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Options& opt
+    ) const {
+        return populate_oracular_sparse(row, std::move(oracle), opt);
+    }
+
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        const Index_ block_start,
+        const Index_ block_length,
+        const Options& opt
+    ) const {
+        return populate_oracular_sparse(row, std::move(oracle), block_start, block_length, opt);
+    }
+
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > sparse(
+        const bool row,
+        std::shared_ptr<const Oracle<Index_> > oracle,
+        VectorPtr<Index_> indices_ptr,
+        const Options& opt
+    ) const {
+        return populate_oracular_sparse(row, std::move(oracle), std::move(indices_ptr), opt);
+    }
+};
+
+}
+
+#endif
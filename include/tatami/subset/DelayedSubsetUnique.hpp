@@ -4,6 +4,8 @@
 #include "utils.hpp"
 #include "../base/Matrix.hpp"
 #include "../utils/copy.hpp"
+#include "../utils/gather.hpp"
+#include "../utils/Index_to_container.hpp"
 
 #include <algorithm>
 #include <numeric>
@@ -25,7 +27,7 @@ namespace DelayedSubsetUnique_internal {
 template<typename Index_>
 struct DenseParallelResults {
     std::vector<Index_> sorted;
-    std::vector<Index_> permutation;
+    std::vector<Index_> reindex;
 };
 
 template<typename Index_, class SubsetStorage_, class ToIndex_>
@@ -39,10 +41,11 @@ DenseParallelResults<Index_> format_dense_parallel(const SubsetStorage_& subset,
 
     DenseParallelResults<Index_> output;
     output.sorted.reserve(len);
-    output.permutation.reserve(len);
-    for (const auto& pp : collected) {
+    resize_container_to_Index_size(output.reindex, len);
+    for (Index_ i = 0; i < len; ++i) {
+        const auto& pp = collected[i];
         output.sorted.push_back(pp.first);
-        output.permutation.push_back(pp.second);
+        output.reindex[pp.second] = i;
     }
 
     return output;
@@ -101,28 +104,23 @@ private:
     ) {
         resize_container_to_Index_size(my_holding_vbuffer, processed.sorted.size()); // processed.sorted.size() should fit in an Index_, hence the cast is safe.
         my_ext = new_extractor<false, oracle_>(matrix, row, std::move(oracle), std::move(processed.sorted), opt);
-        my_permutation = std::move(processed.permutation);
+        my_reindex = GatherIndices<Index_>(std::make_shared<const std::vector<Index_> >(std::move(processed.reindex)));
     }
 
 public:
     const Value_* fetch(const Index_ i, Value_* const buffer) {
-        auto src = my_ext->fetch(i, my_holding_vbuffer.data());
-
-        // 'input' and 'output' should not point to the same array. In theory, it
-        // is possible to do an in-place permutation, but this requires another
-        // array anyway to track the permutation status, so we'll just keep it simple.
-        for (const auto p : my_permutation) {
-            buffer[p] = *src;
-            ++src;
-        }
+        const auto src = my_ext->fetch(i, my_holding_vbuffer.data());
 
-        return buffer;
+        // 'src' and 'buffer' should not point to the same array. We gather
+        // through the inverse permutation rather than scattering through the
+        // permutation, so that the writes to 'buffer' are sequential.
+        return my_reindex.gather(src, buffer);
     }
 
 private:
     std::unique_ptr<DenseExtractor<oracle_, Value_, Index_> > my_ext;
     std::vector<Value_> my_holding_vbuffer;
-    std::vector<Index_> my_permutation;
+    GatherIndices<Index_> my_reindex;
 };
 
 template<typename Index_, class SubsetStorage_, class ToIndex_>
@@ -151,7 +149,7 @@ public:
         my_remapping(remap) 
     {
         auto processed = format_sparse_parallel<Index_>(subset, subset.size(), [](Index_ i) -> Index_ { return i; });
-        initialize(matrix, std::move(processed), row, std::move(oracle), opt);
+        initialize(matrix, std::move(processed), 0, subset.size(), row, std::move(oracle), opt);
     }
 
     template<class SubsetStorage_>
@@ -168,7 +166,7 @@ public:
         my_remapping(remap) 
     {
         auto processed = format_sparse_parallel<Index_>(subset, block_length, [&](Index_ i) -> Index_ { return i + block_start; });
-        initialize(matrix, std::move(processed), row, std::move(oracle), opt);
+        initialize(matrix, std::move(processed), block_start, block_start + block_length, row, std::move(oracle), opt);
     }
 
     template<class SubsetStorage_>
@@ -185,11 +183,23 @@ public:
     {
         const auto& indices = *indices_ptr;
         auto processed = format_sparse_parallel<Index_>(subset, indices.size(), [&](Index_ i) -> Index_ { return indices[i]; });
-        initialize(matrix, std::move(processed), row, std::move(oracle), opt);
+        if (indices.empty()) {
+            initialize(matrix, std::move(processed), 0, 0, row, std::move(oracle), opt);
+        } else {
+            initialize(matrix, std::move(processed), indices.front(), indices.back() + 1, row, std::move(oracle), opt);
+        }
     }
 
 private:
-    void initialize(const Matrix<Value_, Index_>& matrix, std::vector<Index_> sorted, const bool row, MaybeOracle<oracle_, Index_> oracle, Options opt) {
+    void initialize(
+        const Matrix<Value_, Index_>& matrix,
+        std::vector<Index_> sorted,
+        const Index_ first_position,
+        const Index_ past_last_position,
+        const bool row,
+        MaybeOracle<oracle_, Index_> oracle,
+        Options opt
+    ) {
         my_needs_value = opt.sparse_extract_value;
         my_needs_index = opt.sparse_extract_index;
         my_needs_sort = opt.sparse_ordered_index;
@@ -204,6 +214,7 @@ private:
         } else if (my_needs_value) {
             opt.sparse_extract_index = true;
             my_sortspace.reserve(sorted.size());
+            my_scan = subset_utils::ScanSorter<Value_, Index_>(first_position, past_last_position, true);
             if (my_needs_index) {
                 // no 'my_holding_ibuffer' required as a user-provided 'index_buffer' should be available.
             } else {
@@ -212,7 +223,8 @@ private:
             }
 
         } else if (my_needs_index) {
-            ; // no 'my_holding_ibuffer' required as a user-provided 'index_buffer' should be available.
+            // no 'my_holding_ibuffer' required as a user-provided 'index_buffer' should be available.
+            my_scan = subset_utils::ScanSorter<Value_, Index_>(first_position, past_last_position, false);
         }
 
         my_ext = new_extractor<true, oracle_>(matrix, row, std::move(oracle), std::move(sorted), opt);
@@ -232,6 +244,15 @@ public:
                 input.index = index_buffer;
             }
 
+        } else if (my_needs_value && my_scan.preferred(input.number)) {
+            // Indices are still extracted here, see below.
+            for (Index_ i = 0; i < input.number; ++i) {
+                my_scan.add(my_remapping[input.index[i]], input.value[i]);
+            }
+            my_scan.emit(value_buffer, (my_needs_index ? index_buffer : NULL));
+            input.value = value_buffer;
+            input.index = (my_needs_index ? index_buffer : NULL);
+
         } else if (my_needs_value) {
             // We assume that the indices have already been extracted for sorting
             // purposes, even if they weren't actually requested.
@@ -259,6 +280,13 @@ public:
                 input.index = NULL;
             }
 
+        } else if (my_needs_index && my_scan.preferred(input.number)) {
+            for (Index_ i = 0; i < input.number; ++i) {
+                my_scan.add(my_remapping[input.index[i]]);
+            }
+            my_scan.emit(NULL, index_buffer);
+            input.index = index_buffer;
+
         } else if (my_needs_index) {
             for (Index_ i = 0; i < input.number; ++i) {
                 index_buffer[i] = my_remapping[input.index[i]];
@@ -275,6 +303,7 @@ private:
     std::unique_ptr<SparseExtractor<oracle_, Value_, Index_> > my_ext;
     bool my_needs_value, my_needs_index, my_needs_sort;
     std::vector<std::pair<Index_, Value_> > my_sortspace;
+    subset_utils::ScanSorter<Value_, Index_> my_scan;
     std::vector<Index_> my_holding_ibuffer;
 };
 
@@ -295,7 +324,7 @@ private:
  * Any class implementing `[`, `size()`, `begin()` and `end()` can be used here.
  */
 template<typename Value_, typename Index_, class SubsetStorage_>
-class DelayedSubsetUnique final : public Matrix<Value_, Index_> {
+class DelayedSubsetUnique final : public Matrix<Value_, Index_>, public subset_utils::Collapsible<Value_, Index_> {
 public:
     /**
      * @param matrix Pointer to the underlying (pre-subset) matrix.
@@ -341,6 +370,25 @@ private:
     bool my_by_row;
     std::vector<Index_> my_mapping_single;
 
+    /**
+     * @cond
+     */
+public:
+    const std::shared_ptr<const Matrix<Value_, Index_> >& underlying_matrix() const {
+        return my_matrix;
+    }
+
+    bool subset_by_row() const {
+        return my_by_row;
+    }
+
+    Index_ subset_index(const Index_ i) const {
+        return my_subset[i];
+    }
+    /**
+     * @endcond
+     */
+
 public:
     Index_ nrow() const {
         if (my_by_row) {
@@ -505,6 +553,7 @@ private:
             return std::make_unique<subset_utils::OracularPerpendicularDense<Value_, Index_> >(
                 *my_matrix,
                 my_subset,
+                subset_utils::SubsetStructure<Index_>{ false, true, 0 },
                 row,
                 std::move(oracle),
                 std::forward<Args_>(args)...
@@ -562,6 +611,7 @@ private:
             return std::make_unique<subset_utils::OracularPerpendicularSparse<Value_, Index_> >(
                 *my_matrix,
                 my_subset,
+                subset_utils::SubsetStructure<Index_>{ false, true, 0 },
                 row,
                 std::move(oracle),
                 std::forward<Args_>(args)...
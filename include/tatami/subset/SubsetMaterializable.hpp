@@ -0,0 +1,141 @@
+#ifndef TATAMI_SUBSET_MATERIALIZABLE_HPP
+#define TATAMI_SUBSET_MATERIALIZABLE_HPP
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+/**
+ * @file SubsetMaterializable.hpp
+ *
+ * @brief Interface for direct materialization of subsets from concrete storage.
+ */
+
+namespace tatami {
+
+/**
+ * @brief Scan the structural non-zeros of a subsetted matrix.
+ *
+ * Instances are created by `SubsetMaterializable::subset_scanner()`.
+ * Each call to `scan()` extracts the structural non-zeros of one element of the stored primary dimension of the subsetted matrix.
+ *
+ * @tparam Value_ Type of matrix value.
+ * @tparam Index_ Integer type for the row/column indices.
+ */
+template<typename Value_, typename Index_>
+class SubsetScanner {
+public:
+    /**
+     * @cond
+     */
+    SubsetScanner() = default;
+    SubsetScanner(const SubsetScanner&) = default;
+    SubsetScanner(SubsetScanner&&) = default;
+    SubsetScanner& operator=(const SubsetScanner&) = default;
+    SubsetScanner& operator=(SubsetScanner&&) = default;
+    virtual ~SubsetScanner() = default;
+    /**
+     * @endcond
+     */
+
+    /**
+     * @return Whether the primary dimension is the rows of the subsetted matrix.
+     */
+    virtual bool by_row() const = 0;
+
+    /**
+     * @return Extent of the primary dimension of the subsetted matrix.
+     */
+    virtual Index_ primary() const = 0;
+
+    /**
+     * @return Extent of the secondary dimension of the subsetted matrix.
+     */
+    virtual Index_ secondary() const = 0;
+
+    /**
+     * @return Whether the indices reported by `scan()` are always strictly increasing.
+     */
+    virtual bool sorted() const = 0;
+
+    /**
+     * This method should be safe to call concurrently from multiple threads.
+     *
+     * @param p Index of the primary dimension element of the subsetted matrix.
+     * @param[out] value_buffer Pointer to an array of length no less than `secondary()`, to store the values of the structural non-zeros.
+     * @param[out] index_buffer Pointer to an array of length no less than `secondary()`, to store the secondary dimension indices of the structural non-zeros.
+     *
+     * @return Number of structural non-zeros in `p`.
+     * The first this-many elements of `value_buffer` and `index_buffer` are filled.
+     */
+    virtual Index_ scan(Index_ p, Value_* value_buffer, Index_* index_buffer) const = 0;
+};
+
+/**
+ * @brief Interface for direct materialization of subsets.
+ *
+ * Concrete matrix representations can inherit from this interface to materialize a subset of their contents without going through the extractor API.
+ * This allows `convert_to_compressed_sparse()` and `convert_to_dense()` to operate directly on the underlying storage when they are called on a delayed subset or transposition of the matrix,
+ * e.g., by copying the relevant slices of a `CompressedSparseMatrix` instead of remapping the indices of each row/column and sweeping across the secondary dimension.
+ * See `subset_materialize()` for details on how the subsetted matrix is identified.
+ *
+ * @tparam Value_ Type of matrix value.
+ * @tparam Index_ Integer type for the row/column indices.
+ */
+template<typename Value_, typename Index_>
+class SubsetMaterializable {
+public:
+    /**
+     * @cond
+     */
+    SubsetMaterializable() = default;
+    SubsetMaterializable(const SubsetMaterializable&) = default;
+    SubsetMaterializable(SubsetMaterializable&&) = default;
+    SubsetMaterializable& operator=(const SubsetMaterializable&) = default;
+    SubsetMaterializable& operator=(SubsetMaterializable&&) = default;
+    virtual ~SubsetMaterializable() = default;
+    /**
+     * @endcond
+     */
+
+    /**
+     * Create a scanner for the structural non-zeros of a subset of the matrix.
+     * This is used by `subset_materialize()` to fill a compressed sparse matrix of any type.
+     *
+     * @param row_subset Pointer to a vector of row indices, possibly unsorted and/or duplicated.
+     * If NULL, all rows are used.
+     * @param column_subset Pointer to a vector of column indices, possibly unsorted and/or duplicated.
+     * If NULL, all columns are used.
+     *
+     * @return A `SubsetScanner` for the subsetted matrix.
+     * This may hold pointers to `row_subset` and `column_subset`, which should outlive the scanner.
+     */
+    virtual std::unique_ptr<SubsetScanner<Value_, Index_> > subset_scanner(
+        const std::vector<Index_>* row_subset,
+        const std::vector<Index_>* column_subset
+    ) const = 0;
+
+    /**
+     * Materialize a subset of the matrix in a dense format.
+     *
+     * @param row_subset Pointer to a vector of row indices, possibly unsorted and/or duplicated.
+     * If NULL, all rows are used.
+     * @param column_subset Pointer to a vector of column indices, possibly unsorted and/or duplicated.
+     * If NULL, all columns are used.
+     * @param row_major Whether to store the subsetted matrix in row-major format.
+     * @param[out] store Pointer to an array of length equal to the product of the dimensions of the subsetted matrix.
+     * This may not have been initialized or touched.
+     * @param num_threads Number of threads to use.
+     */
+    virtual void subset_materialize(
+        const std::vector<Index_>* row_subset,
+        const std::vector<Index_>* column_subset,
+        bool row_major,
+        Value_* store,
+        int num_threads
+    ) const = 0;
+};
+
+}
+
+#endif
@@ -6,11 +6,18 @@
 #include "DelayedSubsetUnique.hpp"
 #include "DelayedSubset.hpp"
 #include "DelayedSubsetBlock.hpp"
+#include "DelayedSubsetStrided.hpp"
+#include "DelayedSubsetMultiBlock.hpp"
+#include "utils.hpp"
 #include "../utils/ArrayView.hpp"
 #include "../utils/copy.hpp"
 
 #include <algorithm>
 #include <memory>
+#include <vector>
+#include <cstddef>
+
+#include "sanisizer/sanisizer.hpp"
 
 /**
  * @file make_DelayedSubset.hpp
@@ -20,9 +27,57 @@
 
 namespace tatami {
 
+/**
+ * @cond
+ */
+// Defined in DelayedSubset2D.hpp, which is included at the end of this file.
+template<typename Value_, typename Index_>
+class DelayedSubset2D;
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Options for `make_DelayedSubset()`.
+ */
+struct MakeDelayedSubsetOptions {
+    /**
+     * Maximum stride for dispatching to `DelayedSubsetStrided`.
+     * Larger strides are not worth the cost of reading the intervening rows/columns when extracting the spanning block.
+     * Setting this to 0 will disable dispatch to `DelayedSubsetStrided`.
+     */
+    std::size_t maximum_stride = 4;
+
+    /**
+     * Maximum number of contiguous blocks for dispatching to `DelayedSubsetMultiBlock`.
+     * Larger numbers of blocks are not worth the overhead of creating and calling a separate extractor for each block.
+     * Setting this to 0 will disable dispatch to `DelayedSubsetMultiBlock`.
+     */
+    std::size_t maximum_blocks = 16;
+
+    /**
+     * Whether to collapse nested subsets.
+     * If true and `matrix` is itself a subset of another matrix (i.e., any of the classes created by this function),
+     * the two subsets are combined to create a single subset of the other matrix.
+     * Subsets on the same dimension are combined by composing their indices, while subsets on different dimensions are combined into a `DelayedSubset2D`.
+     * This avoids the cost of remapping indices at each layer during extraction, e.g., after multiple rounds of filtering.
+     */
+    bool collapse = true;
+};
+
 /**
  * A `make_*` helper function to enable partial template deduction of supplied types.
- * This will automatically dispatch to `DelayedSubsetSortedUnique`, `DelayedSubsetUnique`, `DelayedSubsetSorted` or `DelayedSubset`, depending on the values in `subset`.
+ * This will automatically dispatch to the most efficient subsetting class, depending on the values in `subset`.
+ *
+ * - If `subset` is a contiguous block of indices, a `DelayedSubsetBlock` is returned.
+ * - If `subset` is a strided sequence with stride no greater than `MakeDelayedSubsetOptions::maximum_stride`, a `DelayedSubsetStrided` is returned.
+ * - If `subset` is sorted and unique and can be partitioned into no more than `MakeDelayedSubsetOptions::maximum_blocks` contiguous blocks,
+ *   where each block contains at least 2 indices on average, a `DelayedSubsetMultiBlock` is returned.
+ * - Otherwise, a `DelayedSubsetSortedUnique`, `DelayedSubsetUnique`, `DelayedSubsetSorted` or `DelayedSubset` is returned.
+ *
+ * If `MakeDelayedSubsetOptions::collapse = true` and `matrix` was itself created by this function,
+ * the subset is applied directly to the matrix underlying `matrix`.
+ * This may return a `DelayedSubset2D` if `matrix` was subsetted on the other dimension.
  *
  * @tparam Value_ Type of matrix value.
  * @tparam Index_ Integer type of the row/column indices.
@@ -33,14 +88,68 @@ namespace tatami {
  * @param subset Instance of the subset index vector.
  * @param by_row Whether to apply the subset to the rows.
  * If false, the subset is applied to the columns.
+ * @param options Further options.
  *
  * @return A pointer to a `DelayedSubset` instance.
  */
 template<typename Value_, typename Index_, class SubsetStorage_>
-std::shared_ptr<Matrix<Value_, Index_> > make_DelayedSubset(std::shared_ptr<const Matrix<Value_, Index_> > matrix, SubsetStorage_ subset, const bool by_row) {
+std::shared_ptr<Matrix<Value_, Index_> > make_DelayedSubset(
+    std::shared_ptr<const Matrix<Value_, Index_> > matrix,
+    SubsetStorage_ subset,
+    const bool by_row,
+    const MakeDelayedSubsetOptions& options
+) {
     const auto nsub = subset.size();
     typedef I<decltype(nsub)> Subset;
 
+    if (options.collapse) {
+        const auto inner2d = dynamic_cast<const DelayedSubset2D<Value_, Index_>*>(matrix.get());
+        if (inner2d) {
+            const auto& previous = (by_row ? inner2d->row_subset() : inner2d->column_subset());
+            auto composed = sanisizer::create<std::vector<Index_> >(nsub);
+            for (Subset i = 0; i < nsub; ++i) {
+                composed[i] = previous[subset[i]];
+            }
+            if (by_row) {
+                return std::shared_ptr<Matrix<Value_, Index_> >(
+                    new DelayedSubset2D<Value_, Index_>(inner2d->underlying_matrix(), std::move(composed), inner2d->column_subset())
+                );
+            } else {
+                return std::shared_ptr<Matrix<Value_, Index_> >(
+                    new DelayedSubset2D<Value_, Index_>(inner2d->underlying_matrix(), inner2d->row_subset(), std::move(composed))
+                );
+            }
+        }
+
+        const auto inner = dynamic_cast<const subset_utils::Collapsible<Value_, Index_>*>(matrix.get());
+        if (inner && inner->subset_by_row() == by_row) {
+            auto composed = sanisizer::create<std::vector<Index_> >(nsub);
+            for (Subset i = 0; i < nsub; ++i) {
+                composed[i] = inner->subset_index(subset[i]);
+            }
+            return make_DelayedSubset<Value_, Index_, std::vector<Index_> >(inner->underlying_matrix(), std::move(composed), by_row, options);
+        }
+
+        if (inner) {
+            // Subsets on different dimensions are combined into a single 2-dimensional subset.
+            const Index_ other_extent = (by_row ? matrix->ncol() : matrix->nrow());
+            auto other = create_container_of_Index_size<std::vector<Index_> >(other_extent);
+            for (Index_ j = 0; j < other_extent; ++j) {
+                other[j] = inner->subset_index(j);
+            }
+            std::vector<Index_> current(subset.begin(), subset.end());
+            if (by_row) {
+                return std::shared_ptr<Matrix<Value_, Index_> >(
+                    new DelayedSubset2D<Value_, Index_>(inner->underlying_matrix(), std::move(current), std::move(other))
+                );
+            } else {
+                return std::shared_ptr<Matrix<Value_, Index_> >(
+                    new DelayedSubset2D<Value_, Index_>(inner->underlying_matrix(), std::move(other), std::move(current))
+                );
+            }
+        }
+    }
+
     bool is_unsorted = false;
     for (Subset i = 1; i < nsub; ++i) {
         if (subset[i] < subset[i-1]) {
@@ -59,24 +168,62 @@ std::shared_ptr<Matrix<Value_, Index_> > make_DelayedSubset(std::shared_ptr<cons
         }
 
         if (!has_duplicates) {
-            bool consecutive = true;
+            Subset nblocks = (nsub > 0);
             for (Subset i = 1; i < nsub; ++i) {
                 if (subset[i] > subset[i-1] + 1) {
-                    consecutive = false;
-                    break;
+                    ++nblocks;
                 }
             }
 
-            if (consecutive) {
+            if (nblocks <= 1) {
                 const auto start = (nsub ? subset[0] : 0);
                 return std::shared_ptr<Matrix<Value_, Index_> >(
                     new DelayedSubsetBlock<Value_, Index_>(std::move(matrix), start, subset.size(), by_row)
                 );
-            } else {
+            }
+
+            // At this point, we know that there are at least two indices.
+            const Index_ stride = subset[1] - subset[0];
+            if (static_cast<std::size_t>(stride) <= options.maximum_stride) {
+                bool strided = true;
+                for (Subset i = 2; i < nsub; ++i) {
+                    if (static_cast<Index_>(subset[i] - subset[i-1]) != stride) {
+                        strided = false;
+                        break;
+                    }
+                }
+
+                if (strided) {
+                    return std::shared_ptr<Matrix<Value_, Index_> >(
+                        new DelayedSubsetStrided<Value_, Index_>(std::move(matrix), subset[0], stride, nsub, by_row)
+                    );
+                }
+            }
+
+            if (static_cast<std::size_t>(nblocks) <= options.maximum_blocks && nsub / nblocks >= 2) {
+                std::vector<Index_> starts, lengths;
+                starts.reserve(nblocks);
+                lengths.reserve(nblocks);
+                starts.push_back(subset[0]);
+                lengths.push_back(1);
+                for (Subset i = 1; i < nsub; ++i) {
+                    if (subset[i] > subset[i-1] + 1) {
+                        starts.push_back(subset[i]);
+                        lengths.push_back(1);
+                    } else {
+                        ++(lengths.back());
+                    }
+                }
+
                 return std::shared_ptr<Matrix<Value_, Index_> >(
-                    new DelayedSubsetSortedUnique<Value_, Index_, SubsetStorage_>(std::move(matrix), std::move(subset), by_row, false)
+                    new DelayedSubsetMultiBlock<Value_, Index_>(std::move(matrix), std::move(starts), std::move(lengths), by_row)
                 );
             }
+
+            return std::shared_ptr<Matrix<Value_, Index_> >(
+                new DelayedSubsetSortedUnique<Value_, Index_, SubsetStorage_>(std::move(matrix), std::move(subset), by_row, false)
+            );
+
         } else {
             return std::shared_ptr<Matrix<Value_, Index_> >(
                 new DelayedSubsetSorted<Value_, Index_, SubsetStorage_>(std::move(matrix), std::move(subset), by_row, false)
@@ -107,9 +254,35 @@ std::shared_ptr<Matrix<Value_, Index_> > make_DelayedSubset(std::shared_ptr<cons
     }
 }
 
+/**
+ * A `make_*` helper function to enable partial template deduction of supplied types.
+ * This is equivalent to calling the other `make_DelayedSubset()` overload with default options.
+ *
+ * @tparam Value_ Type of matrix value.
+ * @tparam Index_ Integer type of the row/column indices.
+ * @tparam SubsetStorage_ Vector containing the subset indices, to be automatically deduced.
+ * Any class implementing `[`, `size()`, `begin()` and `end()` can be used here.
+ *
+ * @param matrix Pointer to a (possibly `const`) `Matrix`.
+ * @param subset Instance of the subset index vector.
+ * @param by_row Whether to apply the subset to the rows.
+ * If false, the subset is applied to the columns.
+ *
+ * @return A pointer to a `DelayedSubset` instance.
+ */
+template<typename Value_, typename Index_, class SubsetStorage_>
+std::shared_ptr<Matrix<Value_, Index_> > make_DelayedSubset(std::shared_ptr<const Matrix<Value_, Index_> > matrix, SubsetStorage_ subset, const bool by_row) {
+    return make_DelayedSubset<Value_, Index_, SubsetStorage_>(std::move(matrix), std::move(subset), by_row, MakeDelayedSubsetOptions());
+}
+
 /**
  * @cond
  */
+template<typename Value_, typename Index_, class SubsetStorage_>
+std::shared_ptr<Matrix<Value_, Index_> > make_DelayedSubset(std::shared_ptr<Matrix<Value_, Index_> > matrix, SubsetStorage_ subset, const bool by_row, const MakeDelayedSubsetOptions& options) {
+    return make_DelayedSubset<Value_, Index_, SubsetStorage_>(std::shared_ptr<const Matrix<Value_, Index_> >(std::move(matrix)), std::move(subset), by_row, options);
+}
+
 template<typename Value_, typename Index_, class SubsetStorage_>
 std::shared_ptr<Matrix<Value_, Index_> > make_DelayedSubset(std::shared_ptr<Matrix<Value_, Index_> > matrix, SubsetStorage_ subset, const bool by_row) {
     return make_DelayedSubset<Value_, Index_, SubsetStorage_>(std::shared_ptr<const Matrix<Value_, Index_> >(std::move(matrix)), std::move(subset), by_row);
@@ -131,4 +304,7 @@ std::shared_ptr<Matrix<Value_, Index_> > make_DelayedSubset(std::shared_ptr<Matr
 
 }
 
+// Needs to be included after the definition of make_DelayedSubset(), which is used by DelayedSubset2D.
+#include "DelayedSubset2D.hpp"
+
 #endif
@@ -0,0 +1,328 @@
+#ifndef TATAMI_SUBSET_MATERIALIZE_HPP
+#define TATAMI_SUBSET_MATERIALIZE_HPP
+
+#include "../base/Matrix.hpp"
+#include "SubsetMaterializable.hpp"
+#include "DelayedSubset2D.hpp"
+#include "../other/DelayedTranspose.hpp"
+#include "utils.hpp"
+#include "../utils/Index_to_container.hpp"
+#include "../utils/parallelize.hpp"
+#include "../utils/copy.hpp"
+
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+
+#include "sanisizer/sanisizer.hpp"
+
+/**
+ * @file subset_materialize.hpp
+ *
+ * @brief Materialize a delayed subset or transposition directly from its underlying storage.
+ */
+
+namespace tatami {
+
+/**
+ * @cond
+ */
+namespace subset_materialize_internal {
+
+template<typename Value_, typename Index_>
+struct Target {
+    const SubsetMaterializable<Value_, Index_>* storage;
+
+    // Subsets are defined in terms of the rows and columns of 'storage'.
+    std::optional<std::vector<Index_> > row_subset, column_subset;
+
+    // Whether 'matrix' is the transpose of the (subsetted) 'storage'.
+    bool transposed = false;
+};
+
+// Subsets are defined on the rows/columns of the matrix, which are the columns/rows of 'storage' if the matrix is transposed.
+// If a subset was already present on the same dimension of 'storage', we compose the two subsets.
+template<typename Value_, typename Index_>
+void add_subset(Target<Value_, Index_>& target, const bool by_row, std::vector<Index_> subset) {
+    auto& existing = (by_row != target.transposed ? target.row_subset : target.column_subset);
+    if (existing.has_value()) {
+        for (auto& s : subset) {
+            s = (*existing)[s];
+        }
+    }
+    existing = std::move(subset);
+}
+
+// If 'direct = true', 'matrix' itself can be the target, which is only allowed for the children of a delayed operation.
+// Otherwise, it would be pointless to materialize a concrete matrix that the caller could already access directly.
+template<typename Value_, typename Index_>
+std::optional<Target<Value_, Index_> > find_target(const Matrix<Value_, Index_>& matrix, const bool direct) {
+    std::optional<Target<Value_, Index_> > output;
+
+    if (direct) {
+        auto storage = dynamic_cast<const SubsetMaterializable<Value_, Index_>*>(&matrix);
+        if (storage) {
+            output.emplace();
+            output->storage = storage;
+            return output;
+        }
+    }
+
+    if (auto trans = dynamic_cast<const DelayedTranspose<Value_, Index_>*>(&matrix)) {
+        output = find_target(*(trans->underlying_matrix()), true);
+        if (output.has_value()) {
+            output->transposed = !(output->transposed);
+        }
+
+    } else if (auto as2d = dynamic_cast<const DelayedSubset2D<Value_, Index_>*>(&matrix)) {
+        output = find_target(*(as2d->underlying_matrix()), true);
+        if (output.has_value()) {
+            add_subset(*output, true, as2d->row_subset());
+            add_subset(*output, false, as2d->column_subset());
+        }
+
+    } else if (auto collapsible = dynamic_cast<const subset_utils::Collapsible<Value_, Index_>*>(&matrix)) {
+        output = find_target(*(collapsible->underlying_matrix()), true);
+        if (output.has_value()) {
+            const bool by_row = collapsible->subset_by_row();
+            const Index_ extent = (by_row ? matrix.nrow() : matrix.ncol());
+            auto subset = create_container_of_Index_size<std::vector<Index_> >(extent);
+            for (Index_ i = 0; i < extent; ++i) {
+                subset[i] = collapsible->subset_index(i);
+            }
+            add_subset(*output, by_row, std::move(subset));
+        }
+    }
+
+    return output;
+}
+
+template<typename Index_>
+const std::vector<Index_>* get_subset(const std::optional<std::vector<Index_> >& subset) {
+    return (subset.has_value() ? &(*subset) : NULL);
+}
+
+// Each primary dimension element of the output corresponds to a single primary dimension element of the scanner,
+// so we can count and fill them independently in parallel.
+template<typename Value_, typename Index_, typename StoredValue_, typename StoredIndex_, typename StoredPointer_>
+void fill_consistent(
+    const SubsetScanner<Value_, Index_>& scanner,
+    std::vector<StoredValue_>& values,
+    std::vector<StoredIndex_>& indices,
+    std::vector<StoredPointer_>& pointers,
+    const int num_threads
+) {
+    const Index_ num_primary = scanner.primary(), num_secondary = scanner.secondary();
+    pointers.clear();
+    pointers.resize(sanisizer::sum<I<decltype(pointers.size())> >(attest_for_Index(num_primary), 1));
+    parallelize([&](const int, const Index_ start, const Index_ length) -> void {
+        auto vbuffer = create_container_of_Index_size<std::vector<Value_> >(num_secondary);
+        auto ibuffer = create_container_of_Index_size<std::vector<Index_> >(num_secondary);
+        for (Index_ p = start, end = start + length; p < end; ++p) {
+            pointers[p + 1] = scanner.scan(p, vbuffer.data(), ibuffer.data());
+        }
+    }, num_primary, num_threads);
+
+    for (Index_ p = 0; p < num_primary; ++p) {
+        pointers[p + 1] = sanisizer::sum<StoredPointer_>(pointers[p + 1], pointers[p]);
+    }
+    sanisizer::resize(values, pointers.back());
+    sanisizer::resize(indices, pointers.back());
+
+    const bool sorted = scanner.sorted();
+    parallelize([&](const int, const Index_ start, const Index_ length) -> void {
+        auto vbuffer = create_container_of_Index_size<std::vector<Value_> >(num_secondary);
+        auto ibuffer = create_container_of_Index_size<std::vector<Index_> >(num_secondary);
+        std::vector<std::pair<Index_, Value_> > sortspace;
+        for (Index_ p = start, end = start + length; p < end; ++p) {
+            const auto count = scanner.scan(p, vbuffer.data(), ibuffer.data());
+            const auto offset = pointers[p];
+            if (sorted) {
+                std::copy_n(vbuffer.data(), count, values.begin() + offset);
+                std::copy_n(ibuffer.data(), count, indices.begin() + offset);
+            } else {
+                sortspace.clear();
+                for (Index_ i = 0; i < count; ++i) {
+                    sortspace.emplace_back(ibuffer[i], vbuffer[i]);
+                }
+                std::sort(sortspace.begin(), sortspace.end());
+                for (Index_ i = 0; i < count; ++i) {
+                    values[offset + i] = sortspace[i].second;
+                    indices[offset + i] = sortspace[i].first;
+                }
+            }
+        }
+    }, num_primary, num_threads);
+}
+
+// Otherwise, the primary dimension of the output is the secondary dimension of the scanner.
+// Each worker scans a contiguous range of the scanner's primary dimension and counts the non-zeros for each primary dimension element of the output.
+// These per-worker counts are converted into per-worker offsets, so that each worker can fill its own portion of each output element without synchronization.
+// As the workers' ranges are ordered, the output indices are still strictly increasing within each primary dimension element of the output.
+template<typename Value_, typename Index_, typename StoredValue_, typename StoredIndex_, typename StoredPointer_>
+void fill_inconsistent(
+    const SubsetScanner<Value_, Index_>& scanner,
+    std::vector<StoredValue_>& values,
+    std::vector<StoredIndex_>& indices,
+    std::vector<StoredPointer_>& pointers,
+    const int num_threads
+) {
+    const Index_ num_primary = scanner.primary(), num_secondary = scanner.secondary();
+    auto worker_offsets = sanisizer::create<std::vector<std::vector<StoredPointer_> > >(num_threads);
+    auto worker_starts = sanisizer::create<std::vector<Index_> >(num_threads);
+    auto worker_lengths = sanisizer::create<std::vector<Index_> >(num_threads);
+
+    const int num_used = parallelize([&](const int t, const Index_ start, const Index_ length) -> void {
+        // Allocating within each worker to minimize false sharing.
+        auto counts = create_container_of_Index_size<std::vector<StoredPointer_> >(num_secondary);
+        auto vbuffer = create_container_of_Index_size<std::vector<Value_> >(num_secondary);
+        auto ibuffer = create_container_of_Index_size<std::vector<Index_> >(num_secondary);
+        for (Index_ p = start, end = start + length; p < end; ++p) {
+            const auto count = scanner.scan(p, vbuffer.data(), ibuffer.data());
+            for (Index_ i = 0; i < count; ++i) {
+                ++(counts[ibuffer[i]]);
+            }
+        }
+        worker_offsets[t] = std::move(counts);
+        worker_starts[t] = start;
+        worker_lengths[t] = length;
+    }, num_primary, num_threads);
+
+    pointers.clear();
+    pointers.resize(sanisizer::sum<I<decltype(pointers.size())> >(attest_for_Index(num_secondary), 1));
+    for (Index_ s = 0; s < num_secondary; ++s) {
+        auto offset = pointers[s];
+        for (int t = 0; t < num_used; ++t) {
+            auto& current = worker_offsets[t];
+            if (current.empty()) { // in case a worker was not used.
+                continue;
+            }
+            const auto count = current[s];
+            current[s] = offset;
+            offset = sanisizer::sum<StoredPointer_>(offset, count);
+        }
+        pointers[s + 1] = offset;
+    }
+    sanisizer::resize(values, pointers.back());
+    sanisizer::resize(indices, pointers.back());
+
+    parallelize([&](const int, const int start, const int length) -> void {
+        auto vbuffer = create_container_of_Index_size<std::vector<Value_> >(num_secondary);
+        auto ibuffer = create_container_of_Index_size<std::vector<Index_> >(num_secondary);
+        for (int t = start, tend = start + length; t < tend; ++t) {
+            auto& offsets = worker_offsets[t];
+            for (Index_ p = worker_starts[t], end = worker_starts[t] + worker_lengths[t]; p < end; ++p) {
+                const auto count = scanner.scan(p, vbuffer.data(), ibuffer.data());
+                for (Index_ i = 0; i < count; ++i) {
+                    auto& pos = offsets[ibuffer[i]];
+                    values[pos] = vbuffer[i];
+                    indices[pos] = p;
+                    ++pos;
+                }
+            }
+        }
+    }, num_used, num_used);
+}
+
+}
+/**
+ * @endcond
+ */
+
+/**
+ * Materialize a delayed subset in compressed sparse format, directly from the storage of the underlying matrix.
+ * This is only possible if `matrix` is a subset created by `make_DelayedSubset()` (or any of the subset classes, including `DelayedSubset2D`) and/or a `DelayedTranspose`,
+ * where the innermost matrix inherits from the `SubsetMaterializable` interface, e.g., a `CompressedSparseMatrix` or `DenseMatrix`.
+ * Nested subsets are composed into a single subset of the innermost matrix,
+ * while transpositions are handled by swapping the row and column subsets and materializing the innermost matrix in the opposite layout.
+ * This means that, e.g., the compressed sparse row representation of a transposed `CompressedSparseMatrix` in compressed sparse column format is obtained by copying its arrays.
+ *
+ * The structural non-zeros are obtained from the `SubsetScanner` of the innermost matrix and written directly into the output vectors, converting to the output types as necessary.
+ * If the output's primary dimension is not the scanner's primary dimension, each thread counts and fills the non-zeros for its own range of the scanner's primary dimension,
+ * which requires a vector of length equal to the output's primary extent for each thread.
+ *
+ * @tparam Value_ Type of matrix value.
+ * @tparam Index_ Integer type for the row/column indices.
+ * @tparam StoredValue_ Type of the values in the output.
+ * @tparam StoredIndex_ Integer type of the indices in the output.
+ * @tparam StoredPointer_ Integer type of the pointers in the output.
+ *
+ * @param matrix A `tatami::Matrix`, possibly a delayed subset and/or transposition.
+ * @param row Whether to materialize the subset in compressed sparse row format.
+ * @param[out] values Vector of values of the structural non-zero elements.
+ * @param[out] indices Vector of secondary dimension indices of the structural non-zero elements.
+ * These are strictly increasing within each primary dimension element.
+ * @param[out] pointers Vector of pointers for each primary dimension element.
+ * @param num_threads Number of threads to use.
+ *
+ * @return Whether the subset could be materialized directly.
+ * If `false`, the output vectors are not modified and the caller should fall back to extraction via the usual `Matrix` interface.
+ */
+template<typename Value_, typename Index_, typename StoredValue_, typename StoredIndex_, typename StoredPointer_>
+bool subset_materialize(
+    const Matrix<Value_, Index_>& matrix,
+    const bool row,
+    std::vector<StoredValue_>& values,
+    std::vector<StoredIndex_>& indices,
+    std::vector<StoredPointer_>& pointers,
+    const int num_threads
+) {
+    auto target = subset_materialize_internal::find_target(matrix, false);
+    if (!target.has_value()) {
+        return false;
+    }
+
+    const auto scanner = target->storage->subset_scanner(
+        subset_materialize_internal::get_subset(target->row_subset),
+        subset_materialize_internal::get_subset(target->column_subset)
+    );
+    if ((row != target->transposed) == scanner->by_row()) {
+        subset_materialize_internal::fill_consistent(*scanner, values, indices, pointers, num_threads);
+    } else {
+        subset_materialize_internal::fill_inconsistent(*scanner, values, indices, pointers, num_threads);
+    }
+    return true;
+}
+
+/**
+ * Materialize a delayed subset in dense format, directly from the storage of the underlying matrix.
+ * This is only possible under the same conditions as the compressed sparse overload.
+ *
+ * @tparam Value_ Type of matrix value.
+ * @tparam Index_ Integer type for the row/column indices.
+ *
+ * @param matrix A `tatami::Matrix`, possibly a delayed subset and/or transposition.
+ * @param row_major Whether to store the subset in row-major format.
+ * @param[out] store Pointer to an array of length equal to the product of the dimensions of `matrix`.
+ * @param num_threads Number of threads to use.
+ *
+ * @return Whether the subset could be materialized directly.
+ * If `false`, `store` is not modified and the caller should fall back to extraction via the usual `Matrix` interface.
+ */
+template<typename Value_, typename Index_>
+bool subset_materialize(
+    const Matrix<Value_, Index_>& matrix,
+    const bool row_major,
+    Value_* const store,
+    const int num_threads
+) {
+    auto target = subset_materialize_internal::find_target(matrix, false);
+    if (!target.has_value()) {
+        return false;
+    }
+
+    target->storage->subset_materialize(
+        subset_materialize_internal::get_subset(target->row_subset),
+        subset_materialize_internal::get_subset(target->column_subset),
+        row_major != target->transposed,
+        store,
+        num_threads
+    );
+    return true;
+}
+
+}
+
+#endif
@@ -3,19 +3,133 @@
 
 #include "../base/Matrix.hpp"
 #include "../utils/new_extractor.hpp"
+#include "../utils/Index_to_container.hpp"
 
 #include <vector>
 #include <algorithm>
 #include <type_traits>
+#include <memory>
 
 namespace tatami {
 
 namespace subset_utils {
 
+// Implemented by all subset classes so that make_DelayedSubset() can compose nested subsets on the same dimension.
+template<typename Value_, typename Index_>
+class Collapsible {
+public:
+    virtual ~Collapsible() = default;
+
+    virtual const std::shared_ptr<const Matrix<Value_, Index_> >& underlying_matrix() const = 0;
+
+    virtual bool subset_by_row() const = 0;
+
+    // Index on the underlying matrix for the i-th row/column of the subset.
+    virtual Index_ subset_index(Index_ i) const = 0;
+};
+
+// Structural properties of the subset vector, so that SubsetOracle can report the structure of its predictions.
+template<typename Index_>
+struct SubsetStructure {
+    // Whether the subset is sorted in non-decreasing order.
+    bool increasing = false;
+
+    // Whether the subset contains no duplicate indices.
+    bool unique = false;
+
+    // Positive if the subset is itself an arithmetic sequence with this step size.
+    Index_ stride = 0;
+};
+
+// Computing the structure of an arbitrary subset, using the same checks as make_DelayedSubset().
+// 'extent' is the extent of the subsetted dimension of the underlying matrix, used to check for duplicates in an unsorted subset.
+template<typename Index_, class SubsetStorage_>
+SubsetStructure<Index_> compute_subset_structure(const SubsetStorage_& subset, const Index_ extent) {
+    SubsetStructure<Index_> output;
+    const auto nsub = subset.size();
+
+    output.increasing = true;
+    for (I<decltype(nsub)> i = 1; i < nsub; ++i) {
+        if (subset[i] < subset[i-1]) {
+            output.increasing = false;
+            break;
+        }
+    }
+
+    if (output.increasing) {
+        output.unique = true;
+        for (I<decltype(nsub)> i = 1; i < nsub; ++i) {
+            if (subset[i] == subset[i-1]) {
+                output.unique = false;
+                break;
+            }
+        }
+
+        if (output.unique && nsub >= 2) {
+            const Index_ stride = subset[1] - subset[0];
+            bool strided = true;
+            for (I<decltype(nsub)> i = 2; i < nsub; ++i) {
+                if (static_cast<Index_>(subset[i] - subset[i-1]) != stride) {
+                    strided = false;
+                    break;
+                }
+            }
+            if (strided) {
+                output.stride = stride;
+            }
+        }
+
+    } else {
+        output.unique = true;
+        auto accumulated = create_container_of_Index_size<std::vector<unsigned char> >(extent);
+        for (I<decltype(nsub)> i = 0; i < nsub; ++i) {
+            auto& found = accumulated[subset[i]];
+            if (found) {
+                output.unique = false;
+                break;
+            }
+            found = 1;
+        }
+    }
+
+    return output;
+}
+
 template<typename Index_, class SubsetStorage_>
 class SubsetOracle final : public Oracle<Index_> {
 public:
-    SubsetOracle(std::shared_ptr<const Oracle<Index_> > oracle, const SubsetStorage_& subset) : my_oracle(std::move(oracle)), my_subset(subset) {}
+    SubsetOracle(std::shared_ptr<const Oracle<Index_> > oracle, const SubsetStorage_& subset, const SubsetStructure<Index_>& structure) :
+        my_oracle(std::move(oracle)),
+        my_subset(subset)
+    {
+        this->set_max_lookahead(my_oracle->max_lookahead());
+
+        const auto total = my_oracle->total();
+        if (total <= 1) {
+            my_strided = true;
+            my_increasing = true;
+            return;
+        }
+
+        my_increasing = structure.increasing && my_oracle->is_increasing();
+        if (!my_oracle->is_strided()) {
+            return;
+        }
+
+        if (structure.stride > 0) {
+            // With at least two predictions, the product must be less than the extent of the underlying dimension, so it fits in an Index_.
+            my_strided = true;
+            my_stride = structure.stride * my_oracle->stride();
+        } else if (structure.increasing && structure.unique) {
+            // A strictly increasing subset is consecutive over the span of the predictions if the subset indices differ by the same amount as the predictions.
+            // In such cases, the step size is the same as that of the original oracle. 
+            const auto first = my_oracle->get(0), last = my_oracle->get(total - 1);
+            if (my_subset[last] - my_subset[first] == last - first) {
+                my_strided = true;
+                my_stride = my_oracle->stride();
+            }
+        }
+    }
 
     Index_ get(const PredictionIndex i) const {
         return my_subset[my_oracle->get(i)];
@@ -25,9 +139,27 @@ public:
         return my_oracle->total();
     }
 
+    bool is_consecutive() const {
+        return my_strided && my_stride == 1;
+    }
+
+    bool is_strided() const {
+        return my_strided;
+    }
+
+    Index_ stride() const {
+        return my_stride;
+    }
+
+    bool is_increasing() const {
+        return my_increasing;
+    }
+
 private:
     std::shared_ptr<const Oracle<Index_> > my_oracle;
     const SubsetStorage_& my_subset;
+    bool my_strided = false, my_increasing = false;
+    Index_ my_stride = 1;
 };
 
 template<typename Value_, typename Index_, class SubsetStorage_>
@@ -83,11 +215,12 @@ public:
     OracularPerpendicularDense(
         const Matrix<Value_, Index_>& matrix,
         const SubsetStorage_& subset,
+        const SubsetStructure<Index_>& structure,
         const bool row,
         std::shared_ptr<const Oracle<Index_> > oracle,
         Args_&& ... args
     ) :
-        my_ext(new_extractor<false, true>(matrix, row, std::make_shared<SubsetOracle<Index_, SubsetStorage_> >(std::move(oracle), subset), std::forward<Args_>(args)...))
+        my_ext(new_extractor<false, true>(matrix, row, std::make_shared<SubsetOracle<Index_, SubsetStorage_> >(std::move(oracle), subset, structure), std::forward<Args_>(args)...))
     {}
 
     const Value_* fetch(const Index_ i, Value_* const buffer) {
@@ -105,11 +238,12 @@ public:
     OracularPerpendicularSparse(
         const Matrix<Value_, Index_>& matrix,
         const SubsetStorage_& subset,
+        const SubsetStructure<Index_>& structure,
         const bool row,
         std::shared_ptr<const Oracle<Index_> > oracle,
         Args_&& ... args
     ) :
-        my_ext(new_extractor<true, true>(matrix, row, std::make_shared<SubsetOracle<Index_, SubsetStorage_> >(std::move(oracle), subset), std::forward<Args_>(args)...))
+        my_ext(new_extractor<true, true>(matrix, row, std::make_shared<SubsetOracle<Index_, SubsetStorage_> >(std::move(oracle), subset, structure), std::forward<Args_>(args)...))
     {}
 
     SparseRange<Value_, Index_> fetch(const Index_ i, Value_* const value_buffer, Index_* const index_buffer) {
@@ -120,6 +254,69 @@ protected:
     std::unique_ptr<OracularSparseExtractor<Value_, Index_> > my_ext;
 };
 
+// Reorders sparse values by their positions in the subset, for use by the parallel sparse extractors when 'sparse_ordered_index = true'.
+// Positions lie in '[first, past_last)', i.e., the range of subset indices requested by the caller, and each position occurs at most once per call to 'fetch()'.
+// Instead of a comparison sort, we mark each position in a bitmap and then scan the entire range, which is linear in the span of the requested positions.
+// This is faster than sorting when the number of non-zero elements is large relative to the span.
+template<typename Value_, typename Index_>
+class ScanSorter {
+public:
+    ScanSorter() = default;
+
+    ScanSorter(const Index_ first, const Index_ past_last, const bool needs_value) : my_first(first), my_span(past_last - first) {
+        resize_container_to_Index_size(my_present, my_span);
+        if (needs_value) {
+            resize_container_to_Index_size(my_values, my_span);
+        }
+    }
+
+private:
+    Index_ my_first = 0, my_span = 0;
+    std::vector<unsigned char> my_present;
+    std::vector<Value_> my_values;
+
+public:
+    // Comparison sorts scale at 'number * log2(number)' while the scan scales at 'span'.
+    bool preferred(const Index_ number) const {
+        if (number == 0) {
+            return false;
+        }
+        Index_ log2 = 0;
+        for (Index_ n = number; n > 1; n /= 2) {
+            ++log2;
+        }
+        return my_span / number <= log2;
+    }
+
+    void add(const Index_ position) {
+        my_present[position - my_first] = 1;
+    }
+
+    void add(const Index_ position, const Value_ value) {
+        const Index_ offset = position - my_first;
+        my_present[offset] = 1;
+        my_values[offset] = value;
+    }
+
+    // Either of the buffers may be NULL if the values or indices are not required.
+    // All positions are cleared by this call, so that the sorter can be re-used for the next 'fetch()'.
+    void emit(Value_* vbuffer, Index_* ibuffer) {
+        for (Index_ offset = 0; offset < my_span; ++offset) {
+            if (my_present[offset]) {
+                my_present[offset] = 0;
+                if (vbuffer) {
+                    *vbuffer = my_values[offset];
+                    ++vbuffer;
+                }
+                if (ibuffer) {
+                    *ibuffer = offset + my_first;
+                    ++ibuffer;
+                }
+            }
+        }
+    }
+};
+
 }
 
 }
@@ -30,17 +30,34 @@
 #include "other/DelayedCast.hpp"
 #include "other/DelayedTranspose.hpp"
 #include "other/ConstantMatrix.hpp"
+#include "other/CachedMatrix.hpp"
+#include "other/SparsePlusOffsetMatrix.hpp"
+#include "other/DelayedPipelineStage.hpp"
 
 #include "subset/DelayedSubsetBlock.hpp"
+#include "subset/DelayedSubsetStrided.hpp"
+#include "subset/DelayedSubsetMultiBlock.hpp"
+#include "subset/DelayedSubset2D.hpp"
 #include "subset/make_DelayedSubset.hpp"
+#include "subset/SubsetMaterializable.hpp"
+#include "subset/subset_materialize.hpp"
 
 #include "utils/wrap_shared_ptr.hpp"
 #include "utils/ArrayView.hpp"
 #include "utils/SomeNumericArray.hpp"
 #include "utils/ConsecutiveOracle.hpp"
 #include "utils/parallelize.hpp"
+#include "utils/ThreadPool.hpp"
+#include "utils/parallelize_weighted.hpp"
+#include "utils/AsyncPrefetchExtractor.hpp"
+#include "utils/parallelize_numa.hpp"
+#include "utils/DefaultInitAllocator.hpp"
+#include "utils/reduce.hpp"
 #include "utils/FixedOracle.hpp"
+#include "utils/ReorderedExtraction.hpp"
 #include "utils/process_consecutive_indices.hpp"
+#include "utils/merge_sorted_indices.hpp"
+#include "utils/gather.hpp"
 
 /**
  * @file tatami.hpp
@@ -0,0 +1,436 @@
+#ifndef TATAMI_ASYNC_PREFETCH_EXTRACTOR_HPP
+#define TATAMI_ASYNC_PREFETCH_EXTRACTOR_HPP
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include "../base/Matrix.hpp"
+#include "../base/Extractor.hpp"
+#include "new_extractor.hpp"
+#include "Index_to_container.hpp"
+#include "copy.hpp"
+
+#include "sanisizer/sanisizer.hpp"
+
+/**
+ * @file AsyncPrefetchExtractor.hpp
+ * @brief Prefetch oracular extractions in a background thread.
+ */
+
+namespace tatami {
+
+/**
+ * @brief Options for the asynchronous prefetching extractors.
+ */
+struct AsyncPrefetchExtractorOptions {
+    /**
+     * Number of buffers in the ring, i.e., the maximum number of batches that can be extracted ahead of the consumer.
+     * This should be positive.
+     */
+    int num_buffers = 4;
+
+    /**
+     * Number of dimension elements in each batch.
+     * Larger batches reduce the synchronization overhead between the helper thread and the consumer, at the cost of memory usage.
+     * This should be positive.
+     */
+    int batch_size = 1;
+};
+
+/**
+ * @cond
+ */
+namespace AsyncPrefetchExtractor_internal {
+
+template<class Slot_>
+class Ring {
+public:
+    template<class Fill_>
+    Ring(const PredictionIndex total, std::vector<Slot_> slots, Fill_ fill) : my_total(total), my_slots(std::move(slots)) {
+        if (my_slots.empty()) {
+            throw std::runtime_error("number of buffers should be positive");
+        }
+
+        // Starting the thread last, once all members are initialized.
+        my_thread = std::thread([this, fill]() mutable -> void { produce(fill); });
+    }
+
+    Ring(const Ring&) = delete;
+    Ring& operator=(const Ring&) = delete;
+    Ring(Ring&&) = delete;
+    Ring& operator=(Ring&&) = delete;
+
+    ~Ring() {
+        {
+            std::lock_guard<std::mutex> lck(my_mut);
+            my_stop = true;
+        }
+        my_producer_cv.notify_all();
+        my_thread.join();
+    }
+
+private:
+    PredictionIndex my_total;
+    std::vector<Slot_> my_slots;
+
+    std::mutex my_mut;
+    std::condition_variable my_producer_cv, my_consumer_cv;
+    PredictionIndex my_produced = 0, my_consumed = 0;
+    bool my_stop = false;
+    std::exception_ptr my_error;
+    std::thread my_thread;
+
+    template<class Fill_>
+    void produce(Fill_& fill) {
+        const auto num_slots = my_slots.size();
+        for (PredictionIndex p = 0; p < my_total; ++p) {
+            {
+                std::unique_lock<std::mutex> lck(my_mut);
+                my_producer_cv.wait(lck, [&]() -> bool { return my_stop || p - my_consumed < num_slots; });
+                if (my_stop) {
+                    return;
+                }
+            }
+
+            // The consumer does not touch this slot until 'my_produced' is incremented, so we can fill it without holding the lock.
+            std::exception_ptr error;
+            try {
+                fill(my_slots[p % num_slots]);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> lck(my_mut);
+                if (error) {
+                    my_error = error;
+                } else {
+                    ++my_produced;
+                }
+            }
+            my_consumer_cv.notify_one();
+            if (error) {
+                return;
+            }
+        }
+    }
+
+public:
+    template<class Consume_>
+    void consume(Consume_ fun) {
+        {
+            std::unique_lock<std::mutex> lck(my_mut);
+            if (my_consumed >= my_total) {
+                throw std::runtime_error("no more predictions are available from the oracle");
+            }
+            my_consumer_cv.wait(lck, [&]() -> bool { return my_produced > my_consumed || my_error; });
+            if (my_produced == my_consumed) {
+                std::rethrow_exception(my_error);
+            }
+        }
+
+        fun(my_slots[my_consumed % my_slots.size()]);
+
+        {
+            std::lock_guard<std::mutex> lck(my_mut);
+            ++my_consumed;
+        }
+        my_producer_cv.notify_one();
+    }
+};
+
+template<typename Value_>
+struct DenseSlot {
+    std::vector<Value_> buffer;
+};
+
+template<typename Value_, typename Index_>
+struct SparseSlot {
+    std::vector<Value_> value_buffer;
+    std::vector<Index_> index_buffer;
+    std::vector<Index_> number;
+    bool has_value = false;
+    bool has_index = false;
+};
+
+inline PredictionIndex count_batches(const PredictionIndex total, const int batch_size) {
+    if (batch_size <= 0) {
+        throw std::runtime_error("batch size should be positive");
+    }
+    const PredictionIndex bsize = batch_size;
+    return total / bsize + (total % bsize > 0);
+}
+
+}
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Prefetch dense oracular extractions in a background thread.
+ *
+ * @tparam Value_ Data value type, should be numeric.
+ * @tparam Index_ Row/column index type, should be integer.
+ *
+ * This wraps an `OracularDenseExtractor` so that its `fetch()` calls are performed in a helper thread,
+ * filling a bounded ring of buffers ahead of the consumer according to the oracle's predictions.
+ * The aim is to overlap any expensive extraction in the backend (e.g., decompression, file I/O) with the user's computation on previously extracted elements.
+ *
+ * Each buffer holds a batch of consecutive predictions, see `AsyncPrefetchExtractorOptions::batch_size`.
+ * The helper thread copies the values for each dimension element into the buffer,
+ * as the wrapped extractor's returned pointer is only guaranteed to be valid until its next `fetch()`.
+ * `fetch()` then returns a pointer into the batch that is currently being consumed, without any further copies.
+ * Any exception thrown by the wrapped extractor is rethrown by the `fetch()` call that consumes the affected batch.
+ *
+ * The wrapped extractor is only ever used by the helper thread, so it need not be thread-safe.
+ * However, its `Matrix` should support extraction from a thread other than the one that created the extractor.
+ */
+template<typename Value_, typename Index_>
+class AsyncPrefetchDenseExtractor final : public OracularDenseExtractor<Value_, Index_> {
+public:
+    /**
+     * @param ext Oracle-aware dense extractor.
+     * @param total Total number of predictions from the oracle used to construct `ext`.
+     * @param extent Number of values to be extracted from each dimension element, see `N` in `MyopicDenseExtractor::fetch()`.
+     * @param options Further options.
+     */
+    AsyncPrefetchDenseExtractor(
+        std::unique_ptr<OracularDenseExtractor<Value_, Index_> > ext,
+        const PredictionIndex total,
+        const Index_ extent,
+        const AsyncPrefetchExtractorOptions& options
+    ) :
+        my_ext(std::move(ext)),
+        my_extent(extent),
+        my_total(total),
+        my_batch_size(options.batch_size),
+        my_ring(
+            AsyncPrefetchExtractor_internal::count_batches(total, options.batch_size),
+            [&]{
+                const auto bufsize = sanisizer::product<I<decltype(my_current.buffer.size())> >(attest_for_Index(extent), options.batch_size);
+                auto slots = sanisizer::create<std::vector<Slot> >(options.num_buffers);
+                for (auto& slot : slots) {
+                    slot.buffer.resize(bufsize);
+                }
+                my_current.buffer.resize(bufsize);
+                return slots;
+            }(),
+            [this](Slot& slot) -> void {
+                const auto num = next_batch_size(my_filled);
+                for (PredictionIndex b = 0; b < num; ++b) {
+                    const auto dest = slot.buffer.data() + sanisizer::product_unsafe<std::size_t>(b, my_extent);
+                    const auto ptr = my_ext->fetch(dest);
+                    copy_n(ptr, my_extent, dest);
+                }
+                my_filled += num;
+            }
+        )
+    {}
+
+    /**
+     * @param ext Oracle-aware dense extractor.
+     * @param total Total number of predictions from the oracle used to construct `ext`.
+     * @param extent Number of values to be extracted from each dimension element.
+     */
+    AsyncPrefetchDenseExtractor(std::unique_ptr<OracularDenseExtractor<Value_, Index_> > ext, const PredictionIndex total, const Index_ extent) :
+        AsyncPrefetchDenseExtractor(std::move(ext), total, extent, AsyncPrefetchExtractorOptions()) {}
+
+private:
+    typedef AsyncPrefetchExtractor_internal::DenseSlot<Value_> Slot;
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > my_ext;
+    Index_ my_extent;
+    PredictionIndex my_total;
+    PredictionIndex my_batch_size;
+
+    PredictionIndex my_filled = 0; // only used by the helper thread.
+    Slot my_current; // only used by the consumer.
+    PredictionIndex my_consumed = 0, my_current_used = 0, my_current_size = 0;
+
+    AsyncPrefetchExtractor_internal::Ring<Slot> my_ring; // declared last so that the thread is joined before the other members are destroyed.
+
+    PredictionIndex next_batch_size(const PredictionIndex used) const {
+        const auto leftover = my_total - used;
+        return (leftover < my_batch_size ? leftover : my_batch_size);
+    }
+
+public:
+    const Value_* fetch(const Index_, Value_* const) {
+        if (my_current_used == my_current_size) {
+            my_ring.consume([&](Slot& slot) -> void {
+                // Swapping so that the helper thread can refill our previous batch.
+                std::swap(slot.buffer, my_current.buffer);
+            });
+            my_current_size = next_batch_size(my_consumed);
+            my_consumed += my_current_size;
+            my_current_used = 0;
+        }
+
+        const auto output = my_current.buffer.data() + sanisizer::product_unsafe<std::size_t>(my_current_used, my_extent);
+        ++my_current_used;
+        return output;
+    }
+};
+
+/**
+ * @brief Prefetch sparse oracular extractions in a background thread.
+ *
+ * @tparam Value_ Data value type, should be numeric.
+ * @tparam Index_ Row/column index type, should be integer.
+ *
+ * This is the sparse counterpart to `AsyncPrefetchDenseExtractor`.
+ * Values and indices are copied into the ring by the helper thread,
+ * and `fetch()` returns pointers into the batch that is currently being consumed.
+ */
+template<typename Value_, typename Index_>
+class AsyncPrefetchSparseExtractor final : public OracularSparseExtractor<Value_, Index_> {
+public:
+    /**
+     * @param ext Oracle-aware sparse extractor.
+     * @param total Total number of predictions from the oracle used to construct `ext`.
+     * @param extent Maximum number of structural non-zeros in each dimension element, see `N` in `MyopicDenseExtractor::fetch()`.
+     * This may also be an upper bound, e.g., the extent of the non-target dimension.
+     * @param options Further options.
+     */
+    AsyncPrefetchSparseExtractor(
+        std::unique_ptr<OracularSparseExtractor<Value_, Index_> > ext,
+        const PredictionIndex total,
+        const Index_ extent,
+        const AsyncPrefetchExtractorOptions& options
+    ) :
+        my_ext(std::move(ext)),
+        my_extent(extent),
+        my_total(total),
+        my_batch_size(options.batch_size),
+        my_ring(
+            AsyncPrefetchExtractor_internal::count_batches(total, options.batch_size),
+            [&]{
+                auto slots = sanisizer::create<std::vector<Slot> >(options.num_buffers);
+                for (auto& slot : slots) {
+                    allocate(slot, extent, options.batch_size);
+                }
+                allocate(my_current, extent, options.batch_size);
+                return slots;
+            }(),
+            [this](Slot& slot) -> void {
+                const auto num = next_batch_size(my_filled);
+                for (PredictionIndex b = 0; b < num; ++b) {
+                    const auto offset = sanisizer::product_unsafe<std::size_t>(b, my_extent);
+                    const auto vdest = slot.value_buffer.data() + offset;
+                    const auto idest = slot.index_buffer.data() + offset;
+                    const auto range = my_ext->fetch(vdest, idest);
+                    slot.has_value = (range.value != NULL);
+                    slot.has_index = (range.index != NULL);
+                    if (slot.has_value) {
+                        copy_n(range.value, range.number, vdest);
+                    }
+                    if (slot.has_index) {
+                        copy_n(range.index, range.number, idest);
+                    }
+                    slot.number[b] = range.number;
+                }
+                my_filled += num;
+            }
+        )
+    {}
+
+    /**
+     * @param ext Oracle-aware sparse extractor.
+     * @param total Total number of predictions from the oracle used to construct `ext`.
+     * @param extent Maximum number of structural non-zeros in each dimension element.
+     */
+    AsyncPrefetchSparseExtractor(std::unique_ptr<OracularSparseExtractor<Value_, Index_> > ext, const PredictionIndex total, const Index_ extent) :
+        AsyncPrefetchSparseExtractor(std::move(ext), total, extent, AsyncPrefetchExtractorOptions()) {}
+
+private:
+    typedef AsyncPrefetchExtractor_internal::SparseSlot<Value_, Index_> Slot;
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > my_ext;
+    Index_ my_extent;
+    PredictionIndex my_total;
+    PredictionIndex my_batch_size;
+
+    PredictionIndex my_filled = 0; // only used by the helper thread.
+    Slot my_current; // only used by the consumer.
+    PredictionIndex my_consumed = 0, my_current_used = 0, my_current_size = 0;
+
+    AsyncPrefetchExtractor_internal::Ring<Slot> my_ring; // declared last so that the thread is joined before the other members are destroyed.
+
+    static void allocate(Slot& slot, const Index_ extent, const int batch_size) {
+        const auto bufsize = sanisizer::product<std::size_t>(attest_for_Index(extent), batch_size);
+        slot.value_buffer.resize(sanisizer::cast<I<decltype(slot.value_buffer.size())> >(bufsize));
+        slot.index_buffer.resize(sanisizer::cast<I<decltype(slot.index_buffer.size())> >(bufsize));
+        slot.number.resize(sanisizer::cast<I<decltype(slot.number.size())> >(batch_size));
+    }
+
+    PredictionIndex next_batch_size(const PredictionIndex used) const {
+        const auto leftover = my_total - used;
+        return (leftover < my_batch_size ? leftover : my_batch_size);
+    }
+
+public:
+    SparseRange<Value_, Index_> fetch(const Index_, Value_* const, Index_* const) {
+        if (my_current_used == my_current_size) {
+            my_ring.consume([&](Slot& slot) -> void {
+                // Swapping so that the helper thread can refill our previous batch.
+                std::swap(slot, my_current);
+            });
+            my_current_size = next_batch_size(my_consumed);
+            my_consumed += my_current_size;
+            my_current_used = 0;
+        }
+
+        const auto offset = sanisizer::product_unsafe<std::size_t>(my_current_used, my_extent);
+        SparseRange<Value_, Index_> output(
+            my_current.number[my_current_used],
+            (my_current.has_value ? my_current.value_buffer.data() + offset : NULL),
+            (my_current.has_index ? my_current.index_buffer.data() + offset : NULL)
+        );
+        ++my_current_used;
+        return output;
+    }
+};
+
+/**
+ * Create an oracle-aware extractor from a `Matrix` and wrap it in an `AsyncPrefetchDenseExtractor` or `AsyncPrefetchSparseExtractor`.
+ *
+ * @tparam sparse_ Whether to perform sparse retrieval.
+ * @tparam Value_ Data value type, should be numeric.
+ * @tparam Index_ Row/column index type, should be integer.
+ * @tparam Args_ Types of further arguments to pass to `new_extractor()`.
+ *
+ * @param matrix A `tatami::Matrix` to extract from.
+ * @param row Whether to extract rows.
+ * @param oracle Oracle for the rows (if `row = true`) or columns to be extracted.
+ * @param options Further options.
+ * @param args Further arguments to pass to `new_extractor()`, i.e., the block or index specification and the extraction `Options`.
+ *
+ * @return Pointer to an `AsyncPrefetchDenseExtractor` or `AsyncPrefetchSparseExtractor`, depending on `sparse_`.
+ */
+template<bool sparse_, typename Value_, typename Index_, typename ... Args_>
+std::unique_ptr<typename std::conditional<sparse_, OracularSparseExtractor<Value_, Index_>, OracularDenseExtractor<Value_, Index_> >::type> new_async_prefetch_extractor(
+    const Matrix<Value_, Index_>& matrix,
+    const bool row,
+    MaybeOracle<true, Index_> oracle,
+    const AsyncPrefetchExtractorOptions& options,
+    Args_&& ... args
+) {
+    const Index_ extent = new_extractor_internal::extraction_extent(matrix, row, args...);
+    const auto total = oracle->total();
+    auto ext = new_extractor<sparse_, true>(matrix, row, std::move(oracle), std::forward<Args_>(args)...);
+    if constexpr(sparse_) {
+        return std::make_unique<AsyncPrefetchSparseExtractor<Value_, Index_> >(std::move(ext), total, extent, options);
+    } else {
+        return std::make_unique<AsyncPrefetchDenseExtractor<Value_, Index_> >(std::move(ext), total, extent, options);
+    }
+}
+
+}
+
+#endif
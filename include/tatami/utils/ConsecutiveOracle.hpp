@@ -39,6 +39,18 @@ public:
         return my_offset + i;
     }
 
+    const Index_* span(const PredictionIndex start, const PredictionIndex number, Index_* const buffer) const {
+        const Index_ first = my_offset + start;
+        for (PredictionIndex i = 0; i < number; ++i) {
+            buffer[i] = first + i;
+        }
+        return buffer;
+    }
+
+    bool is_consecutive() const {
+        return true;
+    }
+
 private:
     Index_ my_offset;
     PredictionIndex my_length;
@@ -0,0 +1,65 @@
+#ifndef TATAMI_DEFAULT_INIT_ALLOCATOR_HPP
+#define TATAMI_DEFAULT_INIT_ALLOCATOR_HPP
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file DefaultInitAllocator.hpp
+ * @brief Allocator that default-initializes its elements.
+ */
+
+namespace tatami {
+
+/**
+ * @brief Allocator that default-initializes its elements.
+ *
+ * @tparam Type_ Type of the elements.
+ * @tparam Base_ Allocator to be adapted.
+ *
+ * This adapts an existing allocator so that elements constructed without arguments are default-initialized instead of value-initialized.
+ * For arithmetic types, this means that `std::vector<Type_, DefaultInitAllocator<Type_> > x(n)` does not write zeros to the allocated memory.
+ * This is useful when all elements will be overwritten anyway, e.g., by the workers in `convert_to_dense()`.
+ * In particular, it allows the pages of a large allocation to be first touched by the worker threads that populate them,
+ * so that each page is placed on the NUMA node of the thread that will use it.
+ */
+template<typename Type_, class Base_ = std::allocator<Type_> >
+class DefaultInitAllocator : public Base_ {
+private:
+    typedef std::allocator_traits<Base_> Traits;
+
+public:
+    /**
+     * @cond
+     */
+    template<typename Other_>
+    struct rebind {
+        typedef DefaultInitAllocator<Other_, typename Traits::template rebind_alloc<Other_> > other;
+    };
+
+    using Base_::Base_;
+
+    DefaultInitAllocator() = default;
+
+    template<typename Other_, class OtherBase_>
+    DefaultInitAllocator(const DefaultInitAllocator<Other_, OtherBase_>& other) noexcept : Base_(static_cast<const OtherBase_&>(other)) {}
+
+    template<typename Other_>
+    void construct(Other_* const ptr) noexcept(std::is_nothrow_default_constructible<Other_>::value) {
+        ::new(static_cast<void*>(ptr)) Other_;
+    }
+
+    template<typename Other_, typename ... Args_>
+    void construct(Other_* const ptr, Args_&& ... args) {
+        Traits::construct(static_cast<Base_&>(*this), ptr, std::forward<Args_>(args)...);
+    }
+    /**
+     * @endcond
+     */
+};
+
+}
+
+#endif
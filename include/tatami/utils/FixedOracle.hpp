@@ -2,9 +2,12 @@
 #define TATAMI_FIXED_ORACLE_HPP
 
 #include "../base/Oracle.hpp"
+#include "has_data.hpp"
 
 #include <vector>
 #include <cstddef>
+#include <type_traits>
+#include <utility>
 
 #include "sanisizer/sanisizer.hpp"
 
@@ -16,6 +19,20 @@
 
 namespace tatami {
 
+/**
+ * @cond
+ */
+namespace FixedOracle_internal {
+
+// Whether element access yields a reference to an Index_ in contiguous storage, in which case span() can return a pointer to it directly.
+template<typename Index_, class Pointer_>
+constexpr bool is_direct_pointer = std::is_same<decltype(std::declval<const Pointer_&>()[0]), const Index_&>::value || std::is_same<decltype(std::declval<const Pointer_&>()[0]), Index_&>::value;
+
+}
+/**
+ * @endcond
+ */
+
 /**
  * @tparam Index_ Integer type of the row/column indices.
  * @tparam Pointer_ Pointer type to the array of indices.
@@ -42,6 +59,14 @@ public:
         return my_reference[i];
     }
 
+    const Index_* span(const PredictionIndex start, const PredictionIndex number, Index_* const buffer) const {
+        if constexpr(FixedOracle_internal::is_direct_pointer<Index_, Pointer_>) {
+            return &(my_reference[start]);
+        } else {
+            return Oracle<Index_>::span(start, number, buffer);
+        }
+    }
+
 private:
     Pointer_ my_reference;
     PredictionIndex my_length;
@@ -72,6 +97,14 @@ public:
         return my_sequence[i];
     }
 
+    const Index_* span(const PredictionIndex start, const PredictionIndex number, Index_* const buffer) const {
+        if constexpr(has_data<Index_, const Container_>::value) {
+            return my_sequence.data() + start;
+        } else {
+            return Oracle<Index_>::span(start, number, buffer);
+        }
+    }
+
 private:
     Container_ my_sequence;
 };
@@ -0,0 +1,402 @@
+#ifndef TATAMI_REORDERED_EXTRACTION_HPP
+#define TATAMI_REORDERED_EXTRACTION_HPP
+
+#include <vector>
+#include <memory>
+#include <numeric>
+#include <algorithm>
+#include <utility>
+#include <stdexcept>
+#include <cstddef>
+
+#include "../base/Matrix.hpp"
+#include "../base/SparseRange.hpp"
+#include "new_extractor.hpp"
+#include "ConsecutiveOracle.hpp"
+#include "FixedOracle.hpp"
+#include "ArrayView.hpp"
+#include "copy.hpp"
+#include "Index_to_container.hpp"
+
+#include "sanisizer/sanisizer.hpp"
+
+/**
+ * @file ReorderedExtraction.hpp
+ * @brief Extract an arbitrary sequence of rows/columns in a storage-friendly order.
+ */
+
+namespace tatami {
+
+/**
+ * @brief Options for `ReorderedDenseExtraction` and `ReorderedSparseExtraction`.
+ */
+struct ReorderedExtractionOptions {
+    /**
+     * Maximum number of rows/columns to hold in the reorder buffer for in-order delivery with `fetch()`.
+     * The requested sequence is split into consecutive chunks of this size, and the requests within each chunk are sorted before extraction.
+     * Larger values yield a more storage-friendly access pattern at the cost of memory usage.
+     * If zero, all requests are sorted together, which is recommended when results are only obtained with `fetch_unordered()`.
+     */
+    std::size_t buffer_size = 100;
+};
+
+/**
+ * @cond
+ */
+namespace ReorderedExtraction_internal {
+
+template<typename Index_>
+struct Plan {
+    // Unique indices to extract, in order of extraction.
+    std::vector<Index_> order;
+
+    // For each request, the slot of the reorder buffer containing its result.
+    std::vector<std::size_t> slots;
+
+    // Number of extractions performed at the end of each chunk.
+    std::vector<std::size_t> chunk_ends;
+
+    // Positions in the requested sequence for each extraction, in compressed form.
+    std::vector<std::size_t> position_starts;
+    std::vector<std::size_t> positions;
+
+    std::size_t chunk_size = 0;
+};
+
+template<typename Index_>
+Plan<Index_> create_plan(const std::vector<Index_>& requested, const std::size_t buffer_size) {
+    Plan<Index_> plan;
+    const auto nrequests = requested.size();
+    plan.chunk_size = (buffer_size == 0 || buffer_size > nrequests ? nrequests : buffer_size);
+    plan.slots.resize(nrequests);
+    plan.positions.reserve(nrequests);
+    plan.position_starts.push_back(0);
+
+    std::vector<std::size_t> permutation;
+    for (std::size_t chunk_start = 0; chunk_start < nrequests; chunk_start += plan.chunk_size) {
+        const auto chunk_end = chunk_start + std::min(plan.chunk_size, nrequests - chunk_start);
+        permutation.resize(chunk_end - chunk_start);
+        std::iota(permutation.begin(), permutation.end(), chunk_start);
+
+        // Stable sort so that the positions for duplicated requests are reported in increasing order.
+        std::stable_sort(permutation.begin(), permutation.end(), [&](const std::size_t l, const std::size_t r) -> bool {
+            return requested[l] < requested[r];
+        });
+
+        const auto first_extraction = plan.order.size();
+        for (const auto p : permutation) {
+            const auto current = requested[p];
+            if (plan.order.size() == first_extraction || plan.order.back() != current) {
+                if (plan.order.size() != first_extraction) {
+                    plan.position_starts.push_back(plan.positions.size());
+                }
+                plan.order.push_back(current);
+            }
+            plan.slots[p] = plan.order.size() - 1 - first_extraction;
+            plan.positions.push_back(p);
+        }
+        plan.position_starts.push_back(plan.positions.size());
+        plan.chunk_ends.push_back(plan.order.size());
+    }
+
+    return plan;
+}
+
+template<typename Index_>
+std::shared_ptr<const Oracle<Index_> > create_oracle(const std::vector<Index_>& order) {
+    const auto num = order.size();
+    if (num) {
+        bool consecutive = true;
+        for (std::size_t i = 1; i < num; ++i) {
+            if (order[i] != order[i - 1] + 1) {
+                consecutive = false;
+                break;
+            }
+        }
+        if (consecutive) {
+            return std::make_shared<ConsecutiveOracle<Index_> >(order.front(), num);
+        }
+    }
+    return std::make_shared<FixedViewOracle<Index_> >(order.data(), num);
+}
+
+inline void check_remaining(const std::size_t used, const std::size_t total) {
+    if (used >= total) {
+        throw std::runtime_error("all requests have already been fetched");
+    }
+}
+
+}
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Extract an arbitrary sequence of dense rows/columns in a storage-friendly order.
+ *
+ * @tparam Value_ Data value type, should be numeric.
+ * @tparam Index_ Row/column index type, should be integer.
+ *
+ * Users may request rows/columns in an order that is unrelated to their storage, e.g., cells sorted by cluster.
+ * Passing this sequence directly to a `FixedVectorOracle` forces the backend to jump around in memory or on disk.
+ * Instead, this class sorts the requests (possibly in chunks, see `ReorderedExtractionOptions::buffer_size`), removes duplicates,
+ * and extracts the unique rows/columns in increasing order with an oracular extractor.
+ * The results can then be obtained in one of two ways:
+ *
+ * - `fetch()` returns the results in the requested order.
+ *   This uses a reorder buffer that holds the results for one chunk of requests at a time.
+ * - `fetch_unordered()` returns the results in the extraction order, along with the positions of the corresponding requests in the requested sequence.
+ *   This avoids the reorder buffer, allowing callers to scatter the results directly to their final destination.
+ *
+ * Only one of these methods should be used for any given instance of this class.
+ */
+template<typename Value_, typename Index_>
+class ReorderedDenseExtraction {
+public:
+    /**
+     * @tparam Args_ Types of further arguments to pass to `new_extractor()`.
+     *
+     * @param matrix The matrix to extract from.
+     * This should outlive the constructed instance.
+     * @param row Whether to extract rows.
+     * @param requested Sequence of requested row (if `row = true`) or column indices.
+     * This may be unsorted and contain duplicates.
+     * @param options Further options.
+     * @param args Further arguments to pass to `new_extractor()`, e.g., to extract a block or subset of the non-target dimension.
+     */
+    template<typename ... Args_>
+    ReorderedDenseExtraction(
+        const Matrix<Value_, Index_>& matrix,
+        const bool row,
+        const std::vector<Index_>& requested,
+        const ReorderedExtractionOptions& options,
+        Args_&& ... args
+    ) :
+        my_plan(ReorderedExtraction_internal::create_plan(requested, options.buffer_size)),
+        my_extent(new_extractor_internal::extraction_extent(matrix, row, args...)),
+        my_ext(new_extractor<false, true>(matrix, row, ReorderedExtraction_internal::create_oracle(my_plan.order), std::forward<Args_>(args)...))
+    {}
+
+public:
+    /**
+     * @return Number of requests, i.e., the number of times that `fetch()` can be called.
+     */
+    std::size_t total() const {
+        return my_plan.slots.size();
+    }
+
+    /**
+     * @return Number of extractions, i.e., the number of times that `fetch_unordered()` can be called.
+     * This is equal to the number of unique requests if `ReorderedExtractionOptions::buffer_size` is zero;
+     * otherwise, the same row/column may be extracted once for each chunk in which it is requested.
+     */
+    std::size_t total_unordered() const {
+        return my_plan.order.size();
+    }
+
+    /**
+     * @param buffer Pointer to an array of length no less than the extraction extent.
+     * This is only used in `fetch_unordered()` and is provided here for consistency.
+     *
+     * @return Pointer to an array containing the contents of the next row/column in the requested sequence.
+     * This may not be equal to `buffer` and is only valid until the next call to `fetch()`.
+     */
+    const Value_* fetch([[maybe_unused]] Value_* const buffer) {
+        ReorderedExtraction_internal::check_remaining(my_delivered, my_plan.slots.size());
+        if (my_delivered == my_chunk_limit) {
+            load_chunk();
+        }
+        const auto slot = my_plan.slots[my_delivered];
+        ++my_delivered;
+        return my_reorder_buffer.data() + sanisizer::product_unsafe<std::size_t>(slot, my_extent);
+    }
+
+    /**
+     * @param buffer Pointer to an array of length no less than the extraction extent.
+     *
+     * @return Pair containing a pointer to the contents of the next unique row/column in the extraction order,
+     * and the positions of the requests for that row/column in the requested sequence (in increasing order).
+     * The pointer may not be equal to `buffer`.
+     */
+    std::pair<const Value_*, ArrayView<std::size_t> > fetch_unordered(Value_* const buffer) {
+        ReorderedExtraction_internal::check_remaining(my_extracted, my_plan.order.size());
+        const auto ptr = my_ext->fetch(buffer);
+        const auto pstart = my_plan.position_starts[my_extracted];
+        const auto pend = my_plan.position_starts[my_extracted + 1];
+        ++my_extracted;
+        return std::make_pair(ptr, ArrayView<std::size_t>(my_plan.positions.data() + pstart, pend - pstart));
+    }
+
+private:
+    ReorderedExtraction_internal::Plan<Index_> my_plan;
+    Index_ my_extent;
+    std::unique_ptr<OracularDenseExtractor<Value_, Index_> > my_ext;
+
+    std::size_t my_extracted = 0;
+    std::size_t my_delivered = 0;
+    std::size_t my_chunk_limit = 0;
+    std::size_t my_chunk = 0;
+    std::vector<Value_> my_reorder_buffer;
+
+    void load_chunk() {
+        if (my_reorder_buffer.empty()) {
+            my_reorder_buffer.resize(sanisizer::product<decltype(my_reorder_buffer.size())>(my_plan.chunk_size, attest_for_Index(my_extent)));
+        }
+
+        const auto chunk_end = my_plan.chunk_ends[my_chunk];
+        for (std::size_t s = 0; my_extracted < chunk_end; ++s) {
+            const auto dest = my_reorder_buffer.data() + sanisizer::product_unsafe<std::size_t>(s, my_extent);
+            const auto ptr = my_ext->fetch(dest);
+            copy_n(ptr, my_extent, dest);
+            ++my_extracted;
+        }
+
+        ++my_chunk;
+        my_chunk_limit = std::min(my_plan.slots.size(), my_chunk_limit + my_plan.chunk_size);
+    }
+};
+
+/**
+ * @brief Extract an arbitrary sequence of sparse rows/columns in a storage-friendly order.
+ *
+ * @tparam Value_ Data value type, should be numeric.
+ * @tparam Index_ Row/column index type, should be integer.
+ *
+ * Sparse counterpart to `ReorderedDenseExtraction`.
+ */
+template<typename Value_, typename Index_>
+class ReorderedSparseExtraction {
+public:
+    /**
+     * @tparam Args_ Types of further arguments to pass to `new_extractor()`.
+     *
+     * @param matrix The matrix to extract from.
+     * This should outlive the constructed instance.
+     * @param row Whether to extract rows.
+     * @param requested Sequence of requested row (if `row = true`) or column indices.
+     * This may be unsorted and contain duplicates.
+     * @param options Further options.
+     * @param args Further arguments to pass to `new_extractor()`, e.g., to extract a block or subset of the non-target dimension.
+     */
+    template<typename ... Args_>
+    ReorderedSparseExtraction(
+        const Matrix<Value_, Index_>& matrix,
+        const bool row,
+        const std::vector<Index_>& requested,
+        const ReorderedExtractionOptions& options,
+        Args_&& ... args
+    ) :
+        my_plan(ReorderedExtraction_internal::create_plan(requested, options.buffer_size)),
+        my_extent(new_extractor_internal::extraction_extent(matrix, row, args...)),
+        my_ext(new_extractor<true, true>(matrix, row, ReorderedExtraction_internal::create_oracle(my_plan.order), std::forward<Args_>(args)...))
+    {}
+
+public:
+    /**
+     * @return Number of requests, i.e., the number of times that `fetch()` can be called.
+     */
+    std::size_t total() const {
+        return my_plan.slots.size();
+    }
+
+    /**
+     * @return Number of extractions, i.e., the number of times that `fetch_unordered()` can be called.
+     * This is equal to the number of unique requests if `ReorderedExtractionOptions::buffer_size` is zero;
+     * otherwise, the same row/column may be extracted once for each chunk in which it is requested.
+     */
+    std::size_t total_unordered() const {
+        return my_plan.order.size();
+    }
+
+    /**
+     * @param value_buffer Pointer to an array of length no less than the extraction extent.
+     * This is only used in `fetch_unordered()` and is provided here for consistency.
+     * @param index_buffer Pointer to an array of length no less than the extraction extent.
+     * This is only used in `fetch_unordered()` and is provided here for consistency.
+     *
+     * @return Contents of the next row/column in the requested sequence.
+     * The pointers in the `SparseRange` may not refer to the buffers and are only valid until the next call to `fetch()`.
+     */
+    SparseRange<Value_, Index_> fetch([[maybe_unused]] Value_* const value_buffer, [[maybe_unused]] Index_* const index_buffer) {
+        ReorderedExtraction_internal::check_remaining(my_delivered, my_plan.slots.size());
+        if (my_delivered == my_chunk_limit) {
+            load_chunk();
+        }
+        const auto slot = my_plan.slots[my_delivered];
+        ++my_delivered;
+
+        const auto offset = sanisizer::product_unsafe<std::size_t>(slot, my_extent);
+        return SparseRange<Value_, Index_>(
+            my_numbers[slot],
+            (my_needs_value ? my_value_buffer.data() + offset : NULL),
+            (my_needs_index ? my_index_buffer.data() + offset : NULL)
+        );
+    }
+
+    /**
+     * @param value_buffer Pointer to an array of length no less than the extraction extent.
+     * @param index_buffer Pointer to an array of length no less than the extraction extent.
+     *
+     * @return Pair containing the contents of the next unique row/column in the extraction order,
+     * and the positions of the requests for that row/column in the requested sequence (in increasing order).
+     * The pointers in the `SparseRange` may not refer to the buffers.
+     */
+    std::pair<SparseRange<Value_, Index_>, ArrayView<std::size_t> > fetch_unordered(Value_* const value_buffer, Index_* const index_buffer) {
+        ReorderedExtraction_internal::check_remaining(my_extracted, my_plan.order.size());
+        const auto range = my_ext->fetch(value_buffer, index_buffer);
+        const auto pstart = my_plan.position_starts[my_extracted];
+        const auto pend = my_plan.position_starts[my_extracted + 1];
+        ++my_extracted;
+        return std::make_pair(range, ArrayView<std::size_t>(my_plan.positions.data() + pstart, pend - pstart));
+    }
+
+private:
+    ReorderedExtraction_internal::Plan<Index_> my_plan;
+    Index_ my_extent;
+    std::unique_ptr<OracularSparseExtractor<Value_, Index_> > my_ext;
+
+    std::size_t my_extracted = 0;
+    std::size_t my_delivered = 0;
+    std::size_t my_chunk_limit = 0;
+    std::size_t my_chunk = 0;
+    std::vector<Value_> my_value_buffer;
+    std::vector<Index_> my_index_buffer;
+    std::vector<Index_> my_numbers;
+    bool my_needs_value = false, my_needs_index = false;
+
+    void load_chunk() {
+        if (my_numbers.empty()) {
+            const auto full = sanisizer::product<std::size_t>(my_plan.chunk_size, attest_for_Index(my_extent));
+            my_value_buffer.resize(sanisizer::cast<decltype(my_value_buffer.size())>(full));
+            my_index_buffer.resize(sanisizer::cast<decltype(my_index_buffer.size())>(full));
+            my_numbers.resize(sanisizer::cast<decltype(my_numbers.size())>(my_plan.chunk_size));
+        }
+
+        const auto chunk_end = my_plan.chunk_ends[my_chunk];
+        for (std::size_t s = 0; my_extracted < chunk_end; ++s) {
+            const auto offset = sanisizer::product_unsafe<std::size_t>(s, my_extent);
+            const auto vdest = my_value_buffer.data() + offset;
+            const auto idest = my_index_buffer.data() + offset;
+            const auto range = my_ext->fetch(vdest, idest);
+
+            // Whether values or indices are extracted is fixed by the options, so this is the same for all calls.
+            my_needs_value = (range.value != NULL);
+            my_needs_index = (range.index != NULL);
+            if (my_needs_value) {
+                copy_n(range.value, range.number, vdest);
+            }
+            if (my_needs_index) {
+                copy_n(range.index, range.number, idest);
+            }
+            my_numbers[s] = range.number;
+            ++my_extracted;
+        }
+
+        ++my_chunk;
+        my_chunk_limit = std::min(my_plan.slots.size(), my_chunk_limit + my_plan.chunk_size);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,251 @@
+#ifndef TATAMI_THREAD_POOL_HPP
+#define TATAMI_THREAD_POOL_HPP
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <memory>
+
+/**
+ * @file ThreadPool.hpp
+ * @brief Persistent thread pool for `parallelize()`.
+ */
+
+namespace tatami {
+
+/**
+ * @brief Persistent thread pool for `parallelize()`.
+ *
+ * This class maintains a set of threads that persist across calls to `run()`, avoiding the cost of creating new threads for every call.
+ * It is intended for applications that call `parallelize()` many times on small amounts of work, e.g., per-gene or per-batch loops.
+ * To use the pool in all calls to `parallelize()`, pass it to `set_parallelize_thread_pool()`.
+ *
+ * The splitting of tasks into ranges is deterministic and identical to the default behavior of `parallelize()`,
+ * i.e., each worker ID in `[0, K)` always receives the same contiguous range for the same number of tasks and workers.
+ * However, the thread that executes each range is chosen dynamically,
+ * as idle threads (including the calling thread) claim the next unprocessed range of the current job.
+ * This means that nested calls to `run()` from within a job are safe,
+ * as the calling thread will process any ranges that are not claimed by the other threads.
+ *
+ * All threads are stopped and joined when the pool is destroyed.
+ * Any calls to `run()` should be completed before the pool is destroyed.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param num_threads Number of threads in the pool.
+     * The thread that calls `run()` will also process tasks, so only `num_threads - 1` additional threads are created.
+     * This should be positive.
+     */
+    ThreadPool(const int num_threads) {
+        try {
+            for (int t = 1; t < num_threads; ++t) {
+                my_threads.emplace_back([&]() -> void { loop(); });
+            }
+        } catch (...) {
+            // The destructor will not be called if construction fails, so we need to stop the threads that were already started.
+            shutdown();
+            throw;
+        }
+    }
+
+    /**
+     * @cond
+     */
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    ~ThreadPool() {
+        shutdown();
+    }
+    /**
+     * @endcond
+     */
+
+private:
+    struct Job {
+        std::function<void(int)> run;
+        int num_ranges;
+        std::atomic<int> next{0};
+
+        std::mutex mut;
+        std::condition_variable cv;
+        int finished = 0;
+        std::exception_ptr error;
+    };
+
+    std::vector<std::thread> my_threads;
+    std::mutex my_mut;
+    std::condition_variable my_cv;
+    std::deque<std::shared_ptr<Job> > my_queue;
+    bool my_stop = false;
+
+    // Returns false if there are no more ranges to be claimed in this job.
+    static bool process(Job& job) {
+        const int r = job.next.fetch_add(1);
+        if (r >= job.num_ranges) {
+            return false;
+        }
+
+        std::exception_ptr error;
+        try {
+            job.run(r);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lck(job.mut);
+            if (error && !job.error) {
+                job.error = error;
+            }
+            ++job.finished;
+            if (job.finished == job.num_ranges) {
+                job.cv.notify_all();
+            }
+        }
+        return true;
+    }
+
+    void retire(const std::shared_ptr<Job>& job) {
+        std::lock_guard<std::mutex> lck(my_mut);
+        for (auto it = my_queue.begin(); it != my_queue.end(); ++it) {
+            if (*it == job) {
+                my_queue.erase(it);
+                break;
+            }
+        }
+    }
+
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lck(my_mut);
+            my_stop = true;
+        }
+        my_cv.notify_all();
+        for (auto& thread : my_threads) {
+            thread.join();
+        }
+    }
+
+    void loop() {
+        while (true) {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lck(my_mut);
+                my_cv.wait(lck, [&]() -> bool { return my_stop || !my_queue.empty(); });
+                if (my_stop) {
+                    return;
+                }
+                job = my_queue.front();
+            }
+
+            while (process(*job)) {}
+            retire(job);
+        }
+    }
+
+public:
+    /**
+     * @return Number of threads in the pool, including the calling thread.
+     */
+    int num_threads() const {
+        return my_threads.size() + 1;
+    }
+
+    /**
+     * Run a function on a set of tasks using the threads in the pool.
+     * This has the same interface and behavior as `parallelize()` with `parallel_ = true`.
+     * The number of workers may be greater than the number of threads, in which case some threads will process multiple ranges.
+     *
+     * @tparam Function_ Function to be applied for a contiguous range of tasks, see `parallelize()` for details.
+     * @tparam Index_ Integer type for the number of tasks.
+     *
+     * @param fun Function that executes a contiguous range of tasks.
+     * @param tasks Number of tasks.
+     * This should be non-negative.
+     * @param workers Number of workers.
+     * This should be positive.
+     *
+     * @return The number of workers that were actually used.
+     * If any call to `fun` throws an exception, the first exception is rethrown after all ranges are processed.
+     */
+    template<class Function_, typename Index_>
+    int run(Function_ fun, const Index_ tasks, const int workers) {
+        if (tasks <= 0 || workers <= 0) {
+            return 0;
+        }
+
+        // Same splitting as subpar::parallelize_range(), so that each worker ID always gets the same range.
+        const Index_ worker_size = tasks / workers;
+        const Index_ remainder = tasks % workers;
+        const int num_ranges = (worker_size > 0 ? workers : static_cast<int>(remainder));
+
+        auto job = std::make_shared<Job>();
+        job->num_ranges = num_ranges;
+        job->run = [&](const int w) -> void {
+            const Index_ ww = w;
+            const Index_ start = worker_size * ww + (ww < remainder ? ww : remainder);
+            const Index_ length = worker_size + (ww < remainder);
+            fun(w, start, length);
+        };
+
+        if (num_ranges > 1 && !my_threads.empty()) {
+            {
+                std::lock_guard<std::mutex> lck(my_mut);
+                my_queue.push_back(job);
+            }
+            my_cv.notify_all();
+        }
+
+        while (process(*job)) {}
+        retire(job);
+
+        std::unique_lock<std::mutex> lck(job->mut);
+        job->cv.wait(lck, [&]() -> bool { return job->finished == job->num_ranges; });
+        if (job->error) {
+            std::rethrow_exception(job->error);
+        }
+
+        return num_ranges;
+    }
+};
+
+/**
+ * @cond
+ */
+inline std::shared_ptr<ThreadPool>& parallelize_thread_pool() {
+    static std::shared_ptr<ThreadPool> pool;
+    return pool;
+}
+/**
+ * @endcond
+ */
+
+/**
+ * Set a thread pool to be used in all subsequent calls to `parallelize()` with `parallel_ = true`.
+ * This allows applications to use a persistent thread pool without defining `TATAMI_CUSTOM_PARALLEL`.
+ * (If `TATAMI_CUSTOM_PARALLEL` is defined, the thread pool is ignored.)
+ *
+ * The global pool pointer is read and written without any synchronization.
+ * Thus, this function must not be called concurrently with itself or with `parallelize()` in other threads,
+ * i.e., the application should set the pool before starting any parallel work and should not reset it until all such work has finished.
+ * Each call to `parallelize()` holds its own reference to the pool, so the pool remains alive until that call returns.
+ *
+ * @param pool Pointer to a thread pool.
+ * This may be a null pointer, in which case `parallelize()` reverts to its default behavior.
+ */
+inline void set_parallelize_thread_pool(std::shared_ptr<ThreadPool> pool) {
+    parallelize_thread_pool() = std::move(pool);
+}
+
+}
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef TATAMI_GATHER_HPP
+#define TATAMI_GATHER_HPP
+
+#include "../base/Matrix.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <cstddef>
+
+/**
+ * @file gather.hpp
+ * @brief Utility to gather values at a fixed set of indices.
+ */
+
+namespace tatami {
+
+/**
+ * @brief Gather values at a fixed set of indices.
+ *
+ * This is intended for extractors that need to repeatedly collect values from a source array at the same set of indices,
+ * e.g., for each row of a matrix when a column subset has been requested.
+ * The indices themselves are not copied, so the same set of indices can be cheaply shared across many extractors.
+ * On construction, the indices are scanned for runs of consecutive values.
+ * If the runs are long enough on average, each call to `gather()` copies the runs as contiguous blocks.
+ * Otherwise, values are gathered one at a time in a simple loop over the indices, which compilers can vectorize with gather instructions where available.
+ *
+ * @tparam Index_ Integer type of the indices.
+ */
+template<typename Index_>
+class GatherIndices {
+public:
+    /**
+     * @param indices Pointer to a vector of indices, possibly unsorted and/or duplicated.
+     * Ownership is shared with this `GatherIndices` instance, so no copy of the indices is made.
+     * @param min_run_length Minimum average length of the runs of consecutive indices for gathering via block copies.
+     */
+    GatherIndices(VectorPtr<Index_> indices, const std::size_t min_run_length = 4) :
+        my_indices(indices->data()), my_number(indices->size()), my_owner(std::move(indices))
+    {
+        find_runs(min_run_length);
+    }
+
+    /**
+     * @param indices Pointer to an array of indices, possibly unsorted and/or duplicated.
+     * This is not copied and should remain valid for the lifetime of this `GatherIndices` instance and any of its copies.
+     * @param number Number of indices in `indices`.
+     * @param min_run_length Minimum average length of the runs of consecutive indices for gathering via block copies.
+     */
+    GatherIndices(const Index_* const indices, const std::size_t number, const std::size_t min_run_length = 4) : my_indices(indices), my_number(number) {
+        find_runs(min_run_length);
+    }
+
+    /**
+     * Default constructor, equivalent to an empty set of indices.
+     */
+    GatherIndices() = default;
+
+private:
+    const Index_* my_indices = NULL;
+    std::size_t my_number = 0;
+    VectorPtr<Index_> my_owner;
+    std::vector<Index_> my_run_starts, my_run_lengths;
+
+    void find_runs(const std::size_t min_run_length) {
+        const auto n = my_number;
+        std::size_t nruns = (n > 0);
+        for (std::size_t i = 1; i < n; ++i) {
+            nruns += (my_indices[i] != my_indices[i - 1] + 1);
+        }
+
+        if (nruns && n / nruns >= min_run_length) {
+            my_run_starts.reserve(nruns);
+            my_run_lengths.reserve(nruns);
+            my_run_starts.push_back(my_indices[0]);
+            my_run_lengths.push_back(1);
+            for (std::size_t i = 1; i < n; ++i) {
+                if (my_indices[i] != my_indices[i - 1] + 1) {
+                    my_run_starts.push_back(my_indices[i]);
+                    my_run_lengths.push_back(1);
+                } else {
+                    ++(my_run_lengths.back());
+                }
+            }
+        }
+    }
+
+public:
+    /**
+     * @return Number of indices, i.e., the number of values to be gathered in each call to `gather()`.
+     */
+    std::size_t size() const {
+        return my_number;
+    }
+
+    /**
+     * @return Whether `gather()` will copy runs of consecutive indices as contiguous blocks.
+     */
+    bool uses_runs() const {
+        return !my_run_starts.empty();
+    }
+
+    /**
+     * @tparam Source_ Pointer or random-access iterator to the source array.
+     * @tparam Output_ Type of the output values.
+     *
+     * @param source Pointer or iterator to the start of the source array.
+     * This should contain at least `i + 1` addressable elements, where `i` is the largest index.
+     * @param[out] output Pointer to an output array of length equal to `size()`.
+     * This should not overlap with the source array.
+     *
+     * @return `output` is filled with the values of the source array at each index, and is returned.
+     */
+    template<class Source_, typename Output_>
+    Output_* gather(const Source_ source, Output_* const output) const {
+        if (my_run_starts.empty()) {
+            const auto n = my_number;
+            const auto iptr = my_indices;
+            for (std::size_t x = 0; x < n; ++x) {
+                output[x] = source[iptr[x]];
+            }
+        } else {
+            auto copy = output;
+            for (std::size_t r = 0, nruns = my_run_starts.size(); r < nruns; ++r) {
+                const auto len = my_run_lengths[r];
+                std::copy_n(source + my_run_starts[r], len, copy);
+                copy += len;
+            }
+        }
+        return output;
+    }
+};
+
+}
+
+#endif
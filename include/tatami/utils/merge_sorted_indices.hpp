@@ -0,0 +1,186 @@
+#ifndef TATAMI_MERGE_SORTED_INDICES_HPP
+#define TATAMI_MERGE_SORTED_INDICES_HPP
+
+#include <algorithm>
+
+/**
+ * @file merge_sorted_indices.hpp
+ * @brief Utility to merge two sorted arrays of indices.
+ */
+
+namespace tatami {
+
+/**
+ * @cond
+ */
+namespace merge_sorted_indices_internal {
+
+// Find the first position in [pos, end) where indices[position] >= target.
+// This uses an exponential search from 'pos' so that the cost is logarithmic in the distance travelled, not in the length of the array.
+template<typename Index_>
+Index_ gallop(const Index_* const indices, const Index_ pos, const Index_ end, const Index_ target) {
+    if (pos == end || indices[pos] >= target) {
+        return pos;
+    }
+
+    // At each iteration, we know that indices[lower] < target.
+    Index_ lower = pos, upper = end, step = 1;
+    while (step < end - lower) {
+        const Index_ candidate = lower + step;
+        if (indices[candidate] >= target) {
+            upper = candidate;
+            break;
+        }
+        lower = candidate;
+
+        // Clamping to avoid overflow when doubling 'step' for very long arrays.
+        // If 'step' reaches the remaining distance, the loop terminates and we search the rest of the array.
+        const Index_ remaining = end - lower;
+        step = (step > remaining / 2 ? remaining : step * 2);
+    }
+
+    return static_cast<Index_>(std::lower_bound(indices + lower + 1, indices + upper, target) - indices);
+}
+
+template<bool intersect_, bool swapped_, typename Index_, class Both_, class ShortOnly_, class LongOnly_>
+void gallop_merge(
+    const Index_ short_number,
+    const Index_* const short_indices,
+    const Index_ long_number,
+    const Index_* const long_indices,
+    Both_ both,
+    ShortOnly_ short_only,
+    LongOnly_ long_only)
+{
+    auto report_both = [&](const Index_ s, const Index_ l) -> void {
+        if constexpr(swapped_) {
+            both(l, s);
+        } else {
+            both(s, l);
+        }
+    };
+
+    Index_ lpos = 0;
+    for (Index_ s = 0; s < short_number; ++s) {
+        const auto target = short_indices[s];
+        const auto next = gallop(long_indices, lpos, long_number, target);
+
+        if constexpr(!intersect_) {
+            for (; lpos < next; ++lpos) {
+                long_only(lpos);
+            }
+        } else {
+            lpos = next;
+        }
+
+        if (lpos < long_number && long_indices[lpos] == target) {
+            report_both(s, lpos);
+            ++lpos;
+        } else if constexpr(!intersect_) {
+            short_only(s);
+        }
+
+        if constexpr(intersect_) {
+            if (lpos == long_number) {
+                return;
+            }
+        }
+    }
+
+    if constexpr(!intersect_) {
+        for (; lpos < long_number; ++lpos) {
+            long_only(lpos);
+        }
+    }
+}
+
+}
+/**
+ * @endcond
+ */
+
+/**
+ * Ratio of the longer array's length to the shorter array's length, above which `merge_sorted_indices()` switches to a galloping search.
+ */
+constexpr int merge_sorted_indices_gallop_ratio = 8;
+
+/**
+ * Merge two sorted arrays of unique indices, typically the `SparseRange::index` arrays from two sparse extractors.
+ * For each distinct index in the union (or the intersection, if `intersect_ = true`) of the two arrays, the relevant function is called in order of increasing index.
+ *
+ * If one array is much shorter than the other, a galloping (exponential) search is used to find the next match in the longer array.
+ * This reduces the number of comparisons when, e.g., a very sparse mask is multiplied by a much denser matrix.
+ * When `intersect_ = true`, the cost of the merge is then proportional to the length of the shorter array multiplied by a logarithmic factor.
+ * Otherwise, the non-matching entries of the longer array are still reported but without the per-entry comparison of the standard two-pointer merge.
+ *
+ * @tparam intersect_ Whether to only report indices that are present in both arrays.
+ * @tparam Index_ Integer type for the row/column indices.
+ * @tparam Both_ Function to call for an index that is present in both arrays.
+ * @tparam LeftOnly_ Function to call for an index that is only present in the left array.
+ * @tparam RightOnly_ Function to call for an index that is only present in the right array.
+ *
+ * @param left_number Length of the left array.
+ * @param left_indices Pointer to the left array of sorted and unique indices.
+ * @param right_number Length of the right array.
+ * @param right_indices Pointer to the right array of sorted and unique indices.
+ * @param both Function that accepts two arguments, the position on the left array and the position on the right array of an index that is present in both arrays.
+ * @param left_only Function that accepts the position on the left array of an index that is absent from the right array.
+ * This is never called if `intersect_ = true`.
+ * @param right_only Function that accepts the position on the right array of an index that is absent from the left array.
+ * This is never called if `intersect_ = true`.
+ */
+template<bool intersect_, typename Index_, class Both_, class LeftOnly_, class RightOnly_>
+void merge_sorted_indices(
+    const Index_ left_number,
+    const Index_* const left_indices,
+    const Index_ right_number,
+    const Index_* const right_indices,
+    Both_ both,
+    LeftOnly_ left_only,
+    RightOnly_ right_only)
+{
+    // Checking whether one array is much shorter than the other. We divide
+    // instead of multiplying to avoid overflow for large arrays.
+    if (left_number < right_number / merge_sorted_indices_gallop_ratio) {
+        merge_sorted_indices_internal::gallop_merge<intersect_, false>(left_number, left_indices, right_number, right_indices, both, left_only, right_only);
+        return;
+    }
+    if (right_number < left_number / merge_sorted_indices_gallop_ratio) {
+        merge_sorted_indices_internal::gallop_merge<intersect_, true>(right_number, right_indices, left_number, left_indices, both, right_only, left_only);
+        return;
+    }
+
+    Index_ lcount = 0, rcount = 0;
+    while (lcount < left_number && rcount < right_number) {
+        const auto lidx = left_indices[lcount];
+        const auto ridx = right_indices[rcount];
+        if (lidx < ridx) {
+            if constexpr(!intersect_) {
+                left_only(lcount);
+            }
+            ++lcount;
+        } else if (lidx > ridx) {
+            if constexpr(!intersect_) {
+                right_only(rcount);
+            }
+            ++rcount;
+        } else {
+            both(lcount, rcount);
+            ++lcount;
+            ++rcount;
+        }
+    }
+
+    if constexpr(!intersect_) {
+        for (; lcount < left_number; ++lcount) {
+            left_only(lcount);
+        }
+        for (; rcount < right_number; ++rcount) {
+            right_only(rcount);
+        }
+    }
+}
+
+}
+
+#endif
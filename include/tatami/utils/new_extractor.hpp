@@ -3,6 +3,9 @@
 
 #include "../base/Matrix.hpp"
 
+#include <memory>
+#include <type_traits>
+
 /**
  * @file new_extractor.hpp
  * @brief Templated construction of a new extractor.
@@ -75,6 +78,37 @@ auto new_extractor(const Matrix<Value_, Index_>& matrix, const bool row, MaybeOr
     }
 }
 
+/**
+ * @cond
+ */
+namespace new_extractor_internal {
+
+// Number of elements along the non-target dimension that are extracted by new_extractor() with the same arguments.
+template<typename Value_, typename Index_>
+Index_ extraction_extent(const Matrix<Value_, Index_>& matrix, const bool row) {
+    return (row ? matrix.ncol() : matrix.nrow());
+}
+
+template<typename Value_, typename Index_>
+Index_ extraction_extent(const Matrix<Value_, Index_>& matrix, const bool row, const Options&) {
+    return extraction_extent(matrix, row);
+}
+
+template<typename Value_, typename Index_, typename Start_, typename Length_, typename ... Rest_, typename = std::enable_if_t<std::is_integral<Length_>::value> >
+Index_ extraction_extent(const Matrix<Value_, Index_>&, const bool, const Start_, const Length_ length, Rest_&& ...) {
+    return length;
+}
+
+template<typename Value_, typename Index_, typename Indices_, typename ... Rest_>
+Index_ extraction_extent(const Matrix<Value_, Index_>&, const bool, const std::shared_ptr<Indices_>& indices, Rest_&& ...) {
+    return indices->size();
+}
+
+}
+/**
+ * @endcond
+ */
+
 /**
  * @cond
  */
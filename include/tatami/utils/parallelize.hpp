@@ -6,6 +6,7 @@
 
 #ifndef TATAMI_CUSTOM_PARALLEL
 #include "subpar/subpar.hpp"
+#include "ThreadPool.hpp"
 #endif
 
 /**
@@ -31,6 +32,11 @@ namespace tatami {
  * (See the expectations for the `SUBPAR_CUSTOM_PARALLELIZE_RANGE` macro in `subpar::parallelize_range()` for details.)
  * If `TATAMI_CUSTOM_PARALLEL` is defined and `parallel_ = true`, any call to `parallelize()` will invoke the user-defined scheme instead.
  *
+ * Alternatively, users can supply a persistent `ThreadPool` to `set_parallelize_thread_pool()`.
+ * If `TATAMI_CUSTOM_PARALLEL` is not defined and a pool has been set, any call to `parallelize()` with `parallel_ = true` will use that pool via `ThreadPool::run()`.
+ * This uses the same splitting of tasks into ranges as `subpar::parallelize_range()`.
+ * Setting the pool with `set_parallelize_thread_pool()` must not race with any call to `parallelize()`, see the former's documentation for details.
+ *
  * @tparam parallel_ Whether the tasks should be run in parallel.
  * If `false`, no parallelization is performed and all tasks are run on the current worker.
  * @tparam Function_ Function to be applied for a contiguous range of tasks.
@@ -60,6 +66,11 @@ int parallelize(Function_ fun, const Index_ tasks, const int workers) {
 #ifdef TATAMI_CUSTOM_PARALLEL
         return TATAMI_CUSTOM_PARALLEL(fun, tasks, workers);
 #else
+        // Taking a copy so that the pool stays alive for the duration of this call, even if it is replaced by set_parallelize_thread_pool().
+        const auto pool = parallelize_thread_pool();
+        if (pool) {
+            return pool->run(std::move(fun), tasks, workers);
+        }
         return subpar::parallelize_range(workers, tasks, std::move(fun));
 #endif
     } else {
@@ -0,0 +1,235 @@
+#ifndef TATAMI_PARALLELIZE_NUMA_HPP
+#define TATAMI_PARALLELIZE_NUMA_HPP
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+#include "parallelize.hpp"
+
+#ifdef __linux__
+#include <fstream>
+#include <utility>
+#include <algorithm>
+#include <sched.h>
+#include <dirent.h>
+#endif
+
+/**
+ * @file parallelize_numa.hpp
+ *
+ * @brief NUMA-aware parallelized iteration.
+ */
+
+namespace tatami {
+
+/**
+ * @cond
+ */
+namespace parallelize_numa_internal {
+
+#ifdef __linux__
+// Parsing a CPU list like "0-3,8,10-11".
+inline std::vector<int> parse_cpu_list(const std::string& contents) {
+    std::vector<int> output;
+    std::size_t pos = 0;
+    const auto len = contents.size();
+    while (pos < len) {
+        auto next = contents.find(',', pos);
+        if (next == std::string::npos) {
+            next = len;
+        }
+
+        const auto chunk = contents.substr(pos, next - pos);
+        if (!chunk.empty()) {
+            const auto dash = chunk.find('-');
+            if (dash == std::string::npos) {
+                output.push_back(std::stoi(chunk));
+            } else {
+                const int first = std::stoi(chunk.substr(0, dash));
+                const int last = std::stoi(chunk.substr(dash + 1));
+                for (int c = first; c <= last; ++c) {
+                    output.push_back(c);
+                }
+            }
+        }
+
+        pos = next + 1;
+    }
+    return output;
+}
+
+// Node IDs need not be contiguous (e.g., after memory hot-unplug), so we enumerate all 'node<N>' entries rather than counting up from zero.
+// The returned nodes are ordered by increasing ID.
+inline std::vector<std::vector<int> > read_node_cpus(const std::string& root = "/sys/devices/system/node") {
+    std::vector<std::pair<int, std::vector<int> > > collected;
+
+    DIR* dir = opendir(root.c_str());
+    if (dir == NULL) {
+        return std::vector<std::vector<int> >();
+    }
+
+    try {
+        while (true) {
+            const dirent* entry = readdir(dir);
+            if (entry == NULL) {
+                break;
+            }
+
+            const std::string name(entry->d_name);
+            constexpr std::size_t prefix = 4; // i.e., "node"
+            if (name.size() <= prefix || name.compare(0, prefix, "node") != 0) {
+                continue;
+            }
+            if (name.find_first_not_of("0123456789", prefix) != std::string::npos) {
+                continue;
+            }
+
+            std::ifstream handle(root + "/" + name + "/cpulist");
+            if (!handle) {
+                continue;
+            }
+            std::string line;
+            std::getline(handle, line);
+            collected.emplace_back(std::stoi(name.substr(prefix)), parse_cpu_list(line));
+        }
+    } catch (...) {
+        // Unexpected format, so we just give up on NUMA awareness.
+        collected.clear();
+    }
+    closedir(dir);
+
+    std::sort(collected.begin(), collected.end(), [](const auto& left, const auto& right) -> bool { return left.first < right.first; });
+    std::vector<std::vector<int> > output;
+    output.reserve(collected.size());
+    for (auto& node : collected) {
+        output.push_back(std::move(node.second));
+    }
+    return output;
+}
+
+// Pins the calling thread to a set of CPUs, and restores the original affinity upon destruction.
+class PinGuard {
+public:
+    PinGuard(const std::vector<int>& cpus) {
+        if (sched_getaffinity(0, sizeof(cpu_set_t), &my_original) != 0) {
+            return;
+        }
+
+        // Only using the CPUs that the thread was already allowed to run on, e.g., to respect cgroup or taskset restrictions.
+        cpu_set_t target;
+        CPU_ZERO(&target);
+        bool any = false;
+        for (const auto c : cpus) {
+            if (c >= 0 && c < CPU_SETSIZE && CPU_ISSET(c, &my_original)) {
+                CPU_SET(c, &target);
+                any = true;
+            }
+        }
+
+        if (any) {
+            my_pinned = (sched_setaffinity(0, sizeof(cpu_set_t), &target) == 0);
+        }
+    }
+
+    PinGuard(const PinGuard&) = delete;
+    PinGuard& operator=(const PinGuard&) = delete;
+    PinGuard(PinGuard&&) = delete;
+    PinGuard& operator=(PinGuard&&) = delete;
+
+    ~PinGuard() {
+        if (my_pinned) {
+            sched_setaffinity(0, sizeof(cpu_set_t), &my_original);
+        }
+    }
+
+private:
+    cpu_set_t my_original;
+    bool my_pinned = false;
+};
+#endif
+
+inline const std::vector<std::vector<int> >& node_cpus() {
+#ifdef __linux__
+    static const std::vector<std::vector<int> > nodes = read_node_cpus();
+#else
+    static const std::vector<std::vector<int> > nodes;
+#endif
+    return nodes;
+}
+
+}
+/**
+ * @endcond
+ */
+
+/**
+ * @return Number of NUMA nodes on the current system.
+ * This is obtained from `/sys/devices/system/node` on Linux, and is always 1 on other systems or if the node information is not available.
+ */
+inline int numa_node_count() {
+    const auto& nodes = parallelize_numa_internal::node_cpus();
+    return (nodes.empty() ? 1 : static_cast<int>(nodes.size()));
+}
+
+/**
+ * @param task Index of a task, in `[0, tasks)`.
+ * @param tasks Number of tasks.
+ * This should be positive.
+ *
+ * @return The NUMA node used by `parallelize_numa()` for a range starting at `task`.
+ * Tasks are assigned to nodes in contiguous blocks of approximately equal size,
+ * so that the first `tasks / numa_node_count()` tasks are assigned to node 0, and so on.
+ */
+template<typename Index_>
+int numa_node_for_task(const Index_ task, const Index_ tasks) {
+    const int num_nodes = numa_node_count();
+    return static_cast<int>(static_cast<double>(task) / static_cast<double>(tasks) * num_nodes);
+}
+
+/**
+ * Apply a function to a set of tasks in parallel, where each range of tasks is processed by a thread that is pinned to a fixed NUMA node.
+ * This has the same interface and splitting behavior as `parallelize()`,
+ * except that each call to `fun` temporarily sets the CPU affinity of its thread to the CPUs of the node returned by `numa_node_for_task()` for the start of its range.
+ * The original affinity is restored after `fun` returns.
+ *
+ * The aim is to ensure that memory allocated and first touched within `fun` is placed on the same node for all calls with the same `tasks` and `workers`.
+ * For example, output arrays can be allocated with `DefaultInitAllocator` and initialized in one call to `parallelize_numa()`,
+ * such that subsequent calls to `parallelize_numa()` with the same `tasks` and `workers` will access that memory from the same node.
+ *
+ * Only standard Linux interfaces are used, i.e., `/sys/devices/system/node` and `sched_setaffinity()`.
+ * On systems with only one NUMA node or on non-Linux systems, this function is equivalent to `parallelize()`.
+ * If pinning fails, e.g., because the allowed CPUs for the thread do not include any CPUs from the node, `fun` is run without pinning.
+ *
+ * @tparam parallel_ Whether the tasks should be run in parallel.
+ * If `false`, no parallelization or pinning is performed and all tasks are run on the current worker.
+ * @tparam Function_ Function to be applied for a contiguous range of tasks, see `parallelize()` for details.
+ * @tparam Index_ Integer type for the number of tasks.
+ *
+ * @param fun Function that executes a contiguous range of tasks.
+ * @param tasks Number of tasks.
+ * This should be non-negative.
+ * @param workers Number of workers.
+ * This should be positive.
+ *
+ * @return The number of workers that were actually used, see `parallelize()` for details.
+ */
+template<bool parallel_ = true, class Function_, typename Index_>
+int parallelize_numa(Function_ fun, const Index_ tasks, const int workers) {
+    if constexpr(parallel_) {
+#ifdef __linux__
+        const auto& nodes = parallelize_numa_internal::node_cpus();
+        if (nodes.size() > 1) {
+            return parallelize([&](const int w, const Index_ start, const Index_ length) -> void {
+                parallelize_numa_internal::PinGuard guard(nodes[numa_node_for_task(start, tasks)]);
+                fun(w, start, length);
+            }, tasks, workers);
+        }
+#endif
+    }
+    return parallelize<parallel_>(std::move(fun), tasks, workers);
+}
+
+}
+
+#endif
@@ -0,0 +1,187 @@
+#ifndef TATAMI_PARALLELIZE_WEIGHTED_HPP
+#define TATAMI_PARALLELIZE_WEIGHTED_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include "parallelize.hpp"
+#include "Index_to_container.hpp"
+
+#include "sanisizer/sanisizer.hpp"
+
+/**
+ * @file parallelize_weighted.hpp
+ *
+ * @brief Parallelized iteration with cost-balanced task ranges.
+ */
+
+namespace tatami {
+
+/**
+ * @cond
+ */
+namespace parallelize_weighted_internal {
+
+// 'cumulative(i)' should return the total cost of tasks [0, i), and should be non-decreasing in 'i'.
+template<typename Index_, class Cumulative_>
+std::vector<Index_> define_boundaries(const Index_ tasks, const int num_ranges, Cumulative_ cumulative) {
+    auto boundaries = sanisizer::create<std::vector<Index_> >(sanisizer::sum<std::size_t>(num_ranges, 1));
+    boundaries.back() = tasks;
+
+    const double total = cumulative(tasks);
+    if (!(total > 0)) {
+        // All tasks are free, so every boundary would collapse onto its lower limit and the last range would get everything.
+        // Instead, we fall back to an even split by the number of tasks, with the remainder spread across the first ranges.
+        const Index_ per_range = tasks / num_ranges, remainder = tasks % num_ranges;
+        for (int r = 1; r < num_ranges; ++r) {
+            boundaries[r] = boundaries[r - 1] + per_range + static_cast<Index_>(static_cast<Index_>(r) <= remainder);
+        }
+        return boundaries;
+    }
+
+    Index_ previous = 0;
+    for (int r = 1; r < num_ranges; ++r) {
+        const double target = total * (static_cast<double>(r) / num_ranges);
+
+        // Each range must contain at least one task, so we constrain the search space accordingly.
+        Index_ lower = previous + 1;
+        const Index_ upper = tasks - static_cast<Index_>(num_ranges - r);
+
+        // Finding the first boundary in [lower, upper] where the cumulative cost is not less than the target.
+        Index_ right = upper;
+        while (lower < right) {
+            const Index_ mid = lower + (right - lower) / 2;
+            if (cumulative(mid) < target) {
+                lower = mid + 1;
+            } else {
+                right = mid;
+            }
+        }
+
+        // Stepping back if the preceding boundary is closer to the target.
+        if (lower > previous + 1 && target - cumulative(lower - 1) < cumulative(lower) - target) {
+            --lower;
+        }
+
+        boundaries[r] = lower;
+        previous = lower;
+    }
+
+    return boundaries;
+}
+
+template<bool parallel_, class Function_, typename Index_, class Cumulative_>
+int parallelize_cumulative(Function_ fun, const Index_ tasks, const int workers, Cumulative_ cumulative) {
+    if (tasks <= 0) {
+        return 0;
+    }
+
+    if constexpr(!parallel_) {
+        fun(0, 0, tasks);
+        return 1;
+
+    } else {
+        if (workers <= 1 || tasks == 1) {
+            return parallelize(std::move(fun), tasks, 1);
+        }
+
+        const int num_ranges = (sanisizer::is_greater_than_or_equal(workers, tasks) ? static_cast<int>(tasks) : workers);
+        const auto boundaries = define_boundaries(tasks, num_ranges, std::move(cumulative));
+
+        // Each range is treated as a single task so that worker IDs are still assigned by parallelize().
+        // We merge adjacent ranges in case a custom parallelization scheme assigns multiple tasks to a worker.
+        return parallelize([&](const int w, const int start, const int length) -> void {
+            fun(w, boundaries[start], boundaries[start + length] - boundaries[start]);
+        }, num_ranges, num_ranges);
+    }
+}
+
+}
+/**
+ * @endcond
+ */
+
+/**
+ * Apply a function to a set of tasks in parallel, where the tasks have different computational costs.
+ * This is similar to `parallelize()` except that `[0, tasks)` is split into `K` contiguous ranges with approximately equal total cost, rather than equal length.
+ * The aim is to improve load balancing for, e.g., sparse matrices where a few rows/columns contain most of the non-zero elements.
+ *
+ * The splitting is deterministic for the same `costs`, `tasks` and `workers`.
+ * Each range is guaranteed to contain at least one task.
+ * If all costs are zero, the tasks are split evenly by number instead.
+ *
+ * @tparam parallel_ Whether the tasks should be run in parallel.
+ * If `false`, no parallelization is performed and all tasks are run on the current worker.
+ * @tparam Function_ Function to be applied for a contiguous range of tasks, see `parallelize()` for details.
+ * @tparam Index_ Integer type for the number of tasks.
+ * @tparam Cost_ Numeric type for the cost of each task.
+ *
+ * @param fun Function that executes a contiguous range of tasks.
+ * This will be called no more than once in each worker with a different non-overlapping range, where the union of all ranges will cover `[0, tasks)`.
+ * @param costs Pointer to an array of length `tasks`, containing the non-negative cost of each task.
+ * @param tasks Number of tasks.
+ * This should be non-negative.
+ * @param workers Number of workers.
+ * This should be positive.
+ *
+ * @return The number of workers (`K`) that were actually used.
+ * `K` is guaranteed to be no greater than `workers`.
+ * `fun()` will have been called once for each of the worker IDs `[0, ..., K - 1]`.
+ */
+template<bool parallel_ = true, class Function_, typename Index_, typename Cost_>
+int parallelize_weighted(Function_ fun, const Cost_* const costs, const Index_ tasks, const int workers) {
+    std::vector<double> cumulative;
+    if constexpr(parallel_) {
+        if (workers > 1 && tasks > 1) {
+            cumulative.resize(sanisizer::sum<std::size_t>(attest_for_Index(tasks), 1));
+            for (Index_ t = 0; t < tasks; ++t) {
+                cumulative[t + 1] = cumulative[t] + costs[t];
+            }
+        }
+    }
+
+    return parallelize_weighted_internal::parallelize_cumulative<parallel_>(
+        std::move(fun),
+        tasks,
+        workers,
+        [&](const Index_ i) -> double { return cumulative[i]; }
+    );
+}
+
+/**
+ * Apply a function to a set of tasks in parallel, where the cost of each task is defined from the pointers of a compressed sparse matrix.
+ * Specifically, the cost of task `i` is defined as `pointers[i + 1] - pointers[i] + 1`,
+ * i.e., the number of structural non-zeros in primary dimension element `i` plus a constant overhead for each element.
+ * This is equivalent to calling `parallelize_weighted()` with those costs but avoids the need to allocate a separate array.
+ *
+ * @tparam parallel_ Whether the tasks should be run in parallel.
+ * If `false`, no parallelization is performed and all tasks are run on the current worker.
+ * @tparam Function_ Function to be applied for a contiguous range of tasks, see `parallelize()` for details.
+ * @tparam Index_ Integer type for the number of tasks.
+ * @tparam Pointer_ Integer type for the pointers.
+ *
+ * @param fun Function that executes a contiguous range of tasks.
+ * This will be called no more than once in each worker with a different non-overlapping range, where the union of all ranges will cover `[0, tasks)`.
+ * @param pointers Pointer to an array of length `tasks + 1`, containing the non-decreasing pointers of a compressed sparse matrix (e.g., `CompressedSparseContents::pointers`).
+ * @param tasks Number of tasks, typically the extent of the primary dimension.
+ * This should be non-negative.
+ * @param workers Number of workers.
+ * This should be positive.
+ *
+ * @return The number of workers (`K`) that were actually used.
+ * `K` is guaranteed to be no greater than `workers`.
+ * `fun()` will have been called once for each of the worker IDs `[0, ..., K - 1]`.
+ */
+template<bool parallel_ = true, class Function_, typename Index_, typename Pointer_>
+int parallelize_by_pointers(Function_ fun, const Pointer_* const pointers, const Index_ tasks, const int workers) {
+    return parallelize_weighted_internal::parallelize_cumulative<parallel_>(
+        std::move(fun),
+        tasks,
+        workers,
+        [&](const Index_ i) -> double { return static_cast<double>(pointers[i] - pointers[0]) + static_cast<double>(i); }
+    );
+}
+
+}
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef TATAMI_REDUCE_HPP
+#define TATAMI_REDUCE_HPP
+
+#include <vector>
+#include <optional>
+#include <type_traits>
+
+#include "../base/Matrix.hpp"
+#include "../base/SparseRange.hpp"
+#include "parallelize.hpp"
+#include "consecutive_extractor.hpp"
+#include "Index_to_container.hpp"
+
+#include "sanisizer/sanisizer.hpp"
+
+/**
+ * @file reduce.hpp
+ * @brief Parallel reduction over the contents of a `Matrix`.
+ */
+
+namespace tatami {
+
+/**
+ * @brief Options for `reduce()`.
+ */
+struct ReduceOptions {
+    /**
+     * Number of threads to use, for parallelization with `parallelize()`.
+     */
+    int num_threads = 1;
+
+    /**
+     * Whether the indices in each `SparseRange` passed to the sparse kernel should be sorted.
+     * Setting this to `false` may improve efficiency if the kernel does not care about the order of the structural non-zeros.
+     */
+    bool sparse_ordered_index = true;
+};
+
+/**
+ * @cond
+ */
+namespace reduce_internal {
+
+// Padding each thread's state to its own cache line(s) to avoid false sharing between threads,
+// e.g., if the state is a small object that is frequently updated in place.
+template<class State_>
+struct alignas(64) PaddedState {
+    std::optional<State_> state;
+};
+
+}
+/**
+ * @endcond
+ */
+
+/**
+ * Reduce the contents of a `Matrix` into a single accumulator, using a kernel that is applied to each row or column.
+ * This handles the boilerplate of choosing the iteration direction, creating thread-local accumulators and merging them at the end.
+ *
+ * The iteration direction is chosen based on `Matrix::prefer_rows()`, i.e., the kernel is applied to each row if rows are preferred, and to each column otherwise.
+ * The kernel is informed of the direction so that it can update the accumulator appropriately.
+ * For example, to compute row sums from a column-major matrix, the kernel should add each column's values to a per-row running sum in the accumulator.
+ * This means that reductions over the non-preferred dimension are always performed with efficient access patterns.
+ *
+ * The iteration dimension is split into contiguous ranges with `parallelize()`.
+ * Each worker creates its own accumulator with `create()` and applies the kernel to each row/column in its range, in order of increasing index.
+ * Afterwards, the accumulators from all workers are merged in order of increasing worker ID.
+ * This ensures that the result is deterministic for the same `matrix` and `ReduceOptions::num_threads`, even for non-associative operations like floating-point addition.
+ *
+ * @tparam Value_ Data value type, should be numeric.
+ * @tparam Index_ Row/column index type, should be integer.
+ * @tparam Create_ Function that accepts no arguments and returns an accumulator of type `State`.
+ * @tparam DenseKernel_ Function to apply to each dense row/column.
+ * @tparam SparseKernel_ Function to apply to each sparse row/column.
+ * @tparam Merge_ Function to merge two accumulators.
+ *
+ * @param matrix The matrix to reduce.
+ * @param create Function to create a new accumulator for each worker.
+ * This may be called concurrently from multiple threads.
+ * @param dense_kernel Function to be called if `matrix.is_sparse()` is false.
+ * This should accept four arguments:
+ * - `state`, a reference to a `State` for the current worker.
+ * - `row`, a boolean indicating whether the kernel is being applied to a row.
+ * - `i`, an `Index_` specifying the index of the current row (if `row = true`) or column.
+ * - `values`, a `const Value_*` pointer to an array containing the contents of row/column `i`.
+ *   The length of the array is equal to the number of columns (if `row = true`) or rows.
+ * @param sparse_kernel Function to be called if `matrix.is_sparse()` is true.
+ * This should accept four arguments:
+ * - `state`, a reference to a `State` for the current worker.
+ * - `row`, a boolean indicating whether the kernel is being applied to a row.
+ * - `i`, an `Index_` specifying the index of the current row (if `row = true`) or column.
+ * - `range`, a `const SparseRange<Value_, Index_>&` containing the structural non-zeros of row/column `i`.
+ * @param merge Function that accepts two arguments, a reference to a `State` and an rvalue reference to another `State`.
+ * This should merge the contents of the second accumulator into the first.
+ * It is called in the main thread, with the first argument being the accumulator for worker 0 and the second argument being the accumulators for workers 1, 2, etc. in that order.
+ * @param options Further options.
+ *
+ * @return The merged accumulator.
+ * If `matrix` has no rows or columns along the iteration dimension, this is the result of `create()`.
+ */
+template<typename Value_, typename Index_, class Create_, class DenseKernel_, class SparseKernel_, class Merge_>
+auto reduce(
+    const Matrix<Value_, Index_>& matrix,
+    Create_ create,
+    DenseKernel_ dense_kernel,
+    SparseKernel_ sparse_kernel,
+    Merge_ merge,
+    const ReduceOptions& options
+) {
+    typedef std::remove_cv_t<std::remove_reference_t<decltype(create())> > State;
+
+    const bool row = matrix.prefer_rows();
+    const Index_ primary = (row ? matrix.nrow() : matrix.ncol());
+    const Index_ secondary = (row ? matrix.ncol() : matrix.nrow());
+
+    const int num_threads = (options.num_threads > 1 ? options.num_threads : 1);
+    auto states = sanisizer::create<std::vector<reduce_internal::PaddedState<State> > >(num_threads);
+
+    const bool is_sparse = matrix.is_sparse();
+    const int num_used = parallelize([&](const int thread, const Index_ start, const Index_ length) -> void {
+        auto& current = states[thread].state;
+        current.emplace(create());
+
+        if (is_sparse) {
+            Options opt;
+            opt.sparse_ordered_index = options.sparse_ordered_index;
+            auto ext = consecutive_extractor<true>(matrix, row, start, length, opt);
+            auto vbuffer = create_container_of_Index_size<std::vector<Value_> >(secondary);
+            auto ibuffer = create_container_of_Index_size<std::vector<Index_> >(secondary);
+            for (Index_ i = start, end = start + length; i < end; ++i) {
+                const auto range = ext->fetch(vbuffer.data(), ibuffer.data());
+                sparse_kernel(*current, row, i, range);
+            }
+
+        } else {
+            auto ext = consecutive_extractor<false>(matrix, row, start, length);
+            auto buffer = create_container_of_Index_size<std::vector<Value_> >(secondary);
+            for (Index_ i = start, end = start + length; i < end; ++i) {
+                const auto ptr = ext->fetch(buffer.data());
+                dense_kernel(*current, row, i, static_cast<const Value_*>(ptr));
+            }
+        }
+    }, primary, num_threads);
+
+    if (num_used == 0) {
+        return State(create());
+    }
+
+    State output = std::move(*(states[0].state));
+    for (int t = 1; t < num_used; ++t) {
+        merge(output, std::move(*(states[t].state)));
+    }
+    return output;
+}
+
+/**
+ * Overload of `reduce()` with default options.
+ *
+ * @tparam Value_ Data value type, should be numeric.
+ * @tparam Index_ Row/column index type, should be integer.
+ * @tparam Create_ Function that accepts no arguments and returns an accumulator.
+ * @tparam DenseKernel_ Function to apply to each dense row/column.
+ * @tparam SparseKernel_ Function to apply to each sparse row/column.
+ * @tparam Merge_ Function to merge two accumulators.
+ *
+ * @param matrix The matrix to reduce.
+ * @param create Function to create a new accumulator for each worker.
+ * @param dense_kernel Function to apply to each dense row/column.
+ * @param sparse_kernel Function to apply to each sparse row/column.
+ * @param merge Function to merge two accumulators.
+ *
+ * @return The merged accumulator.
+ */
+template<typename Value_, typename Index_, class Create_, class DenseKernel_, class SparseKernel_, class Merge_>
+auto reduce(const Matrix<Value_, Index_>& matrix, Create_ create, DenseKernel_ dense_kernel, SparseKernel_ sparse_kernel, Merge_ merge) {
+    return reduce(matrix, std::move(create), std::move(dense_kernel), std::move(sparse_kernel), std::move(merge), ReduceOptions());
+}
+
+}
+
+#endif
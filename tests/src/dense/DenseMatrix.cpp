@@ -6,6 +6,7 @@
 
 #include "tatami/dense/DenseMatrix.hpp"
 #include "tatami/utils/copy.hpp"
+#include "tatami/utils/ArrayView.hpp"
 #include "tatami_test/tatami_test.hpp"
 
 TEST(DenseMatrix, Basic) {
@@ -462,3 +463,190 @@ TEST(DenseMatrix, DifferentValueType) {
         }
     }
 }
+
+/*************************************
+ *************************************/
+
+class DenseWindowTest : public ::testing::TestWithParam<std::tuple<bool, tatami_test::StandardTestAccessOptions> > {
+protected:
+    inline static int full_nrow = 50, full_ncol = 40;
+    inline static int row_start = 7, nrow = 31, col_start = 5, ncol = 22;
+    inline static std::vector<double> full;
+
+    static void SetUpTestSuite() {
+        full = tatami_test::simulate_vector<double>(full_nrow, full_ncol, []{
+            tatami_test::SimulateVectorOptions opt;
+            opt.seed = sanisizer::cap<tatami_test::SeedType>(12938712);
+            return opt;
+        }());
+    }
+
+    // Creating a window into 'full' along with a reference matrix containing a copy of the same values.
+    static std::pair<std::shared_ptr<tatami::NumericMatrix>, std::shared_ptr<tatami::NumericMatrix> > create(bool row_major) {
+        const int full_secondary = (row_major ? full_ncol : full_nrow);
+        const int primary_start = (row_major ? row_start : col_start), primary_length = (row_major ? nrow : ncol);
+        const int secondary_start = (row_major ? col_start : row_start), secondary_length = (row_major ? ncol : nrow);
+
+        std::vector<double> copy;
+        for (int p = 0; p < primary_length; ++p) {
+            auto start = full.begin() + sanisizer::nd_offset<std::size_t>(secondary_start, full_secondary, primary_start + p);
+            copy.insert(copy.end(), start, start + secondary_length);
+        }
+
+        tatami::DenseMatrixOptions opt;
+        opt.offset = sanisizer::nd_offset<std::size_t>(secondary_start, full_secondary, primary_start);
+        opt.leading_dimension = full_secondary;
+        tatami::ArrayView<double> view(full.data(), full.size());
+
+        return std::make_pair(
+            std::make_shared<tatami::DenseMatrix<double, int, tatami::ArrayView<double> > >(nrow, ncol, view, row_major, opt),
+            std::make_shared<tatami::DenseMatrix<double, int, std::vector<double> > >(nrow, ncol, std::move(copy), row_major)
+        );
+    }
+};
+
+TEST_P(DenseWindowTest, Access) {
+    auto tparam = GetParam();
+    auto row_major = std::get<0>(tparam);
+    auto opts = tatami_test::convert_test_access_options(std::get<1>(tparam));
+    auto mats = create(row_major);
+    EXPECT_EQ(mats.first->prefer_rows(), row_major);
+
+    tatami_test::test_full_access(*(mats.first), *(mats.second), opts);
+    tatami_test::test_block_access(*(mats.first), *(mats.second), 0.2, 0.6, opts);
+    tatami_test::test_indexed_access(*(mats.first), *(mats.second), 0.1, 0.3, opts);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DenseMatrix,
+    DenseWindowTest,
+    ::testing::Combine(
+        ::testing::Values(true, false), // row major or not.
+        tatami_test::standard_test_access_options_combinations()
+    )
+);
+
+TEST(DenseMatrix, WindowNoCopy) {
+    std::vector<double> contents(200);
+    std::iota(contents.begin(), contents.end(), 0);
+
+    tatami::DenseMatrixOptions opt;
+    opt.offset = 23;
+    opt.leading_dimension = 20;
+    tatami::DenseRowMatrix<double, int, tatami::ArrayView<double> > mat(5, 12, tatami::ArrayView<double>(contents.data(), contents.size()), opt);
+
+    auto wrk = mat.dense_row();
+    std::vector<double> buffer(12);
+    for (int r = 0; r < 5; ++r) {
+        auto ptr = wrk->fetch(r, buffer.data());
+#ifndef TATAMI_DEBUG_FORCE_COPY
+        EXPECT_EQ(ptr, contents.data() + 23 + r * 20);
+#endif
+        EXPECT_EQ(ptr[0], 23 + r * 20);
+        EXPECT_EQ(ptr[11], 34 + r * 20);
+    }
+
+    auto bwrk = mat.dense_row(3, 5);
+    for (int r = 0; r < 5; ++r) {
+        auto ptr = bwrk->fetch(r, buffer.data());
+#ifndef TATAMI_DEBUG_FORCE_COPY
+        EXPECT_EQ(ptr, contents.data() + 26 + r * 20);
+#endif
+        EXPECT_EQ(ptr[0], 26 + r * 20);
+    }
+
+    auto cwrk = mat.dense_column();
+    for (int c = 0; c < 12; ++c) {
+        auto ptr = cwrk->fetch(c, buffer.data());
+        for (int r = 0; r < 5; ++r) {
+            EXPECT_EQ(ptr[r], 23 + r * 20 + c);
+        }
+    }
+}
+
+TEST(DenseMatrix, WindowMaterialize) {
+    std::vector<double> contents(200);
+    std::iota(contents.begin(), contents.end(), 0);
+    std::deque<double> dcontents(contents.begin(), contents.end()); // no data(), to check the fallback.
+
+    tatami::DenseMatrixOptions opt;
+    opt.offset = 23;
+    opt.leading_dimension = 20;
+    tatami::DenseRowMatrix<double, int, tatami::ArrayView<double> > mat(5, 12, tatami::ArrayView<double>(contents.data(), contents.size()), opt);
+    tatami::DenseRowMatrix<double, int, std::deque<double> > dmat(5, 12, dcontents, opt);
+    auto expected = [](int r, int c) -> double { return 23 + r * 20 + c; };
+
+    std::vector<int> row_subset { 4, 0, 2, 2 }, column_subset { 11, 1, 3, 5, 7, 9, 0 };
+    for (int sub = 0; sub < 2; ++sub) {
+        auto rptr = (sub ? &row_subset : NULL);
+        auto cptr = (sub ? &column_subset : NULL);
+        const int NR = (sub ? row_subset.size() : 5), NC = (sub ? column_subset.size() : 12);
+        auto get_row = [&](int r) -> int { return (sub ? row_subset[r] : r); };
+        auto get_col = [&](int c) -> int { return (sub ? column_subset[c] : c); };
+
+        for (int r = 0; r < 2; ++r) {
+            const bool row_major = (r == 0);
+            std::vector<double> store(NR * NC), dstore(NR * NC);
+            mat.subset_materialize(rptr, cptr, row_major, store.data(), 2);
+            dmat.subset_materialize(rptr, cptr, row_major, dstore.data(), 2);
+            EXPECT_EQ(store, dstore);
+            for (int x = 0; x < NR; ++x) {
+                for (int y = 0; y < NC; ++y) {
+                    EXPECT_EQ(store[row_major ? x * NC + y : y * NR + x], expected(get_row(x), get_col(y)));
+                }
+            }
+        }
+
+        auto scanner = mat.subset_scanner(rptr, cptr);
+        EXPECT_TRUE(scanner->by_row());
+        EXPECT_TRUE(scanner->sorted());
+        ASSERT_EQ(scanner->primary(), NR);
+        ASSERT_EQ(scanner->secondary(), NC);
+        std::vector<double> vbuffer(NC);
+        std::vector<int> ibuffer(NC);
+        for (int p = 0; p < NR; ++p) {
+            const int count = scanner->scan(p, vbuffer.data(), ibuffer.data());
+            std::vector<double> densified(NC);
+            for (int i = 0; i < count; ++i) {
+                densified[ibuffer[i]] = vbuffer[i];
+            }
+            for (int s = 0; s < NC; ++s) {
+                EXPECT_EQ(densified[s], expected(get_row(p), get_col(s)));
+            }
+        }
+    }
+}
+
+TEST(DenseMatrix, WindowErrors) {
+    std::vector<double> contents(200);
+
+    tatami::DenseMatrixOptions opt;
+    opt.leading_dimension = 19;
+    tatami_test::throws_error([&]() {
+        tatami::DenseRowMatrix<double, int> mat(10, 20, contents, opt);
+    }, "should be no less than the number of columns");
+    tatami_test::throws_error([&]() {
+        tatami::DenseColumnMatrix<double, int> mat(20, 10, contents, opt);
+    }, "should be no less than the number of rows");
+
+    opt.leading_dimension = 21;
+    tatami_test::throws_error([&]() {
+        tatami::DenseRowMatrix<double, int> mat(10, 20, contents, opt);
+    }, "not sufficient");
+
+    opt.leading_dimension = 0;
+    opt.offset = 1;
+    tatami_test::throws_error([&]() {
+        tatami::DenseRowMatrix<double, int> mat(10, 20, contents, opt);
+    }, "not sufficient");
+
+    // Empty matrices only need the offset to be addressable.
+    opt.offset = 200;
+    tatami::DenseRowMatrix<double, int> empty(0, 20, contents, opt);
+    EXPECT_EQ(empty.nrow(), 0);
+
+    opt.offset = 201;
+    tatami_test::throws_error([&]() {
+        tatami::DenseRowMatrix<double, int> mat(0, 20, contents, opt);
+    }, "not sufficient");
+}
@@ -101,3 +101,18 @@ INSTANTIATE_TEST_SUITE_P(
         ::testing::Values(1, 3)         // number of threads
     )
 );
+
+TEST(ConvertToDense, StorageType) {
+    std::vector<double> vec(60);
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = i;
+    }
+    tatami::DenseMatrix<double, int, decltype(vec)> mat(10, 6, std::move(vec), true);
+
+    // Storage is allocated without zero-initialization, as documented.
+    auto converted = tatami::convert_to_dense<double, int>(mat, false, tatami::ConvertToDenseOptions());
+    typedef std::vector<double, tatami::DefaultInitAllocator<double> > Storage;
+    auto casted = dynamic_cast<const tatami::DenseMatrix<double, int, Storage>*>(converted.get());
+    EXPECT_TRUE(casted != NULL);
+    tatami_test::test_simple_row_access(*converted, mat);
+}
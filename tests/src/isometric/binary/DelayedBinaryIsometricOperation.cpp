@@ -432,6 +432,53 @@ TEST_P(DelayedBinaryIsometricOperationTest, Mock) {
     }
 }
 
+TEST_P(DelayedBinaryIsometricOperationTest, SameOperand) {
+    tatami_test::TestAccessOptions opts;
+    auto tparam = GetParam();
+    opts.use_row = std::get<0>(tparam);
+    opts.use_oracle = std::get<1>(tparam);
+
+    // Both operands refer to the same matrix, so only one extractor is created internally.
+    auto mockparams = std::get<2>(tparam);
+    auto mockop = std::make_shared<BinaryMock<> >(mockparams);
+    tatami::DelayedBinaryIsometricOperation<double, double, int> dense_mod(ldense, ldense, mockop);
+    tatami::DelayedBinaryIsometricOperation<double, double, int> sparse_mod(lsparse, lsparse, mockop);
+
+    std::vector<double> refvec(lsimulated.size());
+    size_t counter = 0;
+    for (int r = 0; r < nrow; ++r) {
+        for (int c = 0; c < ncol; ++c) {
+            refvec[counter] = mock_operation(r, c, lsimulated[counter], lsimulated[counter], mockparams);
+            ++counter;
+        }
+    }
+    tatami::DenseMatrix<double, int, decltype(refvec)> ref(nrow, ncol, refvec, true);
+
+    tatami_test::test_full_access(dense_mod, ref, opts);
+    tatami_test::test_block_access(dense_mod, ref, 0.1, 0.7, opts);
+    tatami_test::test_indexed_access(dense_mod, ref, 0.23, 0.5, opts);
+
+    tatami_test::test_full_access(sparse_mod, ref, opts);
+    tatami_test::test_block_access(sparse_mod, ref, 0.13, 0.5, opts);
+    tatami_test::test_indexed_access(sparse_mod, ref, 0.23, 0.4, opts);
+
+    // Using a different type.
+    {
+        auto f_mockop = std::make_shared<BinaryMock<float> >(mockparams);
+        tatami::DelayedBinaryIsometricOperation<float, double, int> f_dense_mod(ldense, ldense, f_mockop);
+        tatami::DelayedBinaryIsometricOperation<float, double, int> f_sparse_mod(lsparse, lsparse, f_mockop);
+        tatami::DenseMatrix<float, int, std::vector<float> > f_ref(nrow, ncol, std::vector<float>(refvec.begin(), refvec.end()), true);
+
+        tatami_test::test_full_access(f_dense_mod, f_ref, opts);
+        tatami_test::test_block_access(f_dense_mod, f_ref, 0.5, 0.5, opts);
+        tatami_test::test_indexed_access(f_dense_mod, f_ref, 0.3, 0.5, opts);
+
+        tatami_test::test_full_access(f_sparse_mod, f_ref, opts);
+        tatami_test::test_block_access(f_sparse_mod, f_ref, 0.2, 0.6, opts);
+        tatami_test::test_indexed_access(f_sparse_mod, f_ref, 0.2, 0.4, opts);
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     DelayedBinaryIsometricOperation,
     DelayedBinaryIsometricOperationTest,
@@ -2,6 +2,7 @@
 
 #include <cmath>
 #include <memory>
+#include <numeric>
 #include <tuple>
 #include <vector>
 
@@ -410,6 +411,181 @@ TEST(DelayedUnaryIsometricArithmetic, NonFiniteMultiply) {
     EXPECT_FALSE(op.is_sparse());
 }
 
+static bool same_double(double left, double right) {
+    if (std::isnan(left)) {
+        return std::isnan(right);
+    }
+    return left == right && std::signbit(left) == std::signbit(right);
+}
+
+TEST(DelayedUnaryIsometricArithmeticScalar, SpecialPowers) {
+    std::vector<double> input { 0, -0.0, 1, -1, 2.5, -3.5, 1e-300, 1e300, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN() };
+    std::vector<double> output(input.size());
+    std::vector<int> indices(input.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    for (double exponent : { 0.0, 1.0, 2.0, 0.5, -1.0, 3.0 }) {
+        tatami::DelayedUnaryIsometricPowerScalarHelper<true, double, double, int, double> op(exponent);
+        output = input; // the helper assumes that the input and output buffers are the same if they have the same type.
+        op.dense(true, 0, 0, input.size(), output.data(), output.data());
+        for (size_t i = 0; i < input.size(); ++i) {
+            EXPECT_TRUE(same_double(output[i], std::pow(input[i], exponent))) << "x = " << input[i] << ", y = " << exponent;
+        }
+
+        output = input;
+        op.dense(false, 0, indices, output.data(), output.data());
+        for (size_t i = 0; i < input.size(); ++i) {
+            EXPECT_TRUE(same_double(output[i], std::pow(input[i], exponent))) << "x = " << input[i] << ", y = " << exponent;
+        }
+    }
+
+    // Works for integer types as well.
+    std::vector<int> iinput { 0, 1, -2, 3, -4 };
+    std::vector<double> ioutput(iinput.size());
+    for (int exponent : { 0, 1, 2, -1, 3 }) {
+        tatami::DelayedUnaryIsometricPowerScalarHelper<true, double, int, int, int> op(exponent);
+        op.sparse(true, 0, iinput.size(), iinput.data(), NULL, ioutput.data());
+        for (size_t i = 0; i < iinput.size(); ++i) {
+            EXPECT_TRUE(same_double(ioutput[i], std::pow(iinput[i], exponent)));
+        }
+    }
+}
+
+TEST(DelayedUnaryIsometricArithmeticScalar, PowerOfTwoDivide) {
+    std::vector<double> input { 0, -0.0, 1, -1, 2.5, -3.5, 1e-300, 1e300, std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN() };
+    std::vector<double> output(input.size());
+
+    for (double denom : { 4.0, 0.25, -2.0, 1.0, 3.0, 0.0, std::ldexp(1.0, -1070) }) {
+        tatami::DelayedUnaryIsometricDivideScalarHelper<true, double, double, int, double> op(denom);
+        output = input;
+        op.dense(true, 0, 0, input.size(), output.data(), output.data());
+        for (size_t i = 0; i < input.size(); ++i) {
+            EXPECT_TRUE(same_double(output[i], input[i] / denom)) << "x = " << input[i] << ", y = " << denom;
+        }
+    }
+}
+
+TEST(DelayedUnaryIsometricArithmeticScalar, Inexact) {
+    auto simulated = tatami_test::simulate_vector<double>(100, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.lower = 0.1;
+        opt.upper = 5;
+        opt.seed = 19283741;
+        return opt;
+    }());
+    std::vector<double> output(simulated.size());
+
+    tatami::DelayedUnaryIsometricArithmeticOptions aopt;
+    aopt.allow_inexact = true;
+
+    for (double denom : { 3.0, -0.7, 0.0 }) {
+        tatami::DelayedUnaryIsometricDivideScalarHelper<true, double, double, int, double> op(denom, aopt);
+        EXPECT_EQ(op.is_sparse(), denom != 0);
+        output = simulated;
+        op.dense(true, 0, 0, simulated.size(), output.data(), output.data());
+        for (size_t i = 0; i < simulated.size(); ++i) {
+            const double expected = careful_division(simulated[i], denom);
+            if (std::isfinite(expected)) {
+                EXPECT_NEAR(output[i], expected, std::abs(expected) * 1e-12);
+            } else {
+                EXPECT_EQ(output[i], expected);
+            }
+        }
+    }
+
+    for (double exponent : { 3.0, 7.0, -2.0, 2.5, -1.5, 0.3 }) {
+        tatami::DelayedUnaryIsometricPowerScalarHelper<true, double, double, int, double> op(exponent, aopt);
+        output = simulated;
+        op.dense(false, 0, 0, simulated.size(), output.data(), output.data());
+        for (size_t i = 0; i < simulated.size(); ++i) {
+            const double expected = std::pow(simulated[i], exponent);
+            EXPECT_NEAR(output[i], expected, expected * 1e-12);
+        }
+    }
+
+    // Inexact mode has no effect on the non-right operations.
+    tatami::DelayedUnaryIsometricDivideScalarHelper<false, double, double, int, double> lop(3.0, aopt);
+    output = simulated;
+    lop.dense(true, 0, 0, simulated.size(), output.data(), output.data());
+    for (size_t i = 0; i < simulated.size(); ++i) {
+        EXPECT_EQ(output[i], 3.0 / simulated[i]);
+    }
+}
+
+TEST(DelayedUnaryIsometricArithmeticScalar, InexactSpecialPowers) {
+    // Special values should be the same as std::pow, even in inexact mode.
+    std::vector<double> input { 0, -0.0, 1, -1, -2.5, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN() };
+    std::vector<double> output(input.size());
+
+    tatami::DelayedUnaryIsometricArithmeticOptions aopt;
+    aopt.allow_inexact = true;
+
+    for (double exponent : { 2.5, -2.5, 1.5, -0.5, 3.0, -3.0, 4.0, -4.0 }) {
+        tatami::DelayedUnaryIsometricPowerScalarHelper<true, double, double, int, double> op(exponent, aopt);
+        output = input;
+        op.dense(true, 0, 0, input.size(), output.data(), output.data());
+        for (size_t i = 0; i < input.size(); ++i) {
+            EXPECT_TRUE(same_double(output[i], std::pow(input[i], exponent))) << "x = " << input[i] << ", y = " << exponent;
+        }
+
+        auto vop = tatami::make_DelayedUnaryIsometricPowerVector<true>(std::vector<double>(5, exponent), true, aopt);
+        output = input;
+        vop->dense(true, 2, 0, input.size(), output.data(), output.data());
+        for (size_t i = 0; i < input.size(); ++i) {
+            EXPECT_TRUE(same_double(output[i], std::pow(input[i], exponent))) << "x = " << input[i] << ", y = " << exponent;
+        }
+    }
+}
+
+TEST(DelayedUnaryIsometricArithmeticScalar, InexactFactories) {
+    auto simulated = tatami_test::simulate_vector<double>(100, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.lower = 0.1;
+        opt.upper = 5;
+        opt.seed = 7162534;
+        return opt;
+    }());
+    std::vector<double> expected(simulated.size()), output(simulated.size());
+
+    tatami::DelayedUnaryIsometricArithmeticOptions aopt;
+    aopt.allow_inexact = true;
+
+    // Checking that the options are forwarded to the helpers, by comparing against a helper that was constructed directly.
+    {
+        tatami::DelayedUnaryIsometricDivideScalarHelper<true, double, double, int, double> ref(3.0, aopt);
+        expected = simulated;
+        ref.dense(true, 0, 0, simulated.size(), expected.data(), expected.data());
+
+        auto div = tatami::make_DelayedUnaryIsometricDivideScalar<true>(3.0, aopt);
+        output = simulated;
+        div->dense(true, 0, 0, simulated.size(), output.data(), output.data());
+        EXPECT_EQ(output, expected);
+
+        bool any_inexact = false;
+        for (size_t i = 0; i < simulated.size(); ++i) {
+            any_inexact = any_inexact || output[i] != simulated[i] / 3.0;
+        }
+        EXPECT_TRUE(any_inexact);
+    }
+
+    {
+        tatami::DelayedUnaryIsometricPowerScalarHelper<true, double, double, int, double> ref(7.0, aopt);
+        expected = simulated;
+        ref.dense(true, 0, 0, simulated.size(), expected.data(), expected.data());
+
+        auto pow = tatami::make_DelayedUnaryIsometricPowerScalar<true>(7.0, aopt);
+        output = simulated;
+        pow->dense(true, 0, 0, simulated.size(), output.data(), output.data());
+        EXPECT_EQ(output, expected);
+
+        bool any_inexact = false;
+        for (size_t i = 0; i < simulated.size(); ++i) {
+            any_inexact = any_inexact || output[i] != std::pow(simulated[i], 7.0);
+        }
+        EXPECT_TRUE(any_inexact);
+    }
+}
+
 TEST(DelayedUnaryIsometricArithmeticScalar, BackCompatibility) {
     auto add = tatami::make_DelayedUnaryIsometricAddScalar(1);
     EXPECT_FALSE(add->is_sparse());
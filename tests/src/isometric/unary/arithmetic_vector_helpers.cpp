@@ -1177,6 +1177,136 @@ INSTANTIATE_TEST_SUITE_P(
     DelayedUnaryIsometricIntegerDivideVectorUtils::simulation_parameter_combinations()
 );
 
+TEST(DelayedUnaryIsometricArithmeticVector, Inexact) {
+    auto simulated = tatami_test::simulate_vector<double>(50, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.lower = 0.1;
+        opt.upper = 5;
+        opt.seed = 9182371;
+        return opt;
+    }());
+    std::vector<double> output(simulated.size());
+    std::vector<int> indices;
+    for (int i = 0; i < 50; i += 3) {
+        indices.push_back(i);
+    }
+
+    tatami::DelayedUnaryIsometricArithmeticOptions aopt;
+    aopt.allow_inexact = true;
+
+    std::vector<double> vec(50);
+    for (int i = 0; i < 50; ++i) {
+        vec[i] = (i % 7) + 0.5;
+    }
+
+    auto check = [&](double observed, double expected) -> void {
+        EXPECT_NEAR(observed, expected, std::abs(expected) * 1e-12);
+    };
+
+    {
+        tatami::DelayedUnaryIsometricDivideVectorHelper<true, double, double, int, decltype(vec)> op(vec, true, aopt);
+        EXPECT_TRUE(op.is_sparse());
+
+        // Same dimension as the vector.
+        output = simulated; // the helper assumes that the input and output buffers are the same if they have the same type.
+        op.dense(true, 5, 0, 50, output.data(), output.data());
+        for (int i = 0; i < 50; ++i) {
+            check(output[i], simulated[i] / vec[5]);
+        }
+
+        // Other dimension.
+        output = simulated;
+        op.dense(false, 5, 0, 50, output.data(), output.data());
+        for (int i = 0; i < 50; ++i) {
+            check(output[i], simulated[i] / vec[i]);
+        }
+
+        output = simulated;
+        op.dense(false, 5, indices, output.data(), output.data());
+        for (size_t i = 0; i < indices.size(); ++i) {
+            check(output[i], simulated[i] / vec[indices[i]]);
+        }
+
+        output = simulated;
+        op.sparse(false, 5, indices.size(), output.data(), indices.data(), output.data());
+        for (size_t i = 0; i < indices.size(); ++i) {
+            check(output[i], simulated[i] / vec[indices[i]]);
+        }
+    }
+
+    // Falls back to a regular division if any reciprocal is not usable.
+    {
+        auto copy = vec;
+        copy[10] = 0;
+        tatami::DelayedUnaryIsometricDivideVectorHelper<true, double, double, int, decltype(copy)> op(copy, false, aopt);
+        EXPECT_FALSE(op.is_sparse());
+        output = simulated;
+        op.dense(true, 0, 0, 50, output.data(), output.data());
+        for (int i = 0; i < 50; ++i) {
+            EXPECT_EQ(output[i], careful_division(simulated[i], copy[i]));
+        }
+    }
+
+    {
+        tatami::DelayedUnaryIsometricPowerVectorHelper<true, double, double, int, decltype(vec)> op(vec, true, aopt);
+        for (int r : { 0, 1, 2, 3 }) {
+            output = simulated;
+            op.dense(true, r, 0, 50, output.data(), output.data());
+            for (int i = 0; i < 50; ++i) {
+                check(output[i], std::pow(simulated[i], vec[r]));
+            }
+        }
+    }
+}
+
+TEST(DelayedUnaryIsometricArithmeticVector, InexactFactories) {
+    auto simulated = tatami_test::simulate_vector<double>(50, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.lower = 0.1;
+        opt.upper = 5;
+        opt.seed = 2837461;
+        return opt;
+    }());
+    std::vector<double> expected(simulated.size()), output(simulated.size());
+
+    tatami::DelayedUnaryIsometricArithmeticOptions aopt;
+    aopt.allow_inexact = true;
+
+    std::vector<double> vec(50);
+    for (int i = 0; i < 50; ++i) {
+        vec[i] = (i % 7) + 3;
+    }
+
+    // Checking that the options are forwarded to the helpers, by comparing against a helper that was constructed directly.
+    {
+        tatami::DelayedUnaryIsometricDivideVectorHelper<true, double, double, int, decltype(vec)> ref(vec, false, aopt);
+        expected = simulated;
+        ref.dense(true, 0, 0, 50, expected.data(), expected.data());
+
+        auto div = tatami::make_DelayedUnaryIsometricDivideVector<true>(vec, false, aopt);
+        output = simulated;
+        div->dense(true, 0, 0, 50, output.data(), output.data());
+        EXPECT_EQ(output, expected);
+
+        bool any_inexact = false;
+        for (int i = 0; i < 50; ++i) {
+            any_inexact = any_inexact || output[i] != simulated[i] / vec[i];
+        }
+        EXPECT_TRUE(any_inexact);
+    }
+
+    {
+        tatami::DelayedUnaryIsometricPowerVectorHelper<true, double, double, int, decltype(vec)> ref(vec, false, aopt);
+        expected = simulated;
+        ref.dense(true, 0, 0, 50, expected.data(), expected.data());
+
+        auto pow = tatami::make_DelayedUnaryIsometricPowerVector<true>(vec, false, aopt);
+        output = simulated;
+        pow->dense(true, 0, 0, 50, output.data(), output.data());
+        EXPECT_EQ(output, expected);
+    }
+}
+
 TEST(DelayedUnaryIsometricArithmeticVector, BackCompatibility) {
     std::vector<double> vec(10, 1);
     auto add = tatami::make_DelayedUnaryIsometricAddVector(vec, true);
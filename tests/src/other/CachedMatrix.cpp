@@ -0,0 +1,523 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory>
+#include <tuple>
+#include <numeric>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+
+#include "tatami/dense/DenseMatrix.hpp"
+#include "tatami/other/CachedMatrix.hpp"
+#include "tatami/sparse/convert_to_compressed_sparse.hpp"
+#include "tatami/utils/parallelize.hpp"
+
+#include "tatami_test/tatami_test.hpp"
+
+class CachedMatrixUtils {
+public:
+    typedef std::tuple<std::size_t> SimulationParameters;
+
+protected:
+    inline static int nrow = 91, ncol = 123;
+    inline static std::shared_ptr<tatami::NumericMatrix> dense, sparse, cached_dense, cached_sparse;
+    inline static SimulationParameters last_params;
+
+    static void assemble(const SimulationParameters& params) {
+        if (dense && last_params == params) {
+            return;
+        }
+        last_params = params;
+
+        auto simulated = tatami_test::simulate_vector<double>(nrow * ncol, []{
+            tatami_test::SimulateVectorOptions opt;
+            opt.density = 0.1;
+            opt.seed = 1928371;
+            return opt;
+        }());
+
+        dense.reset(new tatami::DenseMatrix<double, int, decltype(simulated)>(nrow, ncol, std::move(simulated), true));
+        sparse = tatami::convert_to_compressed_sparse<double, int>(*dense, false, {});
+
+        tatami::CachedMatrixOptions copt;
+        copt.maximum_cache_size = std::get<0>(params);
+        cached_dense = std::make_shared<tatami::CachedMatrix<double, int> >(dense, copt);
+        cached_sparse = std::make_shared<tatami::CachedMatrix<double, int> >(sparse, copt);
+    }
+};
+
+/**********************************
+ **********************************/
+
+class CachedMatrixFullTest :
+    public ::testing::TestWithParam<std::tuple<CachedMatrixUtils::SimulationParameters, tatami_test::StandardTestAccessOptions> >,
+    public CachedMatrixUtils
+{
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(CachedMatrixFullTest, Basic) {
+    auto opt = tatami_test::convert_test_access_options(std::get<1>(GetParam()));
+    tatami_test::test_full_access(*cached_dense, *dense, opt);
+    tatami_test::test_full_access(*cached_sparse, *sparse, opt);
+
+    // Second pass should be served from the cache.
+    tatami_test::test_full_access(*cached_dense, *dense, opt);
+    tatami_test::test_full_access(*cached_sparse, *sparse, opt);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    CachedMatrix,
+    CachedMatrixFullTest,
+    ::testing::Combine(
+        ::testing::Combine(
+            ::testing::Values(1000, 100000000) // small cache with frequent evictions, or a large cache.
+        ),
+        tatami_test::standard_test_access_options_combinations()
+    )
+);
+
+/**********************************
+ **********************************/
+
+class CachedMatrixBlockTest :
+    public ::testing::TestWithParam<std::tuple<CachedMatrixUtils::SimulationParameters, tatami_test::StandardTestAccessOptions, std::pair<double, double> > >,
+    public CachedMatrixUtils {
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(CachedMatrixBlockTest, Basic) {
+    auto tparam = GetParam();
+    auto opt = tatami_test::convert_test_access_options(std::get<1>(tparam));
+    auto block = std::get<2>(tparam);
+    tatami_test::test_block_access(*cached_dense, *dense, block.first, block.second, opt);
+    tatami_test::test_block_access(*cached_sparse, *sparse, block.first, block.second, opt);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    CachedMatrix,
+    CachedMatrixBlockTest,
+    ::testing::Combine(
+        ::testing::Combine(
+            ::testing::Values(1000, 100000000)
+        ),
+        tatami_test::standard_test_access_options_combinations(),
+        ::testing::Values(
+            std::pair(0.0, 0.45),
+            std::pair(0.2, 0.6),
+            std::pair(0.4, 0.53)
+        )
+    )
+);
+
+/**********************************
+ **********************************/
+
+class CachedMatrixIndexTest :
+    public ::testing::TestWithParam<std::tuple<CachedMatrixUtils::SimulationParameters, tatami_test::StandardTestAccessOptions, std::pair<double, double> > >,
+    public CachedMatrixUtils {
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(CachedMatrixIndexTest, Basic) {
+    auto tparam = GetParam();
+    auto opt = tatami_test::convert_test_access_options(std::get<1>(tparam));
+    auto index = std::get<2>(tparam);
+    tatami_test::test_indexed_access(*cached_dense, *dense, index.first, index.second, opt);
+    tatami_test::test_indexed_access(*cached_sparse, *sparse, index.first, index.second, opt);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    CachedMatrix,
+    CachedMatrixIndexTest,
+    ::testing::Combine(
+        ::testing::Combine(
+            ::testing::Values(1000, 100000000)
+        ),
+        tatami_test::standard_test_access_options_combinations(),
+        ::testing::Values(
+            std::pair(0.0, 0.2),
+            std::pair(0.2, 0.5),
+            std::pair(0.3, 0.3)
+        )
+    )
+);
+
+/**********************************
+ **********************************/
+
+TEST(CachedMatrix, Properties) {
+    auto simulated = tatami_test::simulate_vector<double>(200, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.density = 0.2;
+        opt.seed = 71293;
+        return opt;
+    }());
+    auto dense = std::make_shared<tatami::DenseMatrix<double, int, decltype(simulated)> >(10, 20, simulated, false);
+    tatami::CachedMatrix<double, int> cached(dense);
+
+    EXPECT_EQ(cached.nrow(), 10);
+    EXPECT_EQ(cached.ncol(), 20);
+    EXPECT_FALSE(cached.is_sparse());
+    EXPECT_EQ(cached.is_sparse_proportion(), 0);
+    EXPECT_FALSE(cached.prefer_rows());
+    EXPECT_EQ(cached.prefer_rows_proportion(), 0);
+    EXPECT_FALSE(cached.uses_oracle(true));
+    EXPECT_EQ(cached.cache_size(), 0);
+}
+
+TEST(CachedMatrix, Sharing) {
+    auto simulated = tatami_test::simulate_vector<double>(200, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.density = 0.2;
+        opt.seed = 8172;
+        return opt;
+    }());
+    auto dense = std::make_shared<tatami::DenseMatrix<double, int, decltype(simulated)> >(10, 20, simulated, true);
+    tatami::CachedMatrix<double, int> cached(dense);
+    std::vector<double> buffer(20);
+
+    auto ext = cached.dense_row();
+    ext->fetch(0, buffer.data());
+    const auto first_size = cached.cache_size();
+    EXPECT_GT(first_size, 0);
+
+    // Same row from a different extractor re-uses the cache.
+    auto ext2 = cached.dense_row();
+    auto ptr = ext2->fetch(0, buffer.data());
+    EXPECT_EQ(cached.cache_size(), first_size);
+    EXPECT_EQ(std::vector<double>(ptr, ptr + 20), std::vector<double>(simulated.begin(), simulated.begin() + 20));
+
+    // Same for an equivalent indexed extractor.
+    auto indices = std::make_shared<std::vector<int> >(std::vector<int>{ 1, 3, 5 });
+    auto iext = cached.dense_row(indices);
+    iext->fetch(0, buffer.data());
+    const auto second_size = cached.cache_size();
+    EXPECT_GT(second_size, first_size);
+
+    auto iext2 = cached.dense_row(std::make_shared<std::vector<int> >(*indices));
+    iext2->fetch(0, buffer.data());
+    EXPECT_EQ(cached.cache_size(), second_size);
+
+    // A different row needs a new entry.
+    ext2->fetch(1, buffer.data());
+    EXPECT_GT(cached.cache_size(), second_size);
+}
+
+TEST(CachedMatrix, Eviction) {
+    auto simulated = tatami_test::simulate_vector<double>(1000, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.density = 0.2;
+        opt.seed = 213;
+        return opt;
+    }());
+    auto dense = std::make_shared<tatami::DenseMatrix<double, int, decltype(simulated)> >(10, 100, simulated, true);
+
+    tatami::CachedMatrixOptions copt;
+    copt.maximum_cache_size = 2000; // enough for two rows.
+    tatami::CachedMatrix<double, int> cached(dense, copt);
+    std::vector<double> buffer(100);
+
+    auto ext = cached.dense_row();
+    for (int r = 0; r < 10; ++r) {
+        auto ptr = ext->fetch(r, buffer.data());
+        EXPECT_EQ(std::vector<double>(ptr, ptr + 100), std::vector<double>(simulated.begin() + r * 100, simulated.begin() + (r + 1) * 100));
+        EXPECT_LE(cached.cache_size(), copt.maximum_cache_size);
+    }
+
+    // Rows larger than the cache are never stored.
+    copt.maximum_cache_size = 10;
+    tatami::CachedMatrix<double, int> tiny(dense, copt);
+    auto text = tiny.dense_row();
+    auto ptr = text->fetch(5, buffer.data());
+    EXPECT_EQ(std::vector<double>(ptr, ptr + 100), std::vector<double>(simulated.begin() + 500, simulated.begin() + 600));
+    EXPECT_EQ(tiny.cache_size(), 0);
+}
+
+TEST(CachedMatrix, Selections) {
+    auto simulated = tatami_test::simulate_vector<double>(1000, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.density = 0.2;
+        opt.seed = 6661;
+        return opt;
+    }());
+    auto dense = std::make_shared<tatami::DenseMatrix<double, int, decltype(simulated)> >(10, 100, simulated, true);
+    tatami::CachedMatrix<double, int> cached(dense);
+    std::vector<double> buffer(100);
+    EXPECT_EQ(cached.cache_selections(), 0);
+
+    // Equivalent selections are shared.
+    auto indices = std::make_shared<std::vector<int> >(std::vector<int>{ 1, 3, 5 });
+    {
+        auto iext = cached.dense_row(indices);
+        auto iext2 = cached.dense_row(std::make_shared<std::vector<int> >(*indices));
+        EXPECT_EQ(cached.cache_selections(), 1);
+        auto iext3 = cached.dense_row(std::make_shared<std::vector<int> >(std::vector<int>{ 1, 3, 7 }));
+        EXPECT_EQ(cached.cache_selections(), 2);
+        iext->fetch(0, buffer.data());
+    }
+
+    // Selections without any cached entries are discarded once their extractors are destroyed,
+    // while those with cached entries are retained for re-use by later extractors.
+    EXPECT_EQ(cached.cache_selections(), 1);
+    const auto before = cached.cache_size();
+    {
+        auto iext = cached.dense_row(indices);
+        auto ptr = iext->fetch(0, buffer.data());
+        EXPECT_EQ(std::vector<double>(ptr, ptr + 3), std::vector<double>({ simulated[1], simulated[3], simulated[5] }));
+        EXPECT_EQ(cached.cache_size(), before);
+    }
+    EXPECT_EQ(cached.cache_selections(), 1);
+
+    // Many short-lived extractors do not cause the selections to accumulate.
+    for (int i = 0; i < 100; ++i) {
+        auto bext = cached.dense_row(i, 1);
+        EXPECT_EQ(cached.cache_selections(), 2);
+    }
+    EXPECT_EQ(cached.cache_selections(), 1);
+}
+
+TEST(CachedMatrix, SelectionEviction) {
+    auto simulated = tatami_test::simulate_vector<double>(1000, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.density = 0.2;
+        opt.seed = 7771;
+        return opt;
+    }());
+    auto dense = std::make_shared<tatami::DenseMatrix<double, int, decltype(simulated)> >(10, 100, simulated, true);
+
+    tatami::CachedMatrixOptions copt;
+    copt.maximum_cache_size = 3000;
+    tatami::CachedMatrix<double, int> cached(dense, copt);
+    std::vector<double> buffer(100);
+
+    // Storage for the indices is counted towards the cache size.
+    std::vector<int> all(100);
+    std::iota(all.begin(), all.end(), 0);
+    {
+        auto iext = cached.dense_row(std::make_shared<std::vector<int> >(all));
+        iext->fetch(0, buffer.data());
+        EXPECT_GE(cached.cache_size(), all.size() * (sizeof(int) + sizeof(double)));
+    }
+    EXPECT_EQ(cached.cache_selections(), 1);
+
+    // Selection is discarded once its last entry is evicted.
+    auto ext = cached.dense_row();
+    for (int r = 0; r < 10; ++r) {
+        auto ptr = ext->fetch(r, buffer.data());
+        EXPECT_EQ(std::vector<double>(ptr, ptr + 100), std::vector<double>(simulated.begin() + r * 100, simulated.begin() + (r + 1) * 100));
+        EXPECT_LE(cached.cache_size(), copt.maximum_cache_size);
+    }
+    EXPECT_EQ(cached.cache_selections(), 1);
+
+    // Rows are not cached if there is no space for both the row and its selection.
+    copt.maximum_cache_size = 1000;
+    tatami::CachedMatrix<double, int> tiny(dense, copt);
+    {
+        auto iext = tiny.dense_row(std::make_shared<std::vector<int> >(all));
+        auto ptr = iext->fetch(5, buffer.data());
+        EXPECT_EQ(std::vector<double>(ptr, ptr + 100), std::vector<double>(simulated.begin() + 500, simulated.begin() + 600));
+        EXPECT_EQ(tiny.cache_size(), 0);
+    }
+    EXPECT_EQ(tiny.cache_selections(), 0);
+}
+
+// Counting the number of calls to the underlying matrix, with a delay to ensure that concurrent requests overlap.
+class CountingMatrix final : public tatami::Matrix<double, int> {
+public:
+    CountingMatrix(std::shared_ptr<const tatami::Matrix<double, int> > matrix) : my_matrix(std::move(matrix)) {}
+
+    mutable std::atomic<int> dense_fetches = 0, sparse_fetches = 0;
+
+private:
+    std::shared_ptr<const tatami::Matrix<double, int> > my_matrix;
+
+    class Dense final : public tatami::MyopicDenseExtractor<double, int> {
+    public:
+        Dense(std::unique_ptr<tatami::MyopicDenseExtractor<double, int> > ext, std::atomic<int>& counter) : my_ext(std::move(ext)), my_counter(counter) {}
+        const double* fetch(int i, double* buffer) {
+            ++my_counter;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            return my_ext->fetch(i, buffer);
+        }
+    private:
+        std::unique_ptr<tatami::MyopicDenseExtractor<double, int> > my_ext;
+        std::atomic<int>& my_counter;
+    };
+
+    class Sparse final : public tatami::MyopicSparseExtractor<double, int> {
+    public:
+        Sparse(std::unique_ptr<tatami::MyopicSparseExtractor<double, int> > ext, std::atomic<int>& counter) : my_ext(std::move(ext)), my_counter(counter) {}
+        tatami::SparseRange<double, int> fetch(int i, double* vbuffer, int* ibuffer) {
+            ++my_counter;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            return my_ext->fetch(i, vbuffer, ibuffer);
+        }
+    private:
+        std::unique_ptr<tatami::MyopicSparseExtractor<double, int> > my_ext;
+        std::atomic<int>& my_counter;
+    };
+
+public:
+    int nrow() const { return my_matrix->nrow(); }
+    int ncol() const { return my_matrix->ncol(); }
+    bool is_sparse() const { return my_matrix->is_sparse(); }
+    double is_sparse_proportion() const { return my_matrix->is_sparse_proportion(); }
+    bool prefer_rows() const { return my_matrix->prefer_rows(); }
+    double prefer_rows_proportion() const { return my_matrix->prefer_rows_proportion(); }
+    bool uses_oracle(bool) const { return false; }
+
+    using tatami::Matrix<double, int>::dense;
+    using tatami::Matrix<double, int>::sparse;
+
+    std::unique_ptr<tatami::MyopicDenseExtractor<double, int> > dense(bool row, const tatami::Options& opt) const {
+        return std::make_unique<Dense>(my_matrix->dense(row, opt), dense_fetches);
+    }
+    std::unique_ptr<tatami::MyopicDenseExtractor<double, int> > dense(bool row, int s, int l, const tatami::Options& opt) const {
+        return std::make_unique<Dense>(my_matrix->dense(row, s, l, opt), dense_fetches);
+    }
+    std::unique_ptr<tatami::MyopicDenseExtractor<double, int> > dense(bool row, tatami::VectorPtr<int> i, const tatami::Options& opt) const {
+        return std::make_unique<Dense>(my_matrix->dense(row, std::move(i), opt), dense_fetches);
+    }
+
+    std::unique_ptr<tatami::MyopicSparseExtractor<double, int> > sparse(bool row, const tatami::Options& opt) const {
+        return std::make_unique<Sparse>(my_matrix->sparse(row, opt), sparse_fetches);
+    }
+    std::unique_ptr<tatami::MyopicSparseExtractor<double, int> > sparse(bool row, int s, int l, const tatami::Options& opt) const {
+        return std::make_unique<Sparse>(my_matrix->sparse(row, s, l, opt), sparse_fetches);
+    }
+    std::unique_ptr<tatami::MyopicSparseExtractor<double, int> > sparse(bool row, tatami::VectorPtr<int> i, const tatami::Options& opt) const {
+        return std::make_unique<Sparse>(my_matrix->sparse(row, std::move(i), opt), sparse_fetches);
+    }
+
+    // The CachedMatrix never passes oracles to the underlying matrix.
+    std::unique_ptr<tatami::OracularDenseExtractor<double, int> > dense(bool, std::shared_ptr<const tatami::Oracle<int> >, const tatami::Options&) const {
+        throw std::runtime_error("oracle should not be used");
+    }
+    std::unique_ptr<tatami::OracularDenseExtractor<double, int> > dense(bool, std::shared_ptr<const tatami::Oracle<int> >, int, int, const tatami::Options&) const {
+        throw std::runtime_error("oracle should not be used");
+    }
+    std::unique_ptr<tatami::OracularDenseExtractor<double, int> > dense(bool, std::shared_ptr<const tatami::Oracle<int> >, tatami::VectorPtr<int>, const tatami::Options&) const {
+        throw std::runtime_error("oracle should not be used");
+    }
+    std::unique_ptr<tatami::OracularSparseExtractor<double, int> > sparse(bool, std::shared_ptr<const tatami::Oracle<int> >, const tatami::Options&) const {
+        throw std::runtime_error("oracle should not be used");
+    }
+    std::unique_ptr<tatami::OracularSparseExtractor<double, int> > sparse(bool, std::shared_ptr<const tatami::Oracle<int> >, int, int, const tatami::Options&) const {
+        throw std::runtime_error("oracle should not be used");
+    }
+    std::unique_ptr<tatami::OracularSparseExtractor<double, int> > sparse(bool, std::shared_ptr<const tatami::Oracle<int> >, tatami::VectorPtr<int>, const tatami::Options&) const {
+        throw std::runtime_error("oracle should not be used");
+    }
+};
+
+TEST(CachedMatrix, InFlight) {
+    auto simulated = tatami_test::simulate_vector<double>(500, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.density = 0.2;
+        opt.seed = 4242;
+        return opt;
+    }());
+    auto dense = std::make_shared<tatami::DenseMatrix<double, int, decltype(simulated)> >(5, 100, simulated, true);
+    auto counting = std::make_shared<CountingMatrix>(dense);
+    tatami::CachedMatrix<double, int> cached(counting);
+
+    // All threads request the same rows at the same time, so only the first request for each row should reach the underlying matrix.
+    int nthreads = 4;
+    std::vector<int> failures(nthreads);
+    tatami::parallelize([&](int t, int, int) -> void {
+        std::vector<double> dbuffer(100), vbuffer(100);
+        std::vector<int> ibuffer(100);
+        auto dext = cached.dense_row();
+        auto sext = cached.sparse_row();
+        for (int r = 0; r < 5; ++r) {
+            const std::vector<double> expected(simulated.begin() + r * 100, simulated.begin() + (r + 1) * 100);
+            auto ptr = dext->fetch(r, dbuffer.data());
+            if (std::vector<double>(ptr, ptr + 100) != expected) {
+                ++failures[t];
+            }
+
+            auto range = sext->fetch(r, vbuffer.data(), ibuffer.data());
+            std::vector<double> expanded(100);
+            for (int i = 0; i < range.number; ++i) {
+                expanded[range.index[i]] = range.value[i];
+            }
+            if (expanded != expected) {
+                ++failures[t];
+            }
+        }
+    }, nthreads, nthreads);
+
+    EXPECT_EQ(failures, std::vector<int>(nthreads));
+    EXPECT_EQ(counting->dense_fetches.load(), 5);
+    EXPECT_EQ(counting->sparse_fetches.load(), 5);
+
+    // Same for rows that are too large to be cached, as the waiting threads still re-use the in-flight result.
+    tatami::CachedMatrixOptions copt;
+    copt.maximum_cache_size = 10;
+    auto counting2 = std::make_shared<CountingMatrix>(dense);
+    tatami::CachedMatrix<double, int> tiny(counting2, copt);
+    std::vector<int> observed(nthreads);
+    tatami::parallelize([&](int t, int, int) -> void {
+        std::vector<double> buffer(100);
+        auto ext = tiny.dense_row();
+        auto ptr = ext->fetch(2, buffer.data());
+        observed[t] = (std::vector<double>(ptr, ptr + 100) == std::vector<double>(simulated.begin() + 200, simulated.begin() + 300));
+    }, nthreads, nthreads);
+    EXPECT_EQ(observed, std::vector<int>(nthreads, 1));
+    EXPECT_GE(counting2->dense_fetches.load(), 1);
+    EXPECT_LE(counting2->dense_fetches.load(), nthreads);
+}
+
+TEST(CachedMatrix, Parallel) {
+    auto simulated = tatami_test::simulate_vector<double>(5000, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.density = 0.2;
+        opt.seed = 9999;
+        return opt;
+    }());
+    auto dense = std::make_shared<tatami::DenseMatrix<double, int, decltype(simulated)> >(50, 100, simulated, true);
+    auto sparse = tatami::convert_to_compressed_sparse<double, int>(*dense, true, {});
+
+    tatami::CachedMatrixOptions copt;
+    copt.maximum_cache_size = 10000; // forcing some evictions.
+    tatami::CachedMatrix<double, int> cached(sparse, copt);
+
+    // Each thread iterates over all rows, so that the threads are competing for the same rows.
+    int nthreads = 3;
+    std::vector<int> failures(nthreads);
+    tatami::parallelize([&](int t, int, int) -> void {
+        std::vector<double> dbuffer(100), vbuffer(100);
+        std::vector<int> ibuffer(100);
+        auto dext = cached.dense_row();
+        auto sext = cached.sparse_row();
+        for (int r = 0; r < 50; ++r) {
+            auto ptr = dext->fetch(r, dbuffer.data());
+            if (std::vector<double>(ptr, ptr + 100) != std::vector<double>(simulated.begin() + r * 100, simulated.begin() + (r + 1) * 100)) {
+                ++failures[t];
+            }
+
+            auto range = sext->fetch(r, vbuffer.data(), ibuffer.data());
+            std::vector<double> expanded(100);
+            for (int i = 0; i < range.number; ++i) {
+                expanded[range.index[i]] = range.value[i];
+            }
+            if (expanded != std::vector<double>(simulated.begin() + r * 100, simulated.begin() + (r + 1) * 100)) {
+                ++failures[t];
+            }
+        }
+    }, nthreads, nthreads);
+
+    EXPECT_EQ(failures, std::vector<int>(nthreads));
+}
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <memory>
+#include <algorithm>
 
 #include "tatami/dense/DenseMatrix.hpp"
 #include "tatami/other/DelayedBind.hpp"
@@ -33,6 +34,7 @@ protected:
     inline static std::shared_ptr<tatami::NumericMatrix> bound_dense, bound_sparse, manual;
     inline static std::shared_ptr<tatami::NumericMatrix> forced_bound_dense, forced_bound_sparse;
     inline static std::shared_ptr<tatami::NumericMatrix> uns_bound_dense, uns_bound_sparse;
+    inline static std::shared_ptr<tatami::NumericMatrix> pooled_bound_dense, pooled_bound_sparse;
     inline static SimulationParameters last_params;
 
     static void assemble(SimulationParameters sim_params) {
@@ -76,6 +78,19 @@ protected:
             uns_collected_sparse.emplace_back(std::make_shared<tatami_test::ReversedIndicesWrapper<double, int> >(collected_sparse.back()));
         }
 
+        tatami::DelayedBindOptions bopt;
+        bopt.child_thread_pool = std::make_shared<tatami::ThreadPool>(3);
+        pooled_bound_dense.reset(new tatami::DelayedBind<double, int>(
+            std::vector<std::shared_ptr<const tatami::NumericMatrix> >(collected_dense.begin(), collected_dense.end()),
+            row,
+            bopt
+        ));
+        pooled_bound_sparse.reset(new tatami::DelayedBind<double, int>(
+            std::vector<std::shared_ptr<const tatami::NumericMatrix> >(collected_sparse.begin(), collected_sparse.end()),
+            row,
+            bopt
+        ));
+
         if (row) {
             bound_dense.reset(new tatami::DelayedBind(std::move(collected_dense), true));
             bound_sparse.reset(new tatami::DelayedBind(std::move(collected_sparse), true));
@@ -216,6 +231,304 @@ TEST(DelayedBindMisc, PartialOracleUsage) {
     }
 }
 
+// Counting the extractors and oracles requested from each child of a DelayedBind.
+class CountingChild final : public tatami::Matrix<double, int> {
+public:
+    CountingChild(std::shared_ptr<const tatami::Matrix<double, int> > matrix) : my_matrix(std::move(matrix)) {}
+
+    mutable int myopic_extractors = 0, oracular_extractors = 0;
+    mutable std::vector<std::shared_ptr<const tatami::Oracle<int> > > oracles;
+
+    int total_extractors() const {
+        return myopic_extractors + oracular_extractors;
+    }
+
+private:
+    std::shared_ptr<const tatami::Matrix<double, int> > my_matrix;
+
+    template<class Extractor_>
+    Extractor_ count_myopic(Extractor_ ext) const {
+        ++myopic_extractors;
+        return ext;
+    }
+
+    template<class Extractor_>
+    Extractor_ count_oracular(std::shared_ptr<const tatami::Oracle<int> > oracle, Extractor_ ext) const {
+        ++oracular_extractors;
+        oracles.push_back(std::move(oracle));
+        return ext;
+    }
+
+public:
+    int nrow() const { return my_matrix->nrow(); }
+    int ncol() const { return my_matrix->ncol(); }
+    bool is_sparse() const { return my_matrix->is_sparse(); }
+    double is_sparse_proportion() const { return my_matrix->is_sparse_proportion(); }
+    bool prefer_rows() const { return my_matrix->prefer_rows(); }
+    double prefer_rows_proportion() const { return my_matrix->prefer_rows_proportion(); }
+    bool uses_oracle(bool) const { return true; } // forcing the DelayedBind to pass oracles to its children.
+
+    using tatami::Matrix<double, int>::dense;
+    using tatami::Matrix<double, int>::sparse;
+
+    std::unique_ptr<tatami::MyopicDenseExtractor<double, int> > dense(bool row, const tatami::Options& opt) const {
+        return count_myopic(my_matrix->dense(row, opt));
+    }
+    std::unique_ptr<tatami::MyopicDenseExtractor<double, int> > dense(bool row, int s, int l, const tatami::Options& opt) const {
+        return count_myopic(my_matrix->dense(row, s, l, opt));
+    }
+    std::unique_ptr<tatami::MyopicDenseExtractor<double, int> > dense(bool row, tatami::VectorPtr<int> i, const tatami::Options& opt) const {
+        return count_myopic(my_matrix->dense(row, std::move(i), opt));
+    }
+    std::unique_ptr<tatami::MyopicSparseExtractor<double, int> > sparse(bool row, const tatami::Options& opt) const {
+        return count_myopic(my_matrix->sparse(row, opt));
+    }
+    std::unique_ptr<tatami::MyopicSparseExtractor<double, int> > sparse(bool row, int s, int l, const tatami::Options& opt) const {
+        return count_myopic(my_matrix->sparse(row, s, l, opt));
+    }
+    std::unique_ptr<tatami::MyopicSparseExtractor<double, int> > sparse(bool row, tatami::VectorPtr<int> i, const tatami::Options& opt) const {
+        return count_myopic(my_matrix->sparse(row, std::move(i), opt));
+    }
+
+    std::unique_ptr<tatami::OracularDenseExtractor<double, int> > dense(bool row, std::shared_ptr<const tatami::Oracle<int> > o, const tatami::Options& opt) const {
+        return count_oracular(o, my_matrix->dense(row, o, opt));
+    }
+    std::unique_ptr<tatami::OracularDenseExtractor<double, int> > dense(bool row, std::shared_ptr<const tatami::Oracle<int> > o, int s, int l, const tatami::Options& opt) const {
+        return count_oracular(o, my_matrix->dense(row, o, s, l, opt));
+    }
+    std::unique_ptr<tatami::OracularDenseExtractor<double, int> > dense(bool row, std::shared_ptr<const tatami::Oracle<int> > o, tatami::VectorPtr<int> i, const tatami::Options& opt) const {
+        return count_oracular(o, my_matrix->dense(row, o, std::move(i), opt));
+    }
+    std::unique_ptr<tatami::OracularSparseExtractor<double, int> > sparse(bool row, std::shared_ptr<const tatami::Oracle<int> > o, const tatami::Options& opt) const {
+        return count_oracular(o, my_matrix->sparse(row, o, opt));
+    }
+    std::unique_ptr<tatami::OracularSparseExtractor<double, int> > sparse(bool row, std::shared_ptr<const tatami::Oracle<int> > o, int s, int l, const tatami::Options& opt) const {
+        return count_oracular(o, my_matrix->sparse(row, o, s, l, opt));
+    }
+    std::unique_ptr<tatami::OracularSparseExtractor<double, int> > sparse(bool row, std::shared_ptr<const tatami::Oracle<int> > o, tatami::VectorPtr<int> i, const tatami::Options& opt) const {
+        return count_oracular(o, my_matrix->sparse(row, o, std::move(i), opt));
+    }
+};
+
+class DelayedBindManyChildrenTest : public ::testing::Test {
+protected:
+    // Lots of small children, of which only a few are touched by the requested rows.
+    inline static const int nchildren = 500, nrow_per = 3, ncol = 11;
+    std::vector<std::shared_ptr<CountingChild> > children;
+    std::shared_ptr<tatami::NumericMatrix> combined, ref;
+
+    void SetUp() {
+        std::vector<std::shared_ptr<tatami::NumericMatrix> > collected;
+        std::vector<double> concat;
+        for (int c = 0; c < nchildren; ++c) {
+            auto to_add = tatami_test::simulate_vector<double>(nrow_per * ncol, [&]{
+                tatami_test::SimulateVectorOptions opt;
+                opt.density = 0.3;
+                opt.seed = 1000 + c;
+                return opt;
+            }());
+            concat.insert(concat.end(), to_add.begin(), to_add.end());
+            auto dense = std::make_shared<tatami::DenseRowMatrix<double, int> >(nrow_per, ncol, std::move(to_add));
+            if (c % 2 == 0) {
+                children.push_back(std::make_shared<CountingChild>(std::move(dense)));
+            } else {
+                children.push_back(std::make_shared<CountingChild>(tatami::convert_to_compressed_sparse<double, int>(*dense, false, {})));
+            }
+            collected.push_back(children.back());
+        }
+
+        combined.reset(new tatami::DelayedBind<double, int>(collected, true));
+        ref.reset(new tatami::DenseRowMatrix<double, int>(nchildren * nrow_per, ncol, std::move(concat)));
+    }
+
+    std::vector<int> extractor_counts() const {
+        std::vector<int> output;
+        for (const auto& child : children) {
+            output.push_back(child->total_extractors());
+        }
+        return output;
+    }
+
+    std::vector<int> oracle_counts() const {
+        std::vector<int> output;
+        for (const auto& child : children) {
+            output.push_back(child->oracles.size());
+        }
+        return output;
+    }
+
+    void reset_counts() {
+        for (auto& child : children) {
+            child->myopic_extractors = 0;
+            child->oracular_extractors = 0;
+            child->oracles.clear();
+        }
+    }
+};
+
+TEST_F(DelayedBindManyChildrenTest, Perpendicular) {
+    // Mixing consecutive and non-consecutive predictions within the same child.
+    std::vector<int> requested{ 1000, 5, 3, 4, 1001, 6, 1002, 1499, 8, 6, 0 };
+
+    auto rext = ref->dense_row();
+    std::vector<double> rbuffer(ncol), buffer(ncol);
+    std::vector<double> vbuffer(ncol);
+    std::vector<int> ibuffer(ncol);
+
+    {
+        auto ext = combined->dense_row();
+        auto sext = combined->sparse_row();
+        EXPECT_EQ(extractor_counts(), std::vector<int>(nchildren));
+
+        std::vector<int> expected_counts(nchildren);
+        for (auto r : requested) {
+            auto rptr = rext->fetch(r, rbuffer.data());
+            std::vector<double> expected(rptr, rptr + ncol);
+            auto ptr = ext->fetch(r, buffer.data());
+            EXPECT_EQ(expected, std::vector<double>(ptr, ptr + ncol));
+
+            auto range = sext->fetch(r, vbuffer.data(), ibuffer.data());
+            std::vector<double> densified(ncol);
+            for (int i = 0; i < range.number; ++i) {
+                densified[range.index[i]] = range.value[i];
+            }
+            EXPECT_EQ(expected, densified);
+
+            // Each child's dense and sparse extractors are only created on first access.
+            expected_counts[r / nrow_per] = 2;
+            EXPECT_EQ(extractor_counts(), expected_counts);
+        }
+
+        EXPECT_EQ(oracle_counts(), std::vector<int>(nchildren));
+    }
+
+    reset_counts();
+    {
+        auto ext = combined->dense_row(std::make_shared<tatami::FixedVectorOracle<int> >(requested));
+        auto sext = combined->sparse_row(std::make_shared<tatami::FixedVectorOracle<int> >(requested));
+        EXPECT_EQ(extractor_counts(), std::vector<int>(nchildren));
+
+        std::vector<int> expected_counts(nchildren);
+        for (auto r : requested) {
+            auto rptr = rext->fetch(r, rbuffer.data());
+            std::vector<double> expected(rptr, rptr + ncol);
+            auto ptr = ext->fetch(buffer.data());
+            EXPECT_EQ(expected, std::vector<double>(ptr, ptr + ncol));
+
+            auto range = sext->fetch(vbuffer.data(), ibuffer.data());
+            std::vector<double> densified(ncol);
+            for (int i = 0; i < range.number; ++i) {
+                densified[range.index[i]] = range.value[i];
+            }
+            EXPECT_EQ(expected, densified);
+
+            expected_counts[r / nrow_per] = 2;
+            EXPECT_EQ(extractor_counts(), expected_counts);
+        }
+
+        // Untouched children never get an oracle, and each touched child's oracle only contains its own predictions.
+        EXPECT_EQ(oracle_counts(), expected_counts);
+        EXPECT_EQ(std::count(expected_counts.begin(), expected_counts.end(), 2), 6); // i.e., children 0, 1, 2, 333, 334 and 499.
+
+        for (int c = 0; c < nchildren; ++c) {
+            std::vector<int> expected_predictions;
+            for (auto r : requested) {
+                if (r / nrow_per == c) {
+                    expected_predictions.push_back(r % nrow_per);
+                }
+            }
+            for (const auto& oracle : children[c]->oracles) {
+                std::vector<int> predictions;
+                for (tatami::PredictionIndex i = 0, end = oracle->total(); i < end; ++i) {
+                    predictions.push_back(oracle->get(i));
+                }
+                EXPECT_EQ(predictions, expected_predictions);
+            }
+        }
+    }
+}
+
+TEST_F(DelayedBindManyChildrenTest, ParallelBlock) {
+    // Rows [300, 306) only overlap with children 100 and 101.
+    const int block_start = 300, block_length = 6;
+    std::vector<int> expected_counts(nchildren);
+    expected_counts[100] = 1;
+    expected_counts[101] = 1;
+
+    {
+        auto ext = combined->dense_column(block_start, block_length);
+        EXPECT_EQ(extractor_counts(), expected_counts);
+        auto rext = ref->dense_column(block_start, block_length);
+        std::vector<double> buffer(block_length), rbuffer(block_length);
+        for (int c = 0; c < ncol; ++c) {
+            auto ptr = ext->fetch(c, buffer.data());
+            auto rptr = rext->fetch(c, rbuffer.data());
+            EXPECT_EQ(std::vector<double>(ptr, ptr + block_length), std::vector<double>(rptr, rptr + block_length));
+        }
+    }
+
+    reset_counts();
+    {
+        auto ext = combined->sparse_column(std::make_shared<tatami::ConsecutiveOracle<int> >(0, ncol), block_start, block_length);
+        EXPECT_EQ(extractor_counts(), expected_counts);
+        EXPECT_EQ(oracle_counts(), expected_counts);
+        auto rext = ref->dense_column(block_start, block_length);
+        std::vector<double> vbuffer(block_length), rbuffer(block_length);
+        std::vector<int> ibuffer(block_length);
+        for (int c = 0; c < ncol; ++c) {
+            auto range = ext->fetch(vbuffer.data(), ibuffer.data());
+            auto rptr = rext->fetch(c, rbuffer.data());
+            std::vector<double> densified(block_length);
+            for (int i = 0; i < range.number; ++i) {
+                densified[range.index[i] - block_start] = range.value[i];
+            }
+            EXPECT_EQ(densified, std::vector<double>(rptr, rptr + block_length));
+        }
+    }
+}
+
+TEST_F(DelayedBindManyChildrenTest, ParallelIndex) {
+    // Only children 1, 2 and 333 are touched by these rows.
+    std::vector<int> indices{ 4, 5, 7, 1000, 1001 };
+    std::vector<int> expected_counts(nchildren);
+    expected_counts[1] = 1;
+    expected_counts[2] = 1;
+    expected_counts[333] = 1;
+
+    {
+        auto ext = combined->sparse_column(indices);
+        EXPECT_EQ(extractor_counts(), expected_counts);
+        auto rext = ref->dense_column(indices);
+        std::vector<double> vbuffer(indices.size()), rbuffer(indices.size());
+        std::vector<int> ibuffer(indices.size());
+        for (int c = 0; c < ncol; ++c) {
+            auto range = ext->fetch(c, vbuffer.data(), ibuffer.data());
+            auto rptr = rext->fetch(c, rbuffer.data());
+            std::vector<double> densified(nchildren * nrow_per);
+            for (int i = 0; i < range.number; ++i) {
+                densified[range.index[i]] = range.value[i];
+            }
+            for (std::size_t i = 0; i < indices.size(); ++i) {
+                EXPECT_EQ(densified[indices[i]], rptr[i]);
+            }
+        }
+    }
+
+    reset_counts();
+    {
+        auto ext = combined->dense_column(std::make_shared<tatami::ConsecutiveOracle<int> >(0, ncol), indices);
+        EXPECT_EQ(extractor_counts(), expected_counts);
+        EXPECT_EQ(oracle_counts(), expected_counts);
+        auto rext = ref->dense_column(indices);
+        std::vector<double> buffer(indices.size()), rbuffer(indices.size());
+        for (int c = 0; c < ncol; ++c) {
+            auto ptr = ext->fetch(buffer.data());
+            auto rptr = rext->fetch(c, rbuffer.data());
+            EXPECT_EQ(std::vector<double>(ptr, ptr + indices.size()), std::vector<double>(rptr, rptr + indices.size()));
+        }
+    }
+}
+
 TEST(DelayedBindMisc, AllEmpty) {
     tatami::DelayedBind empty(std::vector<std::shared_ptr<tatami::Matrix<double, int> > >{}, true);
     EXPECT_EQ(empty.nrow(), 0);
@@ -252,6 +565,8 @@ TEST_P(DelayedBindEmptyAccessTest, Empty) {
     tatami_test::test_indexed_access(*bound_dense, *manual, 0, 1, options);
 
     tatami_test::test_full_access(*bound_sparse, *manual, options);
+    tatami_test::test_full_access(*pooled_bound_dense, *manual, options);
+    tatami_test::test_full_access(*pooled_bound_sparse, *manual, options);
     tatami_test::test_block_access(*bound_sparse, *manual, 0, 0, options);
     tatami_test::test_indexed_access(*bound_sparse, *manual, 0, 1, options);
 
@@ -335,6 +650,8 @@ TEST_P(DelayedBindBlockAccessTest, Basic) {
 
     tatami_test::test_block_access(*bound_dense, *manual, interval_info.first, interval_info.second, options);
     tatami_test::test_block_access(*bound_sparse, *manual, interval_info.first, interval_info.second, options);
+    tatami_test::test_block_access(*pooled_bound_dense, *manual, interval_info.first, interval_info.second, options);
+    tatami_test::test_block_access(*pooled_bound_sparse, *manual, interval_info.first, interval_info.second, options);
 
     if (options.use_oracle) {
         tatami_test::test_block_access(*forced_bound_sparse, *manual, interval_info.first, interval_info.second, options);
@@ -377,6 +694,8 @@ TEST_P(DelayedBindIndexedAccessTest, Basic) {
 
     tatami_test::test_indexed_access(*bound_dense, *manual, interval_info.first, interval_info.second, options);
     tatami_test::test_indexed_access(*bound_sparse, *manual, interval_info.first, interval_info.second, options);
+    tatami_test::test_indexed_access(*pooled_bound_dense, *manual, interval_info.first, interval_info.second, options);
+    tatami_test::test_indexed_access(*pooled_bound_sparse, *manual, interval_info.first, interval_info.second, options);
 
     if (options.use_oracle) {
         tatami_test::test_indexed_access(*forced_bound_sparse, *manual, interval_info.first, interval_info.second, options);
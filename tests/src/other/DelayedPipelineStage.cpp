@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory>
+#include <tuple>
+
+#include "tatami/dense/DenseMatrix.hpp"
+#include "tatami/other/DelayedPipelineStage.hpp"
+#include "tatami/isometric/unary/DelayedUnaryIsometricOperation.hpp"
+#include "tatami/isometric/unary/arithmetic_helpers.hpp"
+#include "tatami/sparse/convert_to_compressed_sparse.hpp"
+
+#include "tatami_test/tatami_test.hpp"
+
+class DelayedPipelineStageUtils {
+public:
+    typedef std::tuple<int, int> SimulationParameters;
+
+protected:
+    inline static int nrow = 87, ncol = 109;
+    inline static std::shared_ptr<tatami::NumericMatrix> ref_dense, ref_sparse, staged_dense, staged_sparse;
+    inline static SimulationParameters last_params;
+
+    static std::shared_ptr<tatami::NumericMatrix> build(std::shared_ptr<tatami::NumericMatrix> base, const tatami::AsyncPrefetchExtractorOptions* popt) {
+        auto stage = [&](std::shared_ptr<tatami::NumericMatrix> mat) -> std::shared_ptr<tatami::NumericMatrix> {
+            if (popt == NULL) {
+                return mat;
+            }
+            return std::make_shared<tatami::DelayedPipelineStage<double, int> >(std::move(mat), *popt);
+        };
+
+        // Multiple levels in the tree, each with its own stage.
+        auto add = std::make_shared<tatami::DelayedUnaryIsometricAddScalarHelper<double, double, int, double> >(2.5);
+        auto first = tatami::make_DelayedUnaryIsometricOperation<double>(stage(std::move(base)), std::move(add));
+        auto mult = std::make_shared<tatami::DelayedUnaryIsometricMultiplyScalarHelper<double, double, int, double> >(1.5);
+        auto second = tatami::make_DelayedUnaryIsometricOperation<double>(stage(std::move(first)), std::move(mult));
+        return stage(std::move(second));
+    }
+
+    static void assemble(const SimulationParameters& params) {
+        if (ref_dense && last_params == params) {
+            return;
+        }
+        last_params = params;
+
+        auto simulated = tatami_test::simulate_vector<double>(nrow * ncol, []{
+            tatami_test::SimulateVectorOptions opt;
+            opt.density = 0.1;
+            opt.seed = 2817261;
+            return opt;
+        }());
+
+        std::shared_ptr<tatami::NumericMatrix> dense(new tatami::DenseMatrix<double, int, decltype(simulated)>(nrow, ncol, std::move(simulated), true));
+        auto sparse = tatami::convert_to_compressed_sparse<double, int>(*dense, false, {});
+
+        tatami::AsyncPrefetchExtractorOptions popt;
+        popt.num_buffers = std::get<0>(params);
+        popt.batch_size = std::get<1>(params);
+        ref_dense = build(dense, NULL);
+        ref_sparse = build(sparse, NULL);
+        staged_dense = build(dense, &popt);
+        staged_sparse = build(sparse, &popt);
+    }
+};
+
+/**********************************
+ **********************************/
+
+class DelayedPipelineStageFullTest :
+    public ::testing::TestWithParam<std::tuple<DelayedPipelineStageUtils::SimulationParameters, tatami_test::StandardTestAccessOptions> >,
+    public DelayedPipelineStageUtils
+{
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(DelayedPipelineStageFullTest, Basic) {
+    auto opt = tatami_test::convert_test_access_options(std::get<1>(GetParam()));
+    tatami_test::test_full_access(*staged_dense, *ref_dense, opt);
+    tatami_test::test_full_access(*staged_sparse, *ref_sparse, opt);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DelayedPipelineStage,
+    DelayedPipelineStageFullTest,
+    ::testing::Combine(
+        ::testing::Combine(
+            ::testing::Values(1, 3), // number of buffers
+            ::testing::Values(1, 7) // batch size
+        ),
+        tatami_test::standard_test_access_options_combinations()
+    )
+);
+
+/**********************************
+ **********************************/
+
+class DelayedPipelineStageBlockTest :
+    public ::testing::TestWithParam<std::tuple<DelayedPipelineStageUtils::SimulationParameters, tatami_test::StandardTestAccessOptions, std::pair<double, double> > >,
+    public DelayedPipelineStageUtils {
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(DelayedPipelineStageBlockTest, Basic) {
+    auto tparam = GetParam();
+    auto opt = tatami_test::convert_test_access_options(std::get<1>(tparam));
+    auto block = std::get<2>(tparam);
+    tatami_test::test_block_access(*staged_dense, *ref_dense, block.first, block.second, opt);
+    tatami_test::test_block_access(*staged_sparse, *ref_sparse, block.first, block.second, opt);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DelayedPipelineStage,
+    DelayedPipelineStageBlockTest,
+    ::testing::Combine(
+        ::testing::Combine(
+            ::testing::Values(1, 3),
+            ::testing::Values(1, 7)
+        ),
+        tatami_test::standard_test_access_options_combinations(),
+        ::testing::Values(
+            std::pair(0.0, 0.45),
+            std::pair(0.3, 0.55)
+        )
+    )
+);
+
+/**********************************
+ **********************************/
+
+class DelayedPipelineStageIndexTest :
+    public ::testing::TestWithParam<std::tuple<DelayedPipelineStageUtils::SimulationParameters, tatami_test::StandardTestAccessOptions, std::pair<double, double> > >,
+    public DelayedPipelineStageUtils {
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(DelayedPipelineStageIndexTest, Basic) {
+    auto tparam = GetParam();
+    auto opt = tatami_test::convert_test_access_options(std::get<1>(tparam));
+    auto index = std::get<2>(tparam);
+    tatami_test::test_indexed_access(*staged_dense, *ref_dense, index.first, index.second, opt);
+    tatami_test::test_indexed_access(*staged_sparse, *ref_sparse, index.first, index.second, opt);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DelayedPipelineStage,
+    DelayedPipelineStageIndexTest,
+    ::testing::Combine(
+        ::testing::Combine(
+            ::testing::Values(1, 3),
+            ::testing::Values(1, 7)
+        ),
+        tatami_test::standard_test_access_options_combinations(),
+        ::testing::Values(
+            std::pair(0.0, 0.2),
+            std::pair(0.3, 0.4)
+        )
+    )
+);
+
+/**********************************
+ **********************************/
+
+TEST(DelayedPipelineStage, Properties) {
+    auto simulated = tatami_test::simulate_vector<double>(200, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.density = 0.2;
+        opt.seed = 61823;
+        return opt;
+    }());
+    auto dense = std::make_shared<tatami::DenseMatrix<double, int, decltype(simulated)> >(10, 20, simulated, false);
+    tatami::DelayedPipelineStage<double, int> stage(dense);
+
+    EXPECT_EQ(stage.nrow(), 10);
+    EXPECT_EQ(stage.ncol(), 20);
+    EXPECT_FALSE(stage.is_sparse());
+    EXPECT_EQ(stage.is_sparse_proportion(), 0);
+    EXPECT_FALSE(stage.prefer_rows());
+    EXPECT_EQ(stage.prefer_rows_proportion(), 0);
+    EXPECT_TRUE(stage.uses_oracle(true));
+    EXPECT_TRUE(stage.uses_oracle(false));
+}
@@ -0,0 +1,272 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory>
+#include <tuple>
+#include <cmath>
+
+#include "tatami/dense/DenseMatrix.hpp"
+#include "tatami/other/SparsePlusOffsetMatrix.hpp"
+#include "tatami/sparse/convert_to_compressed_sparse.hpp"
+
+#include "tatami_test/tatami_test.hpp"
+
+class SparsePlusOffsetMatrixUtils {
+public:
+    // Whether to add a scalar, row offsets and column offsets.
+    typedef std::tuple<bool, bool, bool> SimulationParameters;
+
+    static auto simulation_parameter_combinations() {
+        return ::testing::Combine(
+            ::testing::Values(true, false),
+            ::testing::Values(true, false),
+            ::testing::Values(true, false)
+        );
+    }
+
+protected:
+    inline static int nrow = 83, ncol = 97;
+    inline static std::shared_ptr<tatami::NumericMatrix> dense, sparse, ref;
+    inline static SimulationParameters last_params;
+
+    static void assemble(const SimulationParameters& params) {
+        if (ref && last_params == params) {
+            return;
+        }
+        last_params = params;
+
+        auto simulated = tatami_test::simulate_vector<double>(nrow * ncol, []{
+            tatami_test::SimulateVectorOptions opt;
+            opt.density = 0.1;
+            opt.seed = 69418;
+            return opt;
+        }());
+        // Rounding everything to a multiple of a power of two, so that the sums are
+        // exact regardless of the order in which the offsets are added.
+        auto rounder = [](std::vector<double>& x) -> void {
+            for (auto& y : x) {
+                y = std::round(y * 1024) / 1024;
+            }
+        };
+        rounder(simulated);
+
+        auto core = std::make_shared<tatami::DenseMatrix<double, int, std::vector<double> > >(nrow, ncol, simulated, true);
+        auto score = tatami::convert_to_compressed_sparse<double, int>(*core, false, {});
+
+        double scalar = (std::get<0>(params) ? 1.5 : 0);
+        std::vector<double> row_offsets, column_offsets;
+        if (std::get<1>(params)) {
+            row_offsets = tatami_test::simulate_vector<double>(nrow, []{
+                tatami_test::SimulateVectorOptions opt;
+                opt.seed = 12983;
+                return opt;
+            }());
+            rounder(row_offsets);
+        }
+        if (std::get<2>(params)) {
+            column_offsets = tatami_test::simulate_vector<double>(ncol, []{
+                tatami_test::SimulateVectorOptions opt;
+                opt.seed = 9238;
+                return opt;
+            }());
+            rounder(column_offsets);
+        }
+
+        dense.reset(new tatami::SparsePlusOffsetMatrix<double, int>(core, scalar, row_offsets, column_offsets));
+        sparse.reset(new tatami::SparsePlusOffsetMatrix<double, int>(score, scalar, row_offsets, column_offsets));
+
+        auto refvec = simulated;
+        for (int r = 0; r < nrow; ++r) {
+            for (int c = 0; c < ncol; ++c) {
+                auto& current = refvec[r * ncol + c];
+                current += scalar;
+                if (!row_offsets.empty()) {
+                    current += row_offsets[r];
+                }
+                if (!column_offsets.empty()) {
+                    current += column_offsets[c];
+                }
+            }
+        }
+        ref.reset(new tatami::DenseMatrix<double, int, std::vector<double> >(nrow, ncol, std::move(refvec), true));
+    }
+};
+
+/**********************************
+ **********************************/
+
+class SparsePlusOffsetMatrixUtilsTest : public ::testing::TestWithParam<SparsePlusOffsetMatrixUtils::SimulationParameters>, public SparsePlusOffsetMatrixUtils {
+protected:
+    void SetUp() {
+        assemble(GetParam());
+    }
+};
+
+TEST_P(SparsePlusOffsetMatrixUtilsTest, Basic) {
+    EXPECT_EQ(sparse->nrow(), nrow);
+    EXPECT_EQ(sparse->ncol(), ncol);
+    EXPECT_FALSE(dense->is_sparse());
+    EXPECT_EQ(dense->is_sparse_proportion(), 0);
+    EXPECT_TRUE(dense->prefer_rows());
+    EXPECT_FALSE(sparse->prefer_rows());
+
+    auto params = GetParam();
+    bool has_offsets = std::get<0>(params) || std::get<1>(params) || std::get<2>(params);
+    EXPECT_EQ(sparse->is_sparse(), !has_offsets);
+    EXPECT_EQ(sparse->is_sparse_proportion(), static_cast<double>(!has_offsets));
+
+    auto sptr = static_cast<const tatami::SparsePlusOffsetMatrix<double, int>*>(sparse.get());
+    EXPECT_TRUE(sptr->core()->is_sparse());
+    EXPECT_EQ(sptr->scalar_offset(), (std::get<0>(params) ? 1.5 : 0));
+    EXPECT_EQ(sptr->row_offsets().size(), (std::get<1>(params) ? nrow : 0));
+    EXPECT_EQ(sptr->column_offsets().size(), (std::get<2>(params) ? ncol : 0));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SparsePlusOffsetMatrix,
+    SparsePlusOffsetMatrixUtilsTest,
+    SparsePlusOffsetMatrixUtils::simulation_parameter_combinations()
+);
+
+TEST(SparsePlusOffsetMatrix, Errors) {
+    auto core = std::make_shared<tatami::DenseMatrix<double, int, std::vector<double> > >(10, 20, std::vector<double>(200), true);
+    tatami_test::throws_error([&]() {
+        tatami::SparsePlusOffsetMatrix<double, int>(core, 0, std::vector<double>(5), std::vector<double>());
+    }, "number of rows");
+    tatami_test::throws_error([&]() {
+        tatami::SparsePlusOffsetMatrix<double, int>(core, 0, std::vector<double>(), std::vector<double>(5));
+    }, "number of columns");
+}
+
+TEST(SparsePlusOffsetMatrix, ZeroOffsets) {
+    std::vector<double> simulated(200);
+    for (int i = 0; i < 200; i += 7) {
+        simulated[i] = i;
+    }
+    simulated[1] = -0.0;
+    auto core = std::make_shared<tatami::DenseMatrix<double, int, std::vector<double> > >(10, 20, simulated, true);
+    auto score = tatami::convert_to_compressed_sparse<double, int>(*core, true, {});
+
+    // All-zero offsets are treated as if they were absent.
+    tatami::SparsePlusOffsetMatrix<double, int> mat(score, 0, std::vector<double>(10), std::vector<double>(20));
+    EXPECT_TRUE(mat.is_sparse());
+    EXPECT_EQ(mat.row_offsets().size(), 10);
+    EXPECT_EQ(mat.column_offsets().size(), 20);
+    tatami_test::test_simple_row_access(mat, *core);
+    tatami_test::test_simple_column_access(mat, *core);
+
+    // Dense extraction is directly forwarded to the core, so negative zeros are preserved.
+    tatami::SparsePlusOffsetMatrix<double, int> dmat(core, 0, std::vector<double>(), std::vector<double>());
+    std::vector<double> buffer(20);
+    auto ext = dmat.dense_row();
+    auto ptr = ext->fetch(0, buffer.data());
+    EXPECT_EQ(ptr[1], 0);
+    EXPECT_TRUE(std::signbit(ptr[1]));
+
+    // Any non-zero offset is respected.
+    std::vector<double> row_offsets(10);
+    row_offsets[3] = 1;
+    tatami::SparsePlusOffsetMatrix<double, int> omat(score, 0, row_offsets, std::vector<double>(20));
+    EXPECT_FALSE(omat.is_sparse());
+    auto oext = omat.dense_row();
+    ptr = oext->fetch(3, buffer.data());
+    for (int c = 0; c < 20; ++c) {
+        EXPECT_EQ(ptr[c], simulated[3 * 20 + c] + 1);
+    }
+}
+
+/**********************************
+ **********************************/
+
+class SparsePlusOffsetMatrixFullTest :
+    public ::testing::TestWithParam<std::tuple<SparsePlusOffsetMatrixUtils::SimulationParameters, tatami_test::StandardTestAccessOptions> >,
+    public SparsePlusOffsetMatrixUtils
+{
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(SparsePlusOffsetMatrixFullTest, Basic) {
+    auto opt = tatami_test::convert_test_access_options(std::get<1>(GetParam()));
+    tatami_test::test_full_access(*dense, *ref, opt);
+    tatami_test::test_full_access(*sparse, *ref, opt);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SparsePlusOffsetMatrix,
+    SparsePlusOffsetMatrixFullTest,
+    ::testing::Combine(
+        SparsePlusOffsetMatrixUtils::simulation_parameter_combinations(),
+        tatami_test::standard_test_access_options_combinations()
+    )
+);
+
+/**********************************
+ **********************************/
+
+class SparsePlusOffsetMatrixBlockTest :
+    public ::testing::TestWithParam<std::tuple<SparsePlusOffsetMatrixUtils::SimulationParameters, tatami_test::StandardTestAccessOptions, std::pair<double, double> > >,
+    public SparsePlusOffsetMatrixUtils {
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(SparsePlusOffsetMatrixBlockTest, Basic) {
+    auto tparam = GetParam();
+    auto opt = tatami_test::convert_test_access_options(std::get<1>(tparam));
+    auto block = std::get<2>(tparam);
+    tatami_test::test_block_access(*dense, *ref, block.first, block.second, opt);
+    tatami_test::test_block_access(*sparse, *ref, block.first, block.second, opt);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SparsePlusOffsetMatrix,
+    SparsePlusOffsetMatrixBlockTest,
+    ::testing::Combine(
+        SparsePlusOffsetMatrixUtils::simulation_parameter_combinations(),
+        tatami_test::standard_test_access_options_combinations(),
+        ::testing::Values(
+            std::pair(0.0, 0.35),
+            std::pair(0.33, 0.4),
+            std::pair(0.6, 0.4)
+        )
+    )
+);
+
+/**********************************
+ **********************************/
+
+class SparsePlusOffsetMatrixIndexTest :
+    public ::testing::TestWithParam<std::tuple<SparsePlusOffsetMatrixUtils::SimulationParameters, tatami_test::StandardTestAccessOptions, std::pair<double, double> > >,
+    public SparsePlusOffsetMatrixUtils {
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(SparsePlusOffsetMatrixIndexTest, Basic) {
+    auto tparam = GetParam();
+    auto opt = tatami_test::convert_test_access_options(std::get<1>(tparam));
+    auto index = std::get<2>(tparam);
+    tatami_test::test_indexed_access(*dense, *ref, index.first, index.second, opt);
+    tatami_test::test_indexed_access(*sparse, *ref, index.first, index.second, opt);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SparsePlusOffsetMatrix,
+    SparsePlusOffsetMatrixIndexTest,
+    ::testing::Combine(
+        SparsePlusOffsetMatrixUtils::simulation_parameter_combinations(),
+        tatami_test::standard_test_access_options_combinations(),
+        ::testing::Values(
+            std::pair(0.0, 0.2),
+            std::pair(0.2, 0.5),
+            std::pair(0.4, 0.3)
+        )
+    )
+);
@@ -3,6 +3,9 @@
 #include <vector>
 #include <memory>
 #include <cstddef>
+#include <random>
+#include <numeric>
+#include <utility>
 
 #include "tatami/sparse/secondary_extraction.hpp"
 #include "tatami/utils/ElementType.hpp"
@@ -484,3 +487,116 @@ TEST_F(SparseSecondaryExtractionCacheTest, Fragmented) {
         EXPECT_EQ(results, expected(5, -1, -1));
     }
 }
+
+class SparseSecondaryExtractionCacheHeapTest : public ::testing::TestWithParam<double> {
+protected:
+    template<typename Index_, class IndexStorage_, class PointerStorage_>
+    struct ServeIndices {
+        ServeIndices(const IndexStorage_& i, const PointerStorage_& p) : indices(i), indptr(p) {}
+        const IndexStorage_& indices;
+        const PointerStorage_& indptr;
+
+    public:
+        typedef tatami::ElementType<PointerStorage_> Pointer;
+
+        Pointer start_offset(Index_ primary) const {
+            return indptr[primary];
+        }
+
+        Pointer end_offset(Index_ primary) const {
+            return indptr[primary + 1];
+        }
+
+        auto raw(Index_) const {
+            return indices.begin();
+        }
+    };
+
+    static constexpr int NP = 200, NS = 100;
+    std::vector<int> indices;
+    std::vector<std::size_t> indptrs;
+
+    void SetUp() {
+        std::mt19937_64 rng(static_cast<int>(GetParam() * 1000) + 42);
+        std::uniform_real_distribution<double> dist;
+        indptrs.push_back(0);
+        for (int p = 0; p < NP; ++p) {
+            for (int s = 0; s < NS; ++s) {
+                if (dist(rng) < GetParam()) {
+                    indices.push_back(s);
+                }
+            }
+            indptrs.push_back(indices.size());
+        }
+    }
+
+    // Brute-force search for the position of 'secondary' in each primary element.
+    std::vector<std::pair<int, std::size_t> > reference(int primary, int secondary) const {
+        std::vector<std::pair<int, std::size_t> > output;
+        for (auto x = indptrs[primary], end = indptrs[primary + 1]; x < end; ++x) {
+            if (indices[x] == secondary) {
+                output.emplace_back(primary, x);
+            }
+        }
+        return output;
+    }
+
+    template<class Cache_>
+    void check(Cache_& cache, const std::vector<int>& subset, const std::vector<int>& requests) {
+        for (auto r : requests) {
+            std::vector<std::pair<int, std::size_t> > observed;
+            cache.search(r, [&](int primary, int index_primary, std::size_t ptr) -> void {
+                EXPECT_EQ(subset[index_primary], primary);
+                observed.emplace_back(primary, ptr);
+            });
+
+            std::vector<std::pair<int, std::size_t> > expected;
+            for (auto p : subset) {
+                auto current = reference(p, r);
+                expected.insert(expected.end(), current.begin(), current.end());
+            }
+            EXPECT_EQ(observed, expected);
+        }
+    }
+};
+
+TEST_P(SparseSecondaryExtractionCacheHeapTest, Basic) {
+    const double density = GetParam();
+    std::vector<int> subset;
+    for (int p = 1; p < NP; p += 3) {
+        subset.push_back(p);
+    }
+
+    std::vector<int> requests;
+    for (int s = 0; s < NS; s += 2) { // increasing.
+        requests.push_back(s);
+        requests.push_back(s); // repeated.
+    }
+    for (int s = NS - 1; s >= 0; s -= 3) { // decreasing.
+        requests.push_back(s);
+    }
+    for (int s = 5; s < NS; s += 7) { // increasing again with jumps.
+        requests.push_back(s);
+    }
+    requests.push_back(NS - 1);
+    requests.push_back(0);
+    requests.push_back(1);
+
+    auto subset_ptr = std::make_shared<std::vector<int> >(subset);
+    ServeIndices<int, decltype(indices), decltype(indptrs)> server(indices, indptrs);
+    tatami::sparse_utils::IndexSecondaryExtractionCache<int, decltype(server)> cache(server, NS, subset_ptr);
+    EXPECT_EQ(cache.uses_heap(), density < 0.1);
+    check(cache, subset, requests);
+
+    std::vector<int> full(NP);
+    std::iota(full.begin(), full.end(), 0);
+    tatami::sparse_utils::FullSecondaryExtractionCache<int, decltype(server)> fcache(server, NS, NP);
+    EXPECT_EQ(fcache.uses_heap(), density < 0.1);
+    check(fcache, full, requests);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SparseSecondaryExtractionCache,
+    SparseSecondaryExtractionCacheHeapTest,
+    ::testing::Values(0.01, 0.05, 0.5, 1) // density
+);
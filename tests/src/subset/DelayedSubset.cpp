@@ -381,3 +381,105 @@ TEST(DelayedSubset, ArrayView) {
     EXPECT_EQ(sub->ncol(), NC);
     EXPECT_EQ(sub->nrow(), subset.size());
 }
+
+TEST(DelayedSubset, Collapse) {
+    int NR = 40, NC = 45;
+    auto vec = tatami_test::simulate_vector<double>(NR * NC, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.density = 0.3;
+        opt.seed = 716231;
+        return opt;
+    }());
+    auto dense = std::shared_ptr<const tatami::NumericMatrix>(new tatami::DenseRowMatrix<double, int>(NR, NC, std::move(vec)));
+
+    auto get_underlying = [](const std::shared_ptr<tatami::NumericMatrix>& mat) -> const tatami::NumericMatrix* {
+        auto collapsible = dynamic_cast<const tatami::subset_utils::Collapsible<double, int>*>(mat.get());
+        if (collapsible == NULL) {
+            return NULL;
+        }
+        return collapsible->underlying_matrix().get();
+    };
+
+    std::vector<std::vector<int> > layers {
+        { 1, 5, 5, 3, 20, 33, 0, 2, 39, 4, 8, 11 }, // unsorted with duplicates.
+        { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }, // block.
+        { 0, 2, 4, 6, 8 }, // strided.
+        { 4, 3 }
+    };
+
+    for (int d = 0; d < 2; ++d) {
+        const bool by_row = (d == 0);
+        std::shared_ptr<tatami::NumericMatrix> nested = std::const_pointer_cast<tatami::NumericMatrix>(dense);
+        std::vector<int> composed;
+
+        for (const auto& layer : layers) {
+            if (composed.empty()) {
+                composed = layer;
+            } else {
+                std::vector<int> next;
+                for (auto l : layer) {
+                    next.push_back(composed[l]);
+                }
+                composed.swap(next);
+            }
+
+            nested = tatami::make_DelayedSubset(nested, layer, by_row);
+            EXPECT_EQ(get_underlying(nested), dense.get());
+
+            auto ref = tatami::make_DelayedSubset(dense, composed, by_row);
+            tatami_test::test_simple_row_access(*nested, *ref);
+            tatami_test::test_simple_column_access(*nested, *ref);
+        }
+    }
+
+    // Subsets on different dimensions are combined into a 2-dimensional subset.
+    {
+        auto rsub = tatami::make_DelayedSubset(dense, std::vector<int>{ 1, 3, 5 }, true);
+        auto csub = tatami::make_DelayedSubset(rsub, std::vector<int>{ 2, 4, 6 }, false);
+        auto as2d = dynamic_cast<const tatami::DelayedSubset2D<double, int>*>(csub.get());
+        ASSERT_TRUE(as2d != NULL);
+        EXPECT_EQ(as2d->underlying_matrix().get(), dense.get());
+        EXPECT_EQ(as2d->row_subset(), std::vector<int>({ 1, 3, 5 }));
+        EXPECT_EQ(as2d->column_subset(), std::vector<int>({ 2, 4, 6 }));
+    }
+
+    // No collapsing if explicitly requested.
+    {
+        auto rsub = tatami::make_DelayedSubset(dense, std::vector<int>{ 1, 3, 5 }, true);
+        tatami::MakeDelayedSubsetOptions mopt;
+        mopt.collapse = false;
+        auto rsub2 = tatami::make_DelayedSubset(rsub, std::vector<int>{ 2, 0 }, true, mopt);
+        EXPECT_EQ(get_underlying(rsub2), rsub.get());
+    }
+}
+
+TEST(DelayedSubset, OrderedSparse) {
+    // Checking that both the sort and scan paths are used for reordering sparse values.
+    int NR = 60, NC = 50;
+    for (auto density : { 0.02, 0.95 }) {
+        auto vec = tatami_test::simulate_vector<double>(NR * NC, [&]{
+            tatami_test::SimulateVectorOptions opt;
+            opt.density = density;
+            opt.seed = 1827361 + density * 100;
+            return opt;
+        }());
+        auto dense = std::shared_ptr<const tatami::NumericMatrix>(new tatami::DenseRowMatrix<double, int>(NR, NC, std::move(vec)));
+        auto sparse = tatami::convert_to_compressed_sparse<double, int>(*dense, true, {});
+
+        std::vector<int> duplicated { 19, 3, 3, 7, 45, 0, 12, 30, 30, 30, 8, 1, 44, 21, 6, 5, 9, 33 };
+        std::vector<int> unique { 19, 3, 7, 45, 0, 12, 30, 8, 1, 44, 21, 6, 5, 9, 33, 2, 48, 26 };
+
+        for (int d = 0; d < 2; ++d) {
+            const bool by_row = (d == 0);
+            auto ref = tatami::make_DelayedSubset(dense, duplicated, by_row);
+            auto sub = tatami::make_DelayedSubset(sparse, duplicated, by_row);
+            tatami_test::test_simple_row_access(*sub, *ref);
+            tatami_test::test_simple_column_access(*sub, *ref);
+
+            auto uref = tatami::make_DelayedSubset(dense, unique, by_row);
+            auto usub = tatami::make_DelayedSubset(sparse, unique, by_row);
+            tatami_test::test_simple_row_access(*usub, *uref);
+            tatami_test::test_simple_column_access(*usub, *uref);
+        }
+    }
+}
@@ -0,0 +1,385 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory>
+#include <tuple>
+#include <random>
+#include <algorithm>
+
+#include "tatami/dense/DenseMatrix.hpp"
+#include "tatami/subset/DelayedSubset2D.hpp"
+#include "tatami/subset/make_DelayedSubset.hpp"
+#include "tatami/sparse/convert_to_compressed_sparse.hpp"
+#include "tatami/utils/consecutive_extractor.hpp"
+
+#include "tatami_test/tatami_test.hpp"
+
+class Subset2DUtils {
+protected:
+    inline static int NR = 97, NC = 113;
+    inline static std::vector<double> simulated;
+    inline static std::shared_ptr<tatami::NumericMatrix> dense, sparse;
+
+    static void assemble() {
+        if (dense) {
+            return;
+        }
+
+        simulated = tatami_test::simulate_vector<double>(NR * NC, []{
+            tatami_test::SimulateVectorOptions opt;
+            opt.density = 0.2;
+            opt.seed = 9172387;
+            return opt;
+        }());
+
+        dense = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double, int>(NR, NC, simulated));
+        sparse = tatami::convert_to_compressed_sparse<false, double, int>(dense.get()); // column-major.
+    }
+
+    static std::vector<int> spawn_subset(int choice, int full) {
+        std::vector<int> output;
+        if (choice == 0) { // contiguous block.
+            for (int i = full / 5; i < full / 2; ++i) {
+                output.push_back(i);
+            }
+        } else if (choice == 1) { // strided.
+            for (int i = 1; i < full; i += 3) {
+                output.push_back(i);
+            }
+        } else { // unsorted with duplicates.
+            std::mt19937_64 rng(full * 10 + choice);
+            for (int i = 0; i < full; i += 2) {
+                output.push_back(rng() % full);
+            }
+        }
+        return output;
+    }
+
+public:
+    typedef std::tuple<int, int> SimulationParameters;
+
+    static auto simulation_parameter_combinations() {
+        return ::testing::Combine(
+            ::testing::Values(0, 1, 2), // choice of row subset.
+            ::testing::Values(0, 1, 2) // choice of column subset.
+        );
+    }
+
+protected:
+    inline static std::shared_ptr<tatami::NumericMatrix> dense_sub, sparse_sub, uns_sparse_sub, ref;
+    inline static SimulationParameters last_params;
+
+    static void assemble(SimulationParameters sim_params) {
+        if (ref && last_params == sim_params) {
+            return;
+        }
+        last_params = sim_params;
+
+        assemble();
+
+        auto rsub = spawn_subset(std::get<0>(sim_params), NR);
+        auto csub = spawn_subset(std::get<1>(sim_params), NC);
+
+        std::vector<double> sub;
+        sub.reserve(rsub.size() * csub.size());
+        for (auto r : rsub) {
+            auto row = simulated.data() + r * NC;
+            for (auto c : csub) {
+                sub.push_back(row[c]);
+            }
+        }
+        ref.reset(new tatami::DenseRowMatrix<double, int>(rsub.size(), csub.size(), std::move(sub)));
+
+        dense_sub.reset(new tatami::DelayedSubset2D<double, int>(dense, rsub, csub));
+        sparse_sub.reset(new tatami::DelayedSubset2D<double, int>(sparse, rsub, csub));
+        uns_sparse_sub.reset(new tatami::DelayedSubset2D<double, int>(std::make_shared<const tatami_test::ReversedIndicesWrapper<double, int> >(sparse), rsub, csub));
+    }
+};
+
+/*****************************
+ *****************************/
+
+class Subset2DTest : 
+    public ::testing::TestWithParam<typename Subset2DUtils::SimulationParameters>, 
+    public Subset2DUtils {
+protected:
+    void SetUp() {
+        assemble(GetParam());
+    }
+};
+
+TEST_P(Subset2DTest, Basic) {
+    EXPECT_EQ(ref->nrow(), dense_sub->nrow());
+    EXPECT_EQ(ref->ncol(), dense_sub->ncol());
+
+    EXPECT_FALSE(dense_sub->is_sparse());
+    EXPECT_EQ(dense_sub->is_sparse_proportion(), 0);
+    EXPECT_TRUE(sparse_sub->is_sparse());
+    EXPECT_EQ(sparse_sub->is_sparse_proportion(), 1);
+
+    EXPECT_TRUE(dense_sub->prefer_rows());
+    EXPECT_EQ(dense_sub->prefer_rows_proportion(), 1);
+    EXPECT_FALSE(sparse_sub->prefer_rows());
+    EXPECT_EQ(sparse_sub->prefer_rows_proportion(), 0);
+
+    EXPECT_FALSE(dense_sub->uses_oracle(false));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DelayedSubset2D,
+    Subset2DTest,
+    Subset2DUtils::simulation_parameter_combinations()
+);
+
+/*****************************
+ *****************************/
+
+class Subset2DFullAccessTest : 
+    public ::testing::TestWithParam<std::tuple<Subset2DUtils::SimulationParameters, tatami_test::StandardTestAccessOptions> >, 
+    public Subset2DUtils {
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(Subset2DFullAccessTest, Basic) {
+    auto tparam = GetParam();
+    auto options = tatami_test::convert_test_access_options(std::get<1>(tparam));
+    tatami_test::test_full_access(*dense_sub, *ref, options);
+    tatami_test::test_full_access(*sparse_sub, *ref, options);
+    tatami_test::test_unsorted_full_access(*uns_sparse_sub, options);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DelayedSubset2D,
+    Subset2DFullAccessTest,
+    ::testing::Combine(
+        Subset2DUtils::simulation_parameter_combinations(),
+        tatami_test::standard_test_access_options_combinations()
+    )
+);
+
+/*****************************
+ *****************************/
+
+class Subset2DBlockAccessTest : 
+    public ::testing::TestWithParam<std::tuple<Subset2DUtils::SimulationParameters, tatami_test::StandardTestAccessOptions, std::pair<double, double> > >,
+    public Subset2DUtils {
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(Subset2DBlockAccessTest, Block) {
+    auto tparam = GetParam();
+    auto options = tatami_test::convert_test_access_options(std::get<1>(tparam));
+    auto interval_info = std::get<2>(tparam);
+    tatami_test::test_block_access(*dense_sub, *ref, interval_info.first, interval_info.second, options);
+    tatami_test::test_block_access(*sparse_sub, *ref, interval_info.first, interval_info.second, options);
+    tatami_test::test_unsorted_block_access(*uns_sparse_sub, interval_info.first, interval_info.second, options);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DelayedSubset2D,
+    Subset2DBlockAccessTest,
+    ::testing::Combine(
+        Subset2DUtils::simulation_parameter_combinations(),
+        tatami_test::standard_test_access_options_combinations(),
+        ::testing::Values(
+            std::make_pair(0.0, 0.45), 
+            std::make_pair(0.56, 0.44)
+        )
+    )
+);
+
+/*****************************
+ *****************************/
+
+class Subset2DIndexedAccessTest : 
+    public ::testing::TestWithParam<std::tuple<Subset2DUtils::SimulationParameters, tatami_test::StandardTestAccessOptions, std::pair<double, double> > >, 
+    public Subset2DUtils {
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(Subset2DIndexedAccessTest, Indexed) {
+    auto tparam = GetParam();
+    auto options = tatami_test::convert_test_access_options(std::get<1>(tparam));
+    auto interval_info = std::get<2>(tparam);
+    tatami_test::test_indexed_access(*dense_sub, *ref, interval_info.first, interval_info.second, options);
+    tatami_test::test_indexed_access(*sparse_sub, *ref, interval_info.first, interval_info.second, options);
+    tatami_test::test_unsorted_indexed_access(*uns_sparse_sub, interval_info.first, interval_info.second, options);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DelayedSubset2D,
+    Subset2DIndexedAccessTest,
+    ::testing::Combine(
+        Subset2DUtils::simulation_parameter_combinations(),
+        tatami_test::standard_test_access_options_combinations(),
+        ::testing::Values(
+            std::make_pair(0.0, 0.15), 
+            std::make_pair(0.33, 0.2)
+        )
+    )
+);
+
+/****************************************************
+ ****************************************************/
+
+TEST(DelayedSubset2D, Maker) {
+    int NR = 50, NC = 40;
+    auto vec = tatami_test::simulate_vector<double>(NR * NC, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.seed = 8172635;
+        return opt;
+    }());
+    auto dense = std::shared_ptr<const tatami::NumericMatrix>(new tatami::DenseRowMatrix<double, int>(NR, NC, std::move(vec)));
+
+    std::vector<int> rsub1 { 5, 2, 9, 9, 30, 41, 0 }, csub1 { 10, 11, 12, 13, 14, 15 }, rsub2 { 6, 0, 2 }, csub2 { 5, 3, 1 };
+    auto step1 = tatami::make_DelayedSubset(dense, rsub1, true);
+    auto step2 = tatami::make_DelayedSubset(step1, csub1, false);
+    auto step3 = tatami::make_DelayedSubset(step2, rsub2, true);
+    auto step4 = tatami::make_DelayedSubset(step3, csub2, false);
+
+    auto as2d = dynamic_cast<const tatami::DelayedSubset2D<double, int>*>(step4.get());
+    ASSERT_TRUE(as2d != NULL);
+    EXPECT_EQ(as2d->underlying_matrix().get(), dense.get());
+    EXPECT_EQ(as2d->row_subset(), std::vector<int>({ 0, 5, 9 }));
+    EXPECT_EQ(as2d->column_subset(), std::vector<int>({ 15, 13, 11 }));
+
+    // Comparing to a stack of subsets without any collapsing.
+    tatami::MakeDelayedSubsetOptions mopt;
+    mopt.collapse = false;
+    auto ref = tatami::make_DelayedSubset(dense, rsub1, true, mopt);
+    ref = tatami::make_DelayedSubset(ref, csub1, false, mopt);
+    ref = tatami::make_DelayedSubset(ref, rsub2, true, mopt);
+    ref = tatami::make_DelayedSubset(ref, csub2, false, mopt);
+    tatami_test::test_simple_row_access(*step4, *ref);
+    tatami_test::test_simple_column_access(*step4, *ref);
+}
+
+// Capturing the oracles passed to the underlying matrix, to check that the subset structure is reported.
+class OracleCapturingMatrix final : public tatami::Matrix<double, int> {
+public:
+    OracleCapturingMatrix(std::shared_ptr<const tatami::Matrix<double, int> > matrix) : my_matrix(std::move(matrix)) {}
+
+    mutable std::vector<std::shared_ptr<const tatami::Oracle<int> > > captured;
+
+private:
+    std::shared_ptr<const tatami::Matrix<double, int> > my_matrix;
+
+public:
+    int nrow() const { return my_matrix->nrow(); }
+    int ncol() const { return my_matrix->ncol(); }
+    bool is_sparse() const { return my_matrix->is_sparse(); }
+    double is_sparse_proportion() const { return my_matrix->is_sparse_proportion(); }
+    bool prefer_rows() const { return my_matrix->prefer_rows(); }
+    double prefer_rows_proportion() const { return my_matrix->prefer_rows_proportion(); }
+    bool uses_oracle(bool row) const { return my_matrix->uses_oracle(row); }
+
+    using tatami::Matrix<double, int>::dense;
+    using tatami::Matrix<double, int>::sparse;
+
+    std::unique_ptr<tatami::MyopicDenseExtractor<double, int> > dense(bool row, const tatami::Options& opt) const {
+        return my_matrix->dense(row, opt);
+    }
+    std::unique_ptr<tatami::MyopicDenseExtractor<double, int> > dense(bool row, int s, int l, const tatami::Options& opt) const {
+        return my_matrix->dense(row, s, l, opt);
+    }
+    std::unique_ptr<tatami::MyopicDenseExtractor<double, int> > dense(bool row, tatami::VectorPtr<int> i, const tatami::Options& opt) const {
+        return my_matrix->dense(row, std::move(i), opt);
+    }
+    std::unique_ptr<tatami::MyopicSparseExtractor<double, int> > sparse(bool row, const tatami::Options& opt) const {
+        return my_matrix->sparse(row, opt);
+    }
+    std::unique_ptr<tatami::MyopicSparseExtractor<double, int> > sparse(bool row, int s, int l, const tatami::Options& opt) const {
+        return my_matrix->sparse(row, s, l, opt);
+    }
+    std::unique_ptr<tatami::MyopicSparseExtractor<double, int> > sparse(bool row, tatami::VectorPtr<int> i, const tatami::Options& opt) const {
+        return my_matrix->sparse(row, std::move(i), opt);
+    }
+
+    std::unique_ptr<tatami::OracularDenseExtractor<double, int> > dense(bool row, std::shared_ptr<const tatami::Oracle<int> > o, const tatami::Options& opt) const {
+        captured.push_back(o);
+        return my_matrix->dense(row, std::move(o), opt);
+    }
+    std::unique_ptr<tatami::OracularDenseExtractor<double, int> > dense(bool row, std::shared_ptr<const tatami::Oracle<int> > o, int s, int l, const tatami::Options& opt) const {
+        captured.push_back(o);
+        return my_matrix->dense(row, std::move(o), s, l, opt);
+    }
+    std::unique_ptr<tatami::OracularDenseExtractor<double, int> > dense(bool row, std::shared_ptr<const tatami::Oracle<int> > o, tatami::VectorPtr<int> i, const tatami::Options& opt) const {
+        captured.push_back(o);
+        return my_matrix->dense(row, std::move(o), std::move(i), opt);
+    }
+    std::unique_ptr<tatami::OracularSparseExtractor<double, int> > sparse(bool row, std::shared_ptr<const tatami::Oracle<int> > o, const tatami::Options& opt) const {
+        captured.push_back(o);
+        return my_matrix->sparse(row, std::move(o), opt);
+    }
+    std::unique_ptr<tatami::OracularSparseExtractor<double, int> > sparse(bool row, std::shared_ptr<const tatami::Oracle<int> > o, int s, int l, const tatami::Options& opt) const {
+        captured.push_back(o);
+        return my_matrix->sparse(row, std::move(o), s, l, opt);
+    }
+    std::unique_ptr<tatami::OracularSparseExtractor<double, int> > sparse(bool row, std::shared_ptr<const tatami::Oracle<int> > o, tatami::VectorPtr<int> i, const tatami::Options& opt) const {
+        captured.push_back(o);
+        return my_matrix->sparse(row, std::move(o), std::move(i), opt);
+    }
+};
+
+TEST(DelayedSubset2D, OracleStructure) {
+    int NR = 50, NC = 40;
+    auto vec = tatami_test::simulate_vector<double>(NR * NC, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.seed = 1928374;
+        return opt;
+    }());
+    auto dense = std::shared_ptr<const tatami::NumericMatrix>(new tatami::DenseRowMatrix<double, int>(NR, NC, std::move(vec)));
+    auto capture = std::make_shared<OracleCapturingMatrix>(dense);
+
+    std::vector<int> rsub { 2, 5, 8, 11, 14 }, csub { 3, 3, 9, 20 };
+    tatami::DelayedSubset2D<double, int> sub(capture, rsub, csub);
+    tatami::DelayedSubset2D<double, int> ref(dense, rsub, csub);
+
+    // Row subset is strided, so a consecutive oracle on the rows should be reported as strided to the underlying matrix.
+    {
+        auto ext = tatami::consecutive_extractor<false>(sub, true, 0, 5);
+        ASSERT_EQ(capture->captured.size(), 1);
+        const auto& oracle = *(capture->captured.back());
+        EXPECT_TRUE(oracle.is_increasing());
+        EXPECT_TRUE(oracle.is_strided());
+        EXPECT_EQ(oracle.stride(), 3);
+        EXPECT_FALSE(oracle.is_consecutive());
+
+        auto rext = tatami::consecutive_extractor<false>(ref, true, 0, 5);
+        std::vector<double> buffer(csub.size()), rbuffer(csub.size());
+        for (int r = 0; r < 5; ++r) {
+            auto ptr = ext->fetch(buffer.data());
+            auto rptr = rext->fetch(rbuffer.data());
+            EXPECT_EQ(std::vector<double>(ptr, ptr + csub.size()), std::vector<double>(rptr, rptr + csub.size()));
+        }
+    }
+
+    // Column subset is sorted but not unique.
+    {
+        auto ext = tatami::consecutive_extractor<true>(sub, false, 0, 4);
+        ASSERT_EQ(capture->captured.size(), 2);
+        const auto& oracle = *(capture->captured.back());
+        EXPECT_TRUE(oracle.is_increasing());
+        EXPECT_FALSE(oracle.is_strided());
+
+        auto rext = tatami::consecutive_extractor<true>(ref, false, 0, 4);
+        std::vector<double> vbuffer(rsub.size()), rvbuffer(rsub.size());
+        std::vector<int> ibuffer(rsub.size()), ribuffer(rsub.size());
+        for (int c = 0; c < 4; ++c) {
+            auto range = ext->fetch(vbuffer.data(), ibuffer.data());
+            auto rrange = rext->fetch(rvbuffer.data(), ribuffer.data());
+            ASSERT_EQ(range.number, rrange.number);
+            EXPECT_EQ(std::vector<double>(range.value, range.value + range.number), std::vector<double>(rrange.value, rrange.value + rrange.number));
+            EXPECT_EQ(std::vector<int>(range.index, range.index + range.number), std::vector<int>(rrange.index, rrange.index + rrange.number));
+        }
+    }
+}
@@ -0,0 +1,371 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory>
+
+#include "tatami/dense/DenseMatrix.hpp"
+#include "tatami/subset/DelayedSubsetMultiBlock.hpp"
+#include "tatami/subset/make_DelayedSubset.hpp"
+#include "tatami/sparse/convert_to_compressed_sparse.hpp"
+#include "tatami/utils/ConsecutiveOracle.hpp"
+
+#include "tatami_test/tatami_test.hpp"
+
+class SubsetMultiBlockUtils {
+protected:
+    inline static int NR = 153, NC = 121;
+    inline static std::vector<double> simulated;
+    inline static std::shared_ptr<tatami::NumericMatrix> dense, sparse;
+
+    static void assemble() {
+        if (dense) {
+            return;
+        }
+
+        simulated = tatami_test::simulate_vector<double>(NR * NC, []{
+            tatami_test::SimulateVectorOptions opt;
+            opt.density = 0.2;
+            opt.seed = 6172893;
+            return opt;
+        }());
+
+        dense = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double, int>(NR, NC, simulated));
+        sparse = tatami::convert_to_compressed_sparse<false, double, int>(dense.get()); // column-major.
+    }
+
+public:
+    typedef std::tuple<bool, int> SimulationParameters;
+
+    static auto simulation_parameter_combinations() {
+        return ::testing::Combine(
+            ::testing::Values(true, false), // row or column subsetting, respectively.
+            ::testing::Values(0, 1, 2, 3) // choice of blocks.
+        );
+    }
+
+protected:
+    inline static std::shared_ptr<tatami::NumericMatrix> dense_multiblock, sparse_multiblock, uns_sparse_multiblock, ref;
+    inline static SimulationParameters last_params;
+
+    static void choose_blocks(int choice, int full, std::vector<int>& starts, std::vector<int>& lengths) {
+        starts.clear();
+        lengths.clear();
+        auto add = [&](double first, double last) -> void {
+            int s = full * first, e = full * last;
+            starts.push_back(s);
+            lengths.push_back(e - s);
+        };
+
+        if (choice == 0) {
+            add(0, 0.5);
+        } else if (choice == 1) {
+            add(0, 0.2);
+            add(0.3, 0.5);
+            add(0.5, 0.6); // adjacent to the previous block.
+            add(0.9, 1);
+        } else if (choice == 2) {
+            for (int s = 1; s + 3 <= full; s += 10) {
+                starts.push_back(s);
+                lengths.push_back(3);
+            }
+        } else {
+            add(0.1, 0.3);
+            add(0.4, 0.4); // empty block.
+            add(0.5, 0.8);
+        }
+    }
+
+    static void assemble(SimulationParameters sim_params) {
+        if (ref && last_params == sim_params) {
+            return;
+        }
+        last_params = sim_params;
+
+        assemble();
+
+        auto bind_rows = std::get<0>(sim_params);
+        auto full = (bind_rows ? NR : NC);
+        std::vector<int> starts, lengths;
+        choose_blocks(std::get<1>(sim_params), full, starts, lengths);
+
+        std::vector<int> mapping;
+        for (std::size_t b = 0; b < starts.size(); ++b) {
+            for (int j = 0; j < lengths[b]; ++j) {
+                mapping.push_back(starts[b] + j);
+            }
+        }
+        int length = mapping.size();
+
+        if (bind_rows) {
+            std::vector<double> sub;
+            for (auto m : mapping) {
+                auto row = simulated.data() + m * NC;
+                sub.insert(sub.end(), row, row + NC);
+            }
+            ref.reset(new tatami::DenseRowMatrix<double, int>(length, NC, std::move(sub)));
+        } else {
+            std::vector<double> sub;
+            sub.reserve(NR * length);
+            for (int r = 0; r < NR; ++r) {
+                auto row = simulated.data() + r * NC;
+                for (auto m : mapping) {
+                    sub.push_back(row[m]);
+                }
+            }
+            ref.reset(new tatami::DenseRowMatrix<double, int>(NR, length, std::move(sub)));
+        }
+
+        dense_multiblock.reset(new tatami::DelayedSubsetMultiBlock<double, int>(dense, starts, lengths, bind_rows));
+        sparse_multiblock.reset(new tatami::DelayedSubsetMultiBlock<double, int>(sparse, starts, lengths, bind_rows));
+        uns_sparse_multiblock.reset(new tatami::DelayedSubsetMultiBlock<double, int>(std::make_shared<const tatami_test::ReversedIndicesWrapper<double, int> >(sparse), starts, lengths, bind_rows));
+    }
+};
+
+/*****************************
+ *****************************/
+
+class SubsetMultiBlockTest : 
+    public ::testing::TestWithParam<typename SubsetMultiBlockUtils::SimulationParameters>, 
+    public SubsetMultiBlockUtils {
+protected:
+    void SetUp() {
+        assemble(GetParam());
+    }
+};
+
+TEST_P(SubsetMultiBlockTest, Basic) {
+    EXPECT_EQ(ref->nrow(), dense_multiblock->nrow());
+    EXPECT_EQ(ref->ncol(), dense_multiblock->ncol());
+
+    EXPECT_FALSE(dense_multiblock->is_sparse());
+    EXPECT_EQ(dense_multiblock->is_sparse_proportion(), 0);
+    EXPECT_TRUE(sparse_multiblock->is_sparse());
+    EXPECT_EQ(sparse_multiblock->is_sparse_proportion(), 1);
+
+    EXPECT_TRUE(dense_multiblock->prefer_rows());
+    EXPECT_EQ(dense_multiblock->prefer_rows_proportion(), 1);
+    EXPECT_FALSE(sparse_multiblock->prefer_rows());
+    EXPECT_EQ(sparse_multiblock->prefer_rows_proportion(), 0);
+
+    EXPECT_FALSE(dense_multiblock->uses_oracle(false));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DelayedSubsetMultiBlock,
+    SubsetMultiBlockTest,
+    SubsetMultiBlockUtils::simulation_parameter_combinations()
+);
+
+/*****************************
+ *****************************/
+
+class SubsetMultiBlockFullAccessTest : 
+    public ::testing::TestWithParam<std::tuple<SubsetMultiBlockUtils::SimulationParameters, tatami_test::StandardTestAccessOptions> >, 
+    public SubsetMultiBlockUtils {
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(SubsetMultiBlockFullAccessTest, Basic) {
+    auto tparam = GetParam();
+    auto options = tatami_test::convert_test_access_options(std::get<1>(tparam));
+    tatami_test::test_full_access(*dense_multiblock, *ref, options);
+    tatami_test::test_full_access(*sparse_multiblock, *ref, options);
+    tatami_test::test_unsorted_full_access(*uns_sparse_multiblock, options);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DelayedSubsetMultiBlock,
+    SubsetMultiBlockFullAccessTest,
+    ::testing::Combine(
+        SubsetMultiBlockUtils::simulation_parameter_combinations(),
+        tatami_test::standard_test_access_options_combinations()
+    )
+);
+
+/*****************************
+ *****************************/
+
+class SubsetMultiBlockBlockAccessTest : 
+    public ::testing::TestWithParam<std::tuple<SubsetMultiBlockUtils::SimulationParameters, tatami_test::StandardTestAccessOptions, std::pair<double, double> > >,
+    public SubsetMultiBlockUtils {
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(SubsetMultiBlockBlockAccessTest, Block) {
+    auto tparam = GetParam();
+    auto options = tatami_test::convert_test_access_options(std::get<1>(tparam));
+    auto interval_info = std::get<2>(tparam);
+    tatami_test::test_block_access(*dense_multiblock, *ref, interval_info.first, interval_info.second, options);
+    tatami_test::test_block_access(*sparse_multiblock, *ref, interval_info.first, interval_info.second, options);
+    tatami_test::test_unsorted_block_access(*uns_sparse_multiblock, interval_info.first, interval_info.second, options);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DelayedSubsetMultiBlock,
+    SubsetMultiBlockBlockAccessTest,
+    ::testing::Combine(
+        SubsetMultiBlockUtils::simulation_parameter_combinations(),
+        tatami_test::standard_test_access_options_combinations(),
+        ::testing::Values(
+            std::make_pair(0.0, 0.45), 
+            std::make_pair(0.33, 0.37),
+            std::make_pair(0.56, 0.44)
+        )
+    )
+);
+
+/*****************************
+ *****************************/
+
+class SubsetMultiBlockIndexedAccessTest : 
+    public ::testing::TestWithParam<std::tuple<SubsetMultiBlockUtils::SimulationParameters, tatami_test::StandardTestAccessOptions, std::pair<double, double> > >, 
+    public SubsetMultiBlockUtils {
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(SubsetMultiBlockIndexedAccessTest, Indexed) {
+    auto tparam = GetParam();
+    auto options = tatami_test::convert_test_access_options(std::get<1>(tparam));
+    auto interval_info = std::get<2>(tparam);
+    tatami_test::test_indexed_access(*dense_multiblock, *ref, interval_info.first, interval_info.second, options);
+    tatami_test::test_indexed_access(*sparse_multiblock, *ref, interval_info.first, interval_info.second, options);
+    tatami_test::test_unsorted_indexed_access(*uns_sparse_multiblock, interval_info.first, interval_info.second, options);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DelayedSubsetMultiBlock,
+    SubsetMultiBlockIndexedAccessTest,
+    ::testing::Combine(
+        SubsetMultiBlockUtils::simulation_parameter_combinations(),
+        tatami_test::standard_test_access_options_combinations(),
+        ::testing::Values(
+            std::make_pair(0.0, 0.15), 
+            std::make_pair(0.33, 0.2),
+            std::make_pair(0.56, 0.3)
+        )
+    )
+);
+
+/****************************************************
+ ****************************************************/
+
+TEST(DelayedSubsetMultiBlock, Errors) {
+    auto dense = std::shared_ptr<const tatami::NumericMatrix>(new tatami::DenseRowMatrix<double, int>(10, 20, std::vector<double>(200)));
+
+    tatami_test::throws_error([&]() -> void {
+        tatami::DelayedSubsetMultiBlock<double, int>(dense, std::vector<int>{ 0, 5 }, std::vector<int>{ 2 }, true);
+    }, "same length");
+
+    tatami_test::throws_error([&]() -> void {
+        tatami::DelayedSubsetMultiBlock<double, int>(dense, std::vector<int>{ 0, 1 }, std::vector<int>{ 2, 2 }, true);
+    }, "non-overlapping");
+
+    tatami_test::throws_error([&]() -> void {
+        tatami::DelayedSubsetMultiBlock<double, int>(dense, std::vector<int>{ 0, 8 }, std::vector<int>{ 2, 5 }, true);
+    }, "within the matrix");
+
+    tatami::DelayedSubsetMultiBlock<double, int> ok(dense, std::vector<int>{ 0, 8 }, std::vector<int>{ 2, 2 }, true);
+    EXPECT_EQ(ok.nrow(), 4);
+    tatami::DelayedSubsetMultiBlock<double, int> empty(dense, std::vector<int>{}, std::vector<int>{}, false);
+    EXPECT_EQ(empty.ncol(), 0);
+}
+
+static void check_empty_parallel(const tatami::NumericMatrix& mat, const bool row, const int block_start) {
+    const int extent = (row ? mat.nrow() : mat.ncol());
+    std::shared_ptr<const tatami::Oracle<int> > oracle(new tatami::ConsecutiveOracle<int>(0, extent));
+    tatami::Options opt;
+    std::vector<double> vbuffer(1);
+    std::vector<int> ibuffer(1);
+
+    {
+        auto dext = mat.dense(row, block_start, 0, opt);
+        dext->fetch(0, vbuffer.data());
+        auto sext = mat.sparse(row, block_start, 0, opt);
+        EXPECT_EQ(sext->fetch(0, vbuffer.data(), ibuffer.data()).number, 0);
+    }
+
+    {
+        auto dext = mat.dense(row, oracle, block_start, 0, opt);
+        dext->fetch(vbuffer.data());
+        auto sext = mat.sparse(row, oracle, block_start, 0, opt);
+        EXPECT_EQ(sext->fetch(vbuffer.data(), ibuffer.data()).number, 0);
+    }
+
+    auto empty_indices = std::make_shared<const std::vector<int> >();
+    {
+        auto dext = mat.dense(row, empty_indices, opt);
+        dext->fetch(0, vbuffer.data());
+        auto sext = mat.sparse(row, empty_indices, opt);
+        EXPECT_EQ(sext->fetch(0, vbuffer.data(), ibuffer.data()).number, 0);
+    }
+
+    {
+        auto dext = mat.dense(row, oracle, empty_indices, opt);
+        dext->fetch(vbuffer.data());
+        auto sext = mat.sparse(row, oracle, empty_indices, opt);
+        EXPECT_EQ(sext->fetch(vbuffer.data(), ibuffer.data()).number, 0);
+    }
+}
+
+TEST(DelayedSubsetMultiBlock, EmptyParallel) {
+    auto dense = std::shared_ptr<const tatami::NumericMatrix>(new tatami::DenseRowMatrix<double, int>(10, 20, std::vector<double>(200, 1)));
+    auto sparse = tatami::convert_to_compressed_sparse<double, int>(*dense, false, {});
+
+    for (const auto& mat : { dense, std::shared_ptr<const tatami::NumericMatrix>(sparse) }) {
+        // Empty blocks at the start, middle and end of a non-empty subset, including a zero-length block at the end of the matrix.
+        tatami::DelayedSubsetMultiBlock<double, int> sub(mat, std::vector<int>{ 1, 6, 10 }, std::vector<int>{ 3, 2, 0 }, true);
+        EXPECT_EQ(sub.nrow(), 5);
+        for (int block_start : { 0, 3, 5 }) {
+            check_empty_parallel(sub, false, block_start);
+        }
+
+        tatami::DelayedSubsetMultiBlock<double, int> empty(mat, std::vector<int>{}, std::vector<int>{}, true);
+        EXPECT_EQ(empty.nrow(), 0);
+        check_empty_parallel(empty, false, 0);
+
+        auto full = empty.dense_column();
+        std::vector<double> buffer(1);
+        full->fetch(0, buffer.data());
+        auto sfull = empty.sparse_column();
+        std::vector<int> ibuffer(1);
+        EXPECT_EQ(sfull->fetch(0, buffer.data(), ibuffer.data()).number, 0);
+    }
+}
+
+TEST(DelayedSubsetMultiBlock, CorrectMaker) {
+    int NR = 90, NC = 50;
+    auto vec = tatami_test::simulate_vector<double>(NR * NC, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.seed = 981723;
+        return opt;
+    }());
+
+    auto dense = std::shared_ptr<const tatami::NumericMatrix>(new tatami::DenseRowMatrix<double, int>(NR, NC, std::move(vec)));
+
+    std::vector<int> indices { 2, 3, 4, 5, 10, 11, 12, 30, 31 };
+    auto sub = tatami::make_DelayedSubset(dense, indices, true);
+    EXPECT_NE((dynamic_cast<const tatami::DelayedSubsetMultiBlock<double, int>*>(sub.get())), nullptr);
+    auto ref = std::make_shared<tatami::DelayedSubsetSortedUnique<double, int, std::vector<int> > >(dense, indices, true);
+    tatami_test::test_simple_row_access(*sub, *ref);
+    tatami_test::test_simple_column_access(*sub, *ref);
+
+    // Too many blocks are not dispatched to the multi-block class.
+    tatami::MakeDelayedSubsetOptions mopt;
+    mopt.maximum_blocks = 2;
+    auto sub2 = tatami::make_DelayedSubset(dense, indices, true, mopt);
+    EXPECT_EQ((dynamic_cast<const tatami::DelayedSubsetMultiBlock<double, int>*>(sub2.get())), nullptr);
+
+    // Nor are blocks that are too small on average.
+    std::vector<int> scattered { 2, 3, 10, 20, 30 };
+    auto sub3 = tatami::make_DelayedSubset(dense, scattered, true);
+    EXPECT_EQ((dynamic_cast<const tatami::DelayedSubsetMultiBlock<double, int>*>(sub3.get())), nullptr);
+}
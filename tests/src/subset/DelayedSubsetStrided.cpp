@@ -0,0 +1,333 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory>
+
+#include "tatami/dense/DenseMatrix.hpp"
+#include "tatami/subset/DelayedSubsetStrided.hpp"
+#include "tatami/subset/make_DelayedSubset.hpp"
+#include "tatami/sparse/convert_to_compressed_sparse.hpp"
+#include "tatami/utils/ConsecutiveOracle.hpp"
+
+#include "tatami_test/tatami_test.hpp"
+
+class SubsetStridedUtils {
+protected:
+    inline static int NR = 153, NC = 121;
+    inline static std::vector<double> simulated;
+    inline static std::shared_ptr<tatami::NumericMatrix> dense, sparse;
+
+    static void assemble() {
+        if (dense) {
+            return;
+        }
+
+        simulated = tatami_test::simulate_vector<double>(NR * NC, []{
+            tatami_test::SimulateVectorOptions opt;
+            opt.density = 0.2;
+            opt.seed = 81723;
+            return opt;
+        }());
+
+        dense = std::shared_ptr<tatami::NumericMatrix>(new tatami::DenseRowMatrix<double, int>(NR, NC, simulated));
+        sparse = tatami::convert_to_compressed_sparse<false, double, int>(dense.get()); // column-major.
+    }
+
+public:
+    typedef std::tuple<bool, int, int> SimulationParameters;
+
+    static auto simulation_parameter_combinations() {
+        return ::testing::Combine(
+            ::testing::Values(true, false), // row or column subsetting, respectively.
+            ::testing::Values(0, 7), // start of the strided sequence.
+            ::testing::Values(1, 2, 5) // stride.
+        );
+    }
+
+protected:
+    inline static std::shared_ptr<tatami::NumericMatrix> dense_strided, sparse_strided, uns_sparse_strided, ref;
+    inline static SimulationParameters last_params;
+
+    static void assemble(SimulationParameters sim_params) {
+        if (ref && last_params == sim_params) {
+            return;
+        }
+        last_params = sim_params;
+
+        assemble();
+
+        auto bind_rows = std::get<0>(sim_params);
+        auto start = std::get<1>(sim_params);
+        auto stride = std::get<2>(sim_params);
+
+        auto full = (bind_rows ? NR : NC);
+        int length = (full - start + stride - 1) / stride;
+
+        if (bind_rows) {
+            std::vector<double> sub;
+            for (int s = 0; s < length; ++s) {
+                auto row = simulated.data() + (start + s * stride) * NC;
+                sub.insert(sub.end(), row, row + NC);
+            }
+            ref.reset(new tatami::DenseRowMatrix<double, int>(length, NC, std::move(sub)));
+        } else {
+            std::vector<double> sub;
+            sub.reserve(NR * length);
+            for (int r = 0; r < NR; ++r) {
+                auto row = simulated.data() + r * NC;
+                for (int s = 0; s < length; ++s) {
+                    sub.push_back(row[start + s * stride]);
+                }
+            }
+            ref.reset(new tatami::DenseRowMatrix<double, int>(NR, length, std::move(sub)));
+        }
+
+        dense_strided.reset(new tatami::DelayedSubsetStrided<double, int>(dense, start, stride, length, bind_rows));
+        sparse_strided.reset(new tatami::DelayedSubsetStrided<double, int>(sparse, start, stride, length, bind_rows));
+        uns_sparse_strided.reset(new tatami::DelayedSubsetStrided<double, int>(std::make_shared<const tatami_test::ReversedIndicesWrapper<double, int> >(sparse), start, stride, length, bind_rows));
+    }
+};
+
+/*****************************
+ *****************************/
+
+class SubsetStridedTest : 
+    public ::testing::TestWithParam<typename SubsetStridedUtils::SimulationParameters>, 
+    public SubsetStridedUtils {
+protected:
+    void SetUp() {
+        assemble(GetParam());
+    }
+};
+
+TEST_P(SubsetStridedTest, Basic) {
+    EXPECT_EQ(ref->nrow(), dense_strided->nrow());
+    EXPECT_EQ(ref->ncol(), dense_strided->ncol());
+
+    EXPECT_FALSE(dense_strided->is_sparse());
+    EXPECT_EQ(dense_strided->is_sparse_proportion(), 0);
+    EXPECT_TRUE(sparse_strided->is_sparse());
+    EXPECT_EQ(sparse_strided->is_sparse_proportion(), 1);
+
+    EXPECT_TRUE(dense_strided->prefer_rows());
+    EXPECT_EQ(dense_strided->prefer_rows_proportion(), 1);
+    EXPECT_FALSE(sparse_strided->prefer_rows());
+    EXPECT_EQ(sparse_strided->prefer_rows_proportion(), 0);
+
+    EXPECT_FALSE(dense_strided->uses_oracle(false));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DelayedSubsetStrided,
+    SubsetStridedTest,
+    SubsetStridedUtils::simulation_parameter_combinations()
+);
+
+/*****************************
+ *****************************/
+
+class SubsetStridedFullAccessTest : 
+    public ::testing::TestWithParam<std::tuple<SubsetStridedUtils::SimulationParameters, tatami_test::StandardTestAccessOptions> >, 
+    public SubsetStridedUtils {
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(SubsetStridedFullAccessTest, Basic) {
+    auto tparam = GetParam();
+    auto options = tatami_test::convert_test_access_options(std::get<1>(tparam));
+    tatami_test::test_full_access(*dense_strided, *ref, options);
+    tatami_test::test_full_access(*sparse_strided, *ref, options);
+    tatami_test::test_unsorted_full_access(*uns_sparse_strided, options);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DelayedSubsetStrided,
+    SubsetStridedFullAccessTest,
+    ::testing::Combine(
+        SubsetStridedUtils::simulation_parameter_combinations(),
+        tatami_test::standard_test_access_options_combinations()
+    )
+);
+
+/*****************************
+ *****************************/
+
+class SubsetStridedBlockAccessTest : 
+    public ::testing::TestWithParam<std::tuple<SubsetStridedUtils::SimulationParameters, tatami_test::StandardTestAccessOptions, std::pair<double, double> > >,
+    public SubsetStridedUtils {
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(SubsetStridedBlockAccessTest, Block) {
+    auto tparam = GetParam();
+    auto options = tatami_test::convert_test_access_options(std::get<1>(tparam));
+    auto interval_info = std::get<2>(tparam);
+    tatami_test::test_block_access(*dense_strided, *ref, interval_info.first, interval_info.second, options);
+    tatami_test::test_block_access(*sparse_strided, *ref, interval_info.first, interval_info.second, options);
+    tatami_test::test_unsorted_block_access(*uns_sparse_strided, interval_info.first, interval_info.second, options);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DelayedSubsetStrided,
+    SubsetStridedBlockAccessTest,
+    ::testing::Combine(
+        SubsetStridedUtils::simulation_parameter_combinations(),
+        tatami_test::standard_test_access_options_combinations(),
+        ::testing::Values(
+            std::make_pair(0.0, 0.45), 
+            std::make_pair(0.33, 0.37),
+            std::make_pair(0.56, 0.44)
+        )
+    )
+);
+
+/*****************************
+ *****************************/
+
+class SubsetStridedIndexedAccessTest : 
+    public ::testing::TestWithParam<std::tuple<SubsetStridedUtils::SimulationParameters, tatami_test::StandardTestAccessOptions, std::pair<double, double> > >, 
+    public SubsetStridedUtils {
+protected:
+    void SetUp() {
+        assemble(std::get<0>(GetParam()));
+    }
+};
+
+TEST_P(SubsetStridedIndexedAccessTest, Indexed) {
+    auto tparam = GetParam();
+    auto options = tatami_test::convert_test_access_options(std::get<1>(tparam));
+    auto interval_info = std::get<2>(tparam);
+    tatami_test::test_indexed_access(*dense_strided, *ref, interval_info.first, interval_info.second, options);
+    tatami_test::test_indexed_access(*sparse_strided, *ref, interval_info.first, interval_info.second, options);
+    tatami_test::test_unsorted_indexed_access(*uns_sparse_strided, interval_info.first, interval_info.second, options);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DelayedSubsetStrided,
+    SubsetStridedIndexedAccessTest,
+    ::testing::Combine(
+        SubsetStridedUtils::simulation_parameter_combinations(),
+        tatami_test::standard_test_access_options_combinations(),
+        ::testing::Values(
+            std::make_pair(0.0, 0.15), 
+            std::make_pair(0.33, 0.2),
+            std::make_pair(0.56, 0.3)
+        )
+    )
+);
+
+/****************************************************
+ ****************************************************/
+
+TEST(DelayedSubsetStrided, Errors) {
+    auto dense = std::shared_ptr<const tatami::NumericMatrix>(new tatami::DenseRowMatrix<double, int>(10, 20, std::vector<double>(200)));
+
+    tatami_test::throws_error([&]() -> void {
+        tatami::DelayedSubsetStrided<double, int>(dense, 0, 0, 5, true);
+    }, "positive");
+
+    tatami_test::throws_error([&]() -> void {
+        tatami::DelayedSubsetStrided<double, int>(dense, -1, 2, 5, true);
+    }, "non-negative");
+
+    tatami_test::throws_error([&]() -> void {
+        tatami::DelayedSubsetStrided<double, int>(dense, 1, 2, 6, true);
+    }, "within the matrix");
+
+    tatami::DelayedSubsetStrided<double, int> ok(dense, 1, 2, 5, true);
+    EXPECT_EQ(ok.nrow(), 5);
+    tatami::DelayedSubsetStrided<double, int> empty(dense, 0, 3, 0, false);
+    EXPECT_EQ(empty.ncol(), 0);
+}
+
+static void check_empty_parallel(const tatami::NumericMatrix& mat, const bool row, const int block_start) {
+    const int extent = (row ? mat.nrow() : mat.ncol());
+    std::shared_ptr<const tatami::Oracle<int> > oracle(new tatami::ConsecutiveOracle<int>(0, extent));
+    tatami::Options opt;
+    std::vector<double> vbuffer(1);
+    std::vector<int> ibuffer(1);
+
+    {
+        auto dext = mat.dense(row, block_start, 0, opt);
+        dext->fetch(0, vbuffer.data());
+        auto sext = mat.sparse(row, block_start, 0, opt);
+        EXPECT_EQ(sext->fetch(0, vbuffer.data(), ibuffer.data()).number, 0);
+    }
+
+    {
+        auto dext = mat.dense(row, oracle, block_start, 0, opt);
+        dext->fetch(vbuffer.data());
+        auto sext = mat.sparse(row, oracle, block_start, 0, opt);
+        EXPECT_EQ(sext->fetch(vbuffer.data(), ibuffer.data()).number, 0);
+    }
+
+    auto empty_indices = std::make_shared<const std::vector<int> >();
+    {
+        auto dext = mat.dense(row, empty_indices, opt);
+        dext->fetch(0, vbuffer.data());
+        auto sext = mat.sparse(row, empty_indices, opt);
+        EXPECT_EQ(sext->fetch(0, vbuffer.data(), ibuffer.data()).number, 0);
+    }
+
+    {
+        auto dext = mat.dense(row, oracle, empty_indices, opt);
+        dext->fetch(vbuffer.data());
+        auto sext = mat.sparse(row, oracle, empty_indices, opt);
+        EXPECT_EQ(sext->fetch(vbuffer.data(), ibuffer.data()).number, 0);
+    }
+}
+
+TEST(DelayedSubsetStrided, EmptyParallel) {
+    auto dense = std::shared_ptr<const tatami::NumericMatrix>(new tatami::DenseRowMatrix<double, int>(10, 20, std::vector<double>(200, 1)));
+    auto sparse = tatami::convert_to_compressed_sparse<double, int>(*dense, false, {});
+
+    for (const auto& mat : { dense, std::shared_ptr<const tatami::NumericMatrix>(sparse) }) {
+        // Empty blocks at the start, middle and end of a non-empty subset.
+        tatami::DelayedSubsetStrided<double, int> sub(mat, 1, 2, 5, true);
+        for (int block_start : { 0, 2, 5 }) {
+            check_empty_parallel(sub, false, block_start);
+        }
+
+        // Empty subsets don't need a valid start.
+        tatami::DelayedSubsetStrided<double, int> empty(mat, 15, 3, 0, true);
+        EXPECT_EQ(empty.nrow(), 0);
+        check_empty_parallel(empty, false, 0);
+
+        auto full = empty.dense_column();
+        std::vector<double> buffer(1);
+        full->fetch(0, buffer.data());
+        auto sfull = empty.sparse_column();
+        std::vector<int> ibuffer(1);
+        EXPECT_EQ(sfull->fetch(0, buffer.data(), ibuffer.data()).number, 0);
+    }
+}
+
+TEST(DelayedSubsetStrided, CorrectMaker) {
+    int NR = 90, NC = 50;
+    auto vec = tatami_test::simulate_vector<double>(NR * NC, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.seed = 1238127;
+        return opt;
+    }());
+
+    auto dense = std::shared_ptr<const tatami::NumericMatrix>(new tatami::DenseRowMatrix<double, int>(NR, NC, std::move(vec)));
+
+    std::vector<int> indices { 5, 8, 11, 14, 17 };
+    auto sub = tatami::make_DelayedSubset(dense, indices, false);
+    EXPECT_NE((dynamic_cast<const tatami::DelayedSubsetStrided<double, int>*>(sub.get())), nullptr);
+    auto ref = std::make_shared<tatami::DelayedSubsetSortedUnique<double, int, std::vector<int> > >(dense, indices, false);
+    tatami_test::test_simple_row_access(*sub, *ref);
+    tatami_test::test_simple_column_access(*sub, *ref);
+
+    // Strides that are too large are not dispatched to the strided class.
+    tatami::MakeDelayedSubsetOptions mopt;
+    mopt.maximum_stride = 2;
+    auto sub2 = tatami::make_DelayedSubset(dense, indices, false, mopt);
+    EXPECT_EQ((dynamic_cast<const tatami::DelayedSubsetStrided<double, int>*>(sub2.get())), nullptr);
+}
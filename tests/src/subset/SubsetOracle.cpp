@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+#include "tatami/subset/utils.hpp"
+#include "tatami/subset/DelayedSubsetBlock.hpp"
+#include "tatami/subset/DelayedSubsetStrided.hpp"
+#include "tatami/utils/ConsecutiveOracle.hpp"
+#include "tatami/utils/FixedOracle.hpp"
+
+#include <vector>
+#include <memory>
+
+// Oracle with a strided sequence of predictions, to check that the stride is propagated.
+class StridedTestOracle final : public tatami::Oracle<int> {
+public:
+    StridedTestOracle(int start, int step, int number) : my_start(start), my_step(step), my_number(number) {}
+
+    tatami::PredictionIndex total() const {
+        return my_number;
+    }
+
+    int get(tatami::PredictionIndex i) const {
+        return my_start + my_step * static_cast<int>(i);
+    }
+
+    bool is_strided() const {
+        return true;
+    }
+
+    int stride() const {
+        return my_step;
+    }
+
+private:
+    int my_start, my_step, my_number;
+};
+
+static void check_predictions(const tatami::Oracle<int>& oracle) {
+    const auto total = oracle.total();
+    const auto first = oracle.get(0);
+    for (tatami::PredictionIndex i = 1; i < total; ++i) {
+        const auto current = oracle.get(i);
+        if (oracle.is_increasing()) {
+            EXPECT_LE(oracle.get(i - 1), current);
+        }
+        if (oracle.is_strided()) {
+            EXPECT_EQ(current, first + static_cast<int>(i) * oracle.stride());
+        }
+    }
+    EXPECT_EQ(oracle.is_consecutive(), oracle.is_strided() && oracle.stride() == 1);
+}
+
+TEST(SubsetOracle, Arbitrary) {
+    std::vector<int> subset { 5, 1, 7, 3, 3, 9, 0 };
+    tatami::subset_utils::SubsetOracle<int, std::vector<int> > oracle(
+        std::make_shared<tatami::ConsecutiveOracle<int> >(1, 5),
+        subset,
+        tatami::subset_utils::SubsetStructure<int>()
+    );
+    EXPECT_EQ(oracle.total(), 5);
+    EXPECT_EQ(oracle.get(0), 1);
+    EXPECT_EQ(oracle.get(4), 9);
+    EXPECT_FALSE(oracle.is_consecutive());
+    EXPECT_FALSE(oracle.is_strided());
+    EXPECT_FALSE(oracle.is_increasing());
+}
+
+TEST(SubsetOracle, Sorted) {
+    std::vector<int> subset { 0, 2, 2, 3, 5, 6, 7, 8, 10 };
+    tatami::subset_utils::SubsetStructure<int> structure{ true, false, 0 };
+
+    {
+        tatami::subset_utils::SubsetOracle<int, std::vector<int> > oracle(std::make_shared<tatami::ConsecutiveOracle<int> >(0, 9), subset, structure);
+        EXPECT_TRUE(oracle.is_increasing());
+        EXPECT_FALSE(oracle.is_strided());
+        check_predictions(oracle);
+    }
+
+    // Increasing-ness is lost if the original predictions are not increasing.
+    {
+        std::vector<int> predictions { 3, 1, 4 };
+        tatami::subset_utils::SubsetOracle<int, std::vector<int> > oracle(std::make_shared<tatami::FixedVectorOracle<int> >(predictions), subset, structure);
+        EXPECT_FALSE(oracle.is_increasing());
+        EXPECT_FALSE(oracle.is_strided());
+    }
+}
+
+TEST(SubsetOracle, SortedUnique) {
+    std::vector<int> subset { 0, 2, 3, 4, 5, 6, 10, 12, 14, 16 };
+    tatami::subset_utils::SubsetStructure<int> structure{ true, true, 0 };
+
+    // Consecutive predictions over a consecutive stretch of the subset.
+    {
+        tatami::subset_utils::SubsetOracle<int, std::vector<int> > oracle(std::make_shared<tatami::ConsecutiveOracle<int> >(1, 5), subset, structure);
+        EXPECT_TRUE(oracle.is_consecutive());
+        EXPECT_TRUE(oracle.is_increasing());
+        check_predictions(oracle);
+    }
+
+    // Strided predictions over a consecutive stretch.
+    {
+        tatami::subset_utils::SubsetOracle<int, std::vector<int> > oracle(std::make_shared<StridedTestOracle>(1, 2, 3), subset, structure);
+        EXPECT_FALSE(oracle.is_consecutive());
+        EXPECT_TRUE(oracle.is_strided());
+        EXPECT_EQ(oracle.stride(), 2);
+        check_predictions(oracle);
+    }
+
+    // Consecutive predictions that span a gap in the subset.
+    {
+        tatami::subset_utils::SubsetOracle<int, std::vector<int> > oracle(std::make_shared<tatami::ConsecutiveOracle<int> >(0, 8), subset, structure);
+        EXPECT_FALSE(oracle.is_strided());
+        EXPECT_TRUE(oracle.is_increasing());
+        check_predictions(oracle);
+    }
+
+    // Trivial cases with no more than one prediction.
+    {
+        std::vector<int> predictions { 8 };
+        tatami::subset_utils::SubsetOracle<int, std::vector<int> > oracle(std::make_shared<tatami::FixedVectorOracle<int> >(predictions), subset, structure);
+        EXPECT_TRUE(oracle.is_consecutive());
+        EXPECT_TRUE(oracle.is_increasing());
+    }
+}
+
+TEST(SubsetOracle, Strided) {
+    tatami::DelayedSubsetStrided_internal::StridedSubset<int> subset(3, 4, 10);
+    tatami::subset_utils::SubsetStructure<int> structure{ true, true, subset.stride };
+
+    {
+        tatami::subset_utils::SubsetOracle<int, decltype(subset)> oracle(std::make_shared<tatami::ConsecutiveOracle<int> >(2, 6), subset, structure);
+        EXPECT_FALSE(oracle.is_consecutive());
+        EXPECT_TRUE(oracle.is_strided());
+        EXPECT_EQ(oracle.stride(), 4);
+        EXPECT_TRUE(oracle.is_increasing());
+        check_predictions(oracle);
+    }
+
+    {
+        tatami::subset_utils::SubsetOracle<int, decltype(subset)> oracle(std::make_shared<StridedTestOracle>(0, 3, 4), subset, structure);
+        EXPECT_TRUE(oracle.is_strided());
+        EXPECT_EQ(oracle.stride(), 12);
+        check_predictions(oracle);
+    }
+
+    // A stride of 1 is reported as consecutive.
+    {
+        tatami::DelayedSubsetStrided_internal::StridedSubset<int> unit(3, 1, 10);
+        tatami::subset_utils::SubsetOracle<int, decltype(unit)> oracle(
+            std::make_shared<tatami::ConsecutiveOracle<int> >(2, 6),
+            unit,
+            tatami::subset_utils::SubsetStructure<int>{ true, true, unit.stride }
+        );
+        EXPECT_TRUE(oracle.is_consecutive());
+        check_predictions(oracle);
+    }
+}
+
+TEST(SubsetOracle, Block) {
+    tatami::DelayedSubsetBlock_internal::SubsetOracle<int> oracle(std::make_shared<StridedTestOracle>(1, 3, 5), 10);
+    EXPECT_FALSE(oracle.is_consecutive());
+    EXPECT_TRUE(oracle.is_strided());
+    EXPECT_EQ(oracle.stride(), 3);
+    EXPECT_TRUE(oracle.is_increasing());
+    EXPECT_EQ(oracle.get(0), 11);
+    check_predictions(oracle);
+}
+
+TEST(SubsetOracle, ComputeStructure) {
+    {
+        std::vector<int> subset { 5, 1, 7, 3, 3, 9, 0 };
+        auto structure = tatami::subset_utils::compute_subset_structure(subset, 10);
+        EXPECT_FALSE(structure.increasing);
+        EXPECT_FALSE(structure.unique);
+        EXPECT_EQ(structure.stride, 0);
+    }
+
+    {
+        std::vector<int> subset { 5, 1, 7, 3, 9, 0 };
+        auto structure = tatami::subset_utils::compute_subset_structure(subset, 10);
+        EXPECT_FALSE(structure.increasing);
+        EXPECT_TRUE(structure.unique);
+        EXPECT_EQ(structure.stride, 0);
+    }
+
+    {
+        std::vector<int> subset { 0, 1, 1, 3, 5, 9 };
+        auto structure = tatami::subset_utils::compute_subset_structure(subset, 10);
+        EXPECT_TRUE(structure.increasing);
+        EXPECT_FALSE(structure.unique);
+        EXPECT_EQ(structure.stride, 0);
+    }
+
+    {
+        std::vector<int> subset { 0, 1, 3, 5, 9 };
+        auto structure = tatami::subset_utils::compute_subset_structure(subset, 10);
+        EXPECT_TRUE(structure.increasing);
+        EXPECT_TRUE(structure.unique);
+        EXPECT_EQ(structure.stride, 0);
+    }
+
+    {
+        std::vector<int> subset { 1, 4, 7, 10 };
+        auto structure = tatami::subset_utils::compute_subset_structure(subset, 12);
+        EXPECT_TRUE(structure.increasing);
+        EXPECT_TRUE(structure.unique);
+        EXPECT_EQ(structure.stride, 3);
+    }
+
+    // Stride is not reported for fewer than two elements.
+    {
+        std::vector<int> subset { 4 };
+        auto structure = tatami::subset_utils::compute_subset_structure(subset, 12);
+        EXPECT_TRUE(structure.increasing);
+        EXPECT_TRUE(structure.unique);
+        EXPECT_EQ(structure.stride, 0);
+    }
+
+    {
+        std::vector<int> subset;
+        auto structure = tatami::subset_utils::compute_subset_structure(subset, 12);
+        EXPECT_TRUE(structure.increasing);
+        EXPECT_TRUE(structure.unique);
+        EXPECT_EQ(structure.stride, 0);
+    }
+}
@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory>
+#include <tuple>
+#include <cstdint>
+
+#include "tatami/dense/DenseMatrix.hpp"
+#include "tatami/dense/convert_to_dense.hpp"
+#include "tatami/sparse/convert_to_compressed_sparse.hpp"
+#include "tatami/subset/make_DelayedSubset.hpp"
+#include "tatami/subset/subset_materialize.hpp"
+#include "tatami/other/DelayedTranspose.hpp"
+#include "tatami/other/ConstantMatrix.hpp"
+
+#include "tatami_test/tatami_test.hpp"
+
+class SubsetMaterializeTest : public ::testing::TestWithParam<std::tuple<int, int, int, int, int> > {
+protected:
+    inline static int NR = 57, NC = 43;
+    inline static std::shared_ptr<const tatami::NumericMatrix> dense, dense_column, sparse_row, sparse_column;
+
+    static void SetUpTestSuite() {
+        auto simulated = tatami_test::simulate_vector<double>(NR * NC, []{
+            tatami_test::SimulateVectorOptions opt;
+            opt.density = 0.2;
+            opt.seed = 91872361;
+            return opt;
+        }());
+        dense.reset(new tatami::DenseRowMatrix<double, int>(NR, NC, std::move(simulated)));
+        dense_column = tatami::convert_to_dense<double, int>(*dense, false, {});
+        sparse_row = tatami::convert_to_compressed_sparse<double, int>(*dense, true, {});
+        sparse_column = tatami::convert_to_compressed_sparse<double, int>(*dense, false, {});
+    }
+
+    static std::shared_ptr<const tatami::NumericMatrix> choose_storage(int choice) {
+        switch (choice) {
+            case 0: return sparse_row;
+            case 1: return sparse_column;
+            case 2: return dense;
+            default: return dense_column;
+        }
+    }
+
+    // 'tchoice' specifies whether to transpose the matrix before (1) or after (2) subsetting, or not at all (0).
+    static std::shared_ptr<const tatami::NumericMatrix> transform(std::shared_ptr<const tatami::NumericMatrix> mat, int rchoice, int cchoice, int tchoice) {
+        if (tchoice == 1) {
+            mat.reset(new tatami::DelayedTranspose<double, int>(std::move(mat)));
+        }
+        mat = subset(std::move(mat), rchoice, cchoice);
+        if (tchoice == 2) {
+            mat.reset(new tatami::DelayedTranspose<double, int>(std::move(mat)));
+        }
+        return mat;
+    }
+
+    static std::shared_ptr<const tatami::NumericMatrix> subset(std::shared_ptr<const tatami::NumericMatrix> mat, int rchoice, int cchoice) {
+        auto spawn = [](int choice, int full) -> std::vector<int> {
+            std::vector<int> output;
+            if (choice == 1) { // sorted.
+                for (int i = 1; i < full; i += 3) {
+                    output.push_back(i);
+                }
+            } else if (choice == 2) { // unsorted with duplicates.
+                for (int i = full - 1; i >= 0; i -= 4) {
+                    output.push_back(i);
+                    output.push_back(i);
+                }
+            }
+            return output;
+        };
+
+        if (rchoice) {
+            const int full = mat->nrow();
+            mat = tatami::make_DelayedSubset(std::move(mat), spawn(rchoice, full), true);
+        }
+        if (cchoice) {
+            const int full = mat->ncol();
+            mat = tatami::make_DelayedSubset(std::move(mat), spawn(cchoice, full), false);
+        }
+        return mat;
+    }
+};
+
+TEST_P(SubsetMaterializeTest, Sparse) {
+    auto param = GetParam();
+    auto storage = choose_storage(std::get<0>(param));
+    auto rchoice = std::get<1>(param);
+    auto cchoice = std::get<2>(param);
+    auto tchoice = std::get<3>(param);
+    auto nthreads = std::get<4>(param);
+
+    auto ref = transform(dense, rchoice, cchoice, tchoice);
+    auto sub = transform(storage, rchoice, cchoice, tchoice);
+
+    for (int r = 0; r < 2; ++r) {
+        const bool row = (r == 0);
+        std::vector<double> values;
+        std::vector<int> indices;
+        std::vector<std::size_t> pointers;
+        EXPECT_EQ(tatami::subset_materialize(*sub, row, values, indices, pointers, nthreads), rchoice || cchoice || tchoice);
+
+        // Writing directly into differently-typed outputs gives the same results.
+        std::vector<float> fvalues;
+        std::vector<std::uint16_t> sindices;
+        std::vector<std::uint32_t> upointers;
+        EXPECT_EQ(tatami::subset_materialize(*sub, row, fvalues, sindices, upointers, nthreads), rchoice || cchoice || tchoice);
+        EXPECT_EQ(upointers, std::vector<std::uint32_t>(pointers.begin(), pointers.end()));
+        EXPECT_EQ(sindices, std::vector<std::uint16_t>(indices.begin(), indices.end()));
+        EXPECT_EQ(fvalues, std::vector<float>(values.begin(), values.end()));
+
+        tatami::ConvertToCompressedSparseOptions opt;
+        opt.num_threads = nthreads;
+        auto converted = tatami::convert_to_compressed_sparse<double, int>(*sub, row, opt);
+        EXPECT_EQ(converted->prefer_rows(), row);
+        tatami_test::test_simple_row_access(*converted, *ref);
+        tatami_test::test_simple_column_access(*converted, *ref);
+
+        // Different types in the output.
+        auto converted2 = tatami::convert_to_compressed_sparse<double, int, float, std::size_t, std::uint32_t>(*sub, row, opt);
+        auto converted_ref = tatami::convert_to_compressed_sparse<double, int, float, std::size_t, std::uint32_t>(*ref, row, opt);
+        tatami_test::test_simple_row_access(*converted2, *converted_ref);
+    }
+}
+
+TEST_P(SubsetMaterializeTest, Dense) {
+    auto param = GetParam();
+    auto storage = choose_storage(std::get<0>(param));
+    auto rchoice = std::get<1>(param);
+    auto cchoice = std::get<2>(param);
+    auto tchoice = std::get<3>(param);
+    auto nthreads = std::get<4>(param);
+
+    auto ref = transform(dense, rchoice, cchoice, tchoice);
+    auto sub = transform(storage, rchoice, cchoice, tchoice);
+
+    for (int r = 0; r < 2; ++r) {
+        const bool row_major = (r == 0);
+        tatami::ConvertToDenseOptions opt;
+        opt.num_threads = nthreads;
+        auto converted = tatami::convert_to_dense<double, int>(*sub, row_major, opt);
+        EXPECT_EQ(converted->prefer_rows(), row_major);
+        tatami_test::test_simple_row_access(*converted, *ref);
+        tatami_test::test_simple_column_access(*converted, *ref);
+
+        // Falls back to the usual extraction for a different output type.
+        auto converted2 = tatami::convert_to_dense<double, int, float>(*sub, row_major, opt);
+        auto converted_ref = tatami::convert_to_dense<double, int, float>(*ref, row_major, opt);
+        tatami_test::test_simple_row_access(*converted2, *converted_ref);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    subset_materialize,
+    SubsetMaterializeTest,
+    ::testing::Combine(
+        ::testing::Values(0, 1, 2, 3), // sparse row, sparse column, dense row or dense column storage
+        ::testing::Values(0, 1, 2), // row subset type
+        ::testing::Values(0, 1, 2), // column subset type
+        ::testing::Values(0, 1, 2), // transposition type
+        ::testing::Values(1, 3) // number of threads
+    )
+);
+
+TEST(SubsetMaterialize, Nested) {
+    auto simulated = tatami_test::simulate_vector<double>(30 * 20, []{
+        tatami_test::SimulateVectorOptions opt;
+        opt.density = 0.3;
+        opt.seed = 1239812;
+        return opt;
+    }());
+    auto dense = std::shared_ptr<const tatami::NumericMatrix>(new tatami::DenseColumnMatrix<double, int>(30, 20, std::move(simulated)));
+    auto sparse = tatami::convert_to_compressed_sparse<double, int>(*dense, true, {});
+
+    // Subsets on either side of a transposition, which cannot be collapsed by make_DelayedSubset().
+    auto wrap = [](std::shared_ptr<const tatami::NumericMatrix> mat) -> std::shared_ptr<const tatami::NumericMatrix> {
+        mat = tatami::make_DelayedSubset(std::move(mat), std::vector<int>{ 19, 2, 2, 5, 11, 0 }, false);
+        mat.reset(new tatami::DelayedTranspose<double, int>(std::move(mat)));
+        mat = tatami::make_DelayedSubset(std::move(mat), std::vector<int>{ 4, 0, 1, 1, 3 }, true);
+        return tatami::make_DelayedSubset(std::move(mat), std::vector<int>{ 1, 3, 5, 7, 9, 11, 13 }, false);
+    };
+    auto ref = wrap(dense);
+
+    for (const auto& storage : std::vector<std::shared_ptr<const tatami::NumericMatrix> >{ dense, sparse }) {
+        auto sub = wrap(storage);
+        for (int r = 0; r < 2; ++r) {
+            const bool row = (r == 0);
+            auto converted = tatami::convert_to_dense<double, int>(*sub, row, {});
+            tatami_test::test_simple_row_access(*converted, *ref);
+
+            std::vector<double> values;
+            std::vector<int> indices;
+            std::vector<std::size_t> pointers;
+            EXPECT_TRUE(tatami::subset_materialize(*sub, row, values, indices, pointers, 1));
+            auto sconverted = tatami::convert_to_compressed_sparse<double, int>(*sub, row, {});
+            tatami_test::test_simple_column_access(*sconverted, *ref);
+        }
+    }
+}
+
+TEST(SubsetMaterialize, Unsupported) {
+    auto constant = std::shared_ptr<const tatami::NumericMatrix>(new tatami::ConstantMatrix<double, int>(10, 20, 1));
+    auto sub = tatami::make_DelayedSubset(constant, std::vector<int>{ 1, 3, 5 }, true);
+    auto trans = std::shared_ptr<const tatami::NumericMatrix>(new tatami::DelayedTranspose<double, int>(constant));
+
+    // Concrete matrices are not materialized by themselves, as they are not delayed operations.
+    auto dense = std::shared_ptr<const tatami::NumericMatrix>(new tatami::DenseRowMatrix<double, int>(10, 20, std::vector<double>(200)));
+
+    for (const auto& mat : std::vector<std::shared_ptr<const tatami::NumericMatrix> >{ sub, trans, dense }) {
+        std::vector<double> values;
+        std::vector<int> indices;
+        std::vector<std::size_t> pointers;
+        EXPECT_FALSE(tatami::subset_materialize(*mat, true, values, indices, pointers, 1));
+        EXPECT_TRUE(pointers.empty());
+
+        std::vector<double> store(mat->nrow() * mat->ncol());
+        EXPECT_FALSE(tatami::subset_materialize(*mat, true, store.data(), 1));
+    }
+}
@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <chrono>
+
+#include "tatami/dense/DenseMatrix.hpp"
+#include "tatami/sparse/convert_to_compressed_sparse.hpp"
+#include "tatami/utils/AsyncPrefetchExtractor.hpp"
+#include "tatami/utils/ConsecutiveOracle.hpp"
+#include "tatami/utils/FixedOracle.hpp"
+
+#include "tatami_test/tatami_test.hpp"
+
+class AsyncPrefetchExtractorTest : public ::testing::TestWithParam<std::tuple<bool, int, int> > {
+protected:
+    inline static int nrow = 57, ncol = 43;
+    inline static std::shared_ptr<tatami::NumericMatrix> dense, sparse;
+
+    static void SetUpTestSuite() {
+        auto simulated = tatami_test::simulate_vector<double>(nrow * ncol, []{
+            tatami_test::SimulateVectorOptions opt;
+            opt.density = 0.2;
+            opt.seed = 817231;
+            return opt;
+        }());
+        dense.reset(new tatami::DenseMatrix<double, int, decltype(simulated)>(nrow, ncol, std::move(simulated), true));
+        sparse = tatami::convert_to_compressed_sparse<double, int>(*dense, true, {});
+    }
+
+    template<typename ... Args_>
+    static void compare(const tatami::NumericMatrix& mat, bool row, const tatami::AsyncPrefetchExtractorOptions& aopt, int extent, Args_... args) {
+        const int dim = (row ? mat.nrow() : mat.ncol());
+        std::vector<int> predictions;
+        for (int i = 0; i < dim; i += 2) {
+            predictions.push_back(i);
+        }
+        for (int i = 1; i < dim; i += 3) {
+            predictions.push_back(i);
+        }
+        auto oracle = std::make_shared<tatami::FixedVectorOracle<int> >(predictions);
+
+        auto ref = tatami::new_extractor<false, false>(mat, row, false, args...);
+        auto ext = tatami::new_async_prefetch_extractor<false>(mat, row, oracle, aopt, args...);
+        std::vector<double> rbuffer(extent), buffer(extent);
+        for (auto p : predictions) {
+            auto rptr = ref->fetch(p, rbuffer.data());
+            auto ptr = ext->fetch(buffer.data());
+            EXPECT_EQ(std::vector<double>(rptr, rptr + extent), std::vector<double>(ptr, ptr + extent));
+        }
+
+        auto sref = tatami::new_extractor<true, false>(mat, row, false, args...);
+        auto sext = tatami::new_async_prefetch_extractor<true>(mat, row, oracle, aopt, args...);
+        std::vector<double> rvbuffer(extent), vbuffer(extent);
+        std::vector<int> ribuffer(extent), ibuffer(extent);
+        for (auto p : predictions) {
+            auto rrange = sref->fetch(p, rvbuffer.data(), ribuffer.data());
+            auto range = sext->fetch(vbuffer.data(), ibuffer.data());
+            ASSERT_EQ(rrange.number, range.number);
+            EXPECT_EQ(std::vector<double>(rrange.value, rrange.value + rrange.number), std::vector<double>(range.value, range.value + range.number));
+            EXPECT_EQ(std::vector<int>(rrange.index, rrange.index + rrange.number), std::vector<int>(range.index, range.index + range.number));
+        }
+    }
+};
+
+TEST_P(AsyncPrefetchExtractorTest, Full) {
+    auto param = GetParam();
+    auto row = std::get<0>(param);
+    tatami::AsyncPrefetchExtractorOptions aopt;
+    aopt.num_buffers = std::get<1>(param);
+    aopt.batch_size = std::get<2>(param);
+
+    const int extent = (row ? ncol : nrow);
+    compare(*dense, row, aopt, extent);
+    compare(*sparse, row, aopt, extent);
+}
+
+TEST_P(AsyncPrefetchExtractorTest, Block) {
+    auto param = GetParam();
+    auto row = std::get<0>(param);
+    tatami::AsyncPrefetchExtractorOptions aopt;
+    aopt.num_buffers = std::get<1>(param);
+    aopt.batch_size = std::get<2>(param);
+
+    const int extent = (row ? ncol : nrow);
+    const int start = extent / 5, length = extent / 2;
+    compare(*dense, row, aopt, length, start, length);
+    compare(*sparse, row, aopt, length, start, length, tatami::Options());
+}
+
+TEST_P(AsyncPrefetchExtractorTest, Index) {
+    auto param = GetParam();
+    auto row = std::get<0>(param);
+    tatami::AsyncPrefetchExtractorOptions aopt;
+    aopt.num_buffers = std::get<1>(param);
+    aopt.batch_size = std::get<2>(param);
+
+    const int extent = (row ? ncol : nrow);
+    auto indices = std::make_shared<std::vector<int> >();
+    for (int i = 1; i < extent; i += 3) {
+        indices->push_back(i);
+    }
+    tatami::VectorPtr<int> iptr(indices);
+    compare(*dense, row, aopt, static_cast<int>(indices->size()), iptr);
+    compare(*sparse, row, aopt, static_cast<int>(indices->size()), iptr, tatami::Options());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AsyncPrefetchExtractor,
+    AsyncPrefetchExtractorTest,
+    ::testing::Combine(
+        ::testing::Values(true, false), // by row or column
+        ::testing::Values(1, 3, 10), // number of buffers
+        ::testing::Values(1, 4, 100) // batch size
+    )
+);
+
+TEST(AsyncPrefetchExtractor, EarlyDestruction) {
+    std::vector<double> values(10000);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = i;
+    }
+    tatami::DenseRowMatrix<double, int> mat(100, 100, std::move(values));
+
+    // Destroying the extractor without consuming all predictions should cleanly stop the thread.
+    {
+        auto ext = tatami::new_async_prefetch_extractor<false>(mat, true, std::make_shared<tatami::ConsecutiveOracle<int> >(0, 100), tatami::AsyncPrefetchExtractorOptions());
+        std::vector<double> buffer(100);
+        auto ptr = ext->fetch(buffer.data());
+        EXPECT_EQ(ptr[0], 0);
+    }
+    {
+        auto ext = tatami::new_async_prefetch_extractor<true>(mat, false, std::make_shared<tatami::ConsecutiveOracle<int> >(0, 100), tatami::AsyncPrefetchExtractorOptions());
+    }
+
+    // Requesting more than the oracle's predictions fails.
+    auto ext = tatami::new_async_prefetch_extractor<false>(mat, true, std::make_shared<tatami::ConsecutiveOracle<int> >(5, 2), tatami::AsyncPrefetchExtractorOptions());
+    std::vector<double> buffer(100);
+    EXPECT_EQ(ext->fetch(buffer.data())[0], 500);
+    EXPECT_EQ(ext->fetch(buffer.data())[0], 600);
+    tatami_test::throws_error([&]() -> void {
+        ext->fetch(buffer.data());
+    }, "no more predictions");
+}
+
+class ThrowingDenseExtractor final : public tatami::OracularDenseExtractor<double, int> {
+public:
+    const double* fetch(int, double* buffer) {
+        if (my_count == 3) {
+            throw std::runtime_error("failed extraction");
+        }
+        buffer[0] = my_count;
+        ++my_count;
+        return buffer;
+    }
+private:
+    int my_count = 0;
+};
+
+TEST(AsyncPrefetchExtractor, Error) {
+    tatami::AsyncPrefetchDenseExtractor<double, int> ext(std::make_unique<ThrowingDenseExtractor>(), 10, 1);
+    double buffer = -1;
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(*(ext.fetch(0, &buffer)), i);
+    }
+    tatami_test::throws_error([&]() -> void {
+        ext.fetch(0, &buffer);
+    }, "failed extraction");
+
+    tatami_test::throws_error([&]() -> void {
+        tatami::AsyncPrefetchExtractorOptions aopt;
+        aopt.num_buffers = 0;
+        tatami::AsyncPrefetchDenseExtractor<double, int> ext(std::make_unique<ThrowingDenseExtractor>(), 10, 1, aopt);
+    }, "number of buffers");
+
+    tatami_test::throws_error([&]() -> void {
+        tatami::AsyncPrefetchExtractorOptions aopt;
+        aopt.batch_size = 0;
+        tatami::AsyncPrefetchDenseExtractor<double, int> ext(std::make_unique<ThrowingDenseExtractor>(), 10, 1, aopt);
+    }, "batch size");
+}
+
+// Backends that return pointers into a single internal buffer, which is overwritten on every fetch.
+class ReusedBufferDenseExtractor final : public tatami::OracularDenseExtractor<double, int> {
+public:
+    ReusedBufferDenseExtractor(int extent) : my_internal(extent) {}
+    const double* fetch(int, double*) {
+        std::fill(my_internal.begin(), my_internal.end(), my_count);
+        ++my_count;
+        return my_internal.data();
+    }
+private:
+    std::vector<double> my_internal;
+    int my_count = 0;
+};
+
+class ReusedBufferSparseExtractor final : public tatami::OracularSparseExtractor<double, int> {
+public:
+    ReusedBufferSparseExtractor(int extent) : my_values(extent), my_indices(extent) {}
+    tatami::SparseRange<double, int> fetch(int, double*, int*) {
+        const int number = my_count % static_cast<int>(my_values.size()) + 1;
+        for (int i = 0; i < number; ++i) {
+            my_values[i] = my_count;
+            my_indices[i] = i;
+        }
+        ++my_count;
+        return tatami::SparseRange<double, int>(number, my_values.data(), my_indices.data());
+    }
+private:
+    std::vector<double> my_values;
+    std::vector<int> my_indices;
+    int my_count = 0;
+};
+
+TEST(AsyncPrefetchExtractor, ReusedBackendBuffer) {
+    const int extent = 7, total = 50;
+    tatami::AsyncPrefetchExtractorOptions aopt;
+    aopt.num_buffers = 5;
+
+    {
+        tatami::AsyncPrefetchDenseExtractor<double, int> ext(std::make_unique<ReusedBufferDenseExtractor>(extent), total, extent, aopt);
+        std::vector<double> buffer(extent);
+        for (int i = 0; i < total; ++i) {
+            if (i % 10 == 0) {
+                // Giving the helper thread a chance to run ahead and overwrite the backend's buffer.
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            auto ptr = ext.fetch(0, buffer.data());
+            EXPECT_EQ(std::vector<double>(ptr, ptr + extent), std::vector<double>(extent, i));
+        }
+    }
+
+    {
+        tatami::AsyncPrefetchSparseExtractor<double, int> ext(std::make_unique<ReusedBufferSparseExtractor>(extent), total, extent, aopt);
+        std::vector<double> vbuffer(extent);
+        std::vector<int> ibuffer(extent);
+        for (int i = 0; i < total; ++i) {
+            if (i % 10 == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            auto range = ext.fetch(0, vbuffer.data(), ibuffer.data());
+            const int expected = i % extent + 1;
+            ASSERT_EQ(range.number, expected);
+            EXPECT_EQ(std::vector<double>(range.value, range.value + range.number), std::vector<double>(expected, i));
+            for (int j = 0; j < expected; ++j) {
+                EXPECT_EQ(range.index[j], j);
+            }
+        }
+    }
+}
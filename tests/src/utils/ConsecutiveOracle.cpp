@@ -3,6 +3,7 @@
 
 #include <random>
 #include <vector>
+#include <limits>
 
 class TestConsecutiveOracle : public ::testing::TestWithParam<std::tuple<int, int> > {};
 
@@ -16,6 +17,18 @@ TEST_P(TestConsecutiveOracle, BasicAccess) {
     for (int i = 0; i < len; ++i) {
         EXPECT_EQ(test->get(i), i + start);
     }
+
+    EXPECT_TRUE(test->is_consecutive());
+    EXPECT_TRUE(test->is_strided());
+    EXPECT_EQ(test->stride(), 1);
+    EXPECT_TRUE(test->is_increasing());
+    if (len > 10) {
+        std::vector<int> buffer(7);
+        auto ptr = test->span(3, buffer.size(), buffer.data());
+        for (int i = 0; i < 7; ++i) {
+            EXPECT_EQ(ptr[i], start + 3 + i);
+        }
+    }
 }
 
 INSTANTIATE_TEST_SUITE_P(
@@ -26,3 +39,10 @@ INSTANTIATE_TEST_SUITE_P(
         ::testing::Values(0, 100, 1000)
     )
 );
+
+TEST(ConsecutiveOracle, Lookahead) {
+    tatami::ConsecutiveOracle<int> test(5, 100);
+    EXPECT_EQ(test.max_lookahead(), std::numeric_limits<tatami::PredictionIndex>::max());
+    test.set_max_lookahead(10);
+    EXPECT_EQ(test.max_lookahead(), 10);
+}
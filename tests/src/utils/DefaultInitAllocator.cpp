@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <string>
+
+#include "tatami/utils/DefaultInitAllocator.hpp"
+
+TEST(DefaultInitAllocator, Basic) {
+    std::vector<double, tatami::DefaultInitAllocator<double> > x(100);
+    EXPECT_EQ(x.size(), 100);
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        x[i] = i;
+    }
+
+    // Explicit values are still respected.
+    std::vector<int, tatami::DefaultInitAllocator<int> > y(50, 2);
+    EXPECT_EQ(y, (std::vector<int, tatami::DefaultInitAllocator<int> >(50, 2)));
+
+    y.resize(100);
+    EXPECT_EQ(y.size(), 100);
+    y.push_back(5);
+    EXPECT_EQ(y.back(), 5);
+
+    // Non-trivial types are still default-constructed.
+    std::vector<std::string, tatami::DefaultInitAllocator<std::string> > z(10);
+    for (const auto& s : z) {
+        EXPECT_TRUE(s.empty());
+    }
+}
@@ -3,6 +3,7 @@
 
 #include <random>
 #include <vector>
+#include <algorithm>
 
 TEST(FixedOracle, BasicAccess) {
     std::mt19937_64 rng(42 * 42);
@@ -40,3 +41,34 @@ TEST(FixedOracle, OtherType) {
         EXPECT_EQ(test_copy->get(i), predictions[i]);
     }
 }
+
+TEST(FixedOracle, Span) {
+    std::vector<int> predictions { 5, 2, 8, 1, 9, 0, 3 };
+    std::vector<int> buffer(4);
+
+    tatami::FixedViewOracle<int> view(predictions.data(), predictions.size());
+    EXPECT_FALSE(view.is_consecutive());
+    EXPECT_FALSE(view.is_strided());
+    EXPECT_FALSE(view.is_increasing());
+    auto vptr = view.span(2, 4, buffer.data());
+    EXPECT_EQ(vptr, predictions.data() + 2); // no copy for contiguous storage.
+
+    tatami::FixedVectorOracle<int> vec(predictions);
+    EXPECT_FALSE(vec.is_consecutive());
+    auto cptr = vec.span(2, 4, buffer.data());
+    EXPECT_EQ(std::vector<int>(cptr, cptr + 4), std::vector<int>(predictions.begin() + 2, predictions.begin() + 6));
+    EXPECT_NE(cptr, buffer.data());
+
+    // Falls back to the default implementation with a copy.
+    std::vector<unsigned> upredictions(predictions.begin(), predictions.end());
+    tatami::FixedVectorOracle<int, std::vector<unsigned> > uvec(upredictions);
+    auto uptr = uvec.span(2, 4, buffer.data());
+    EXPECT_EQ(uptr, buffer.data());
+    EXPECT_EQ(buffer, std::vector<int>(predictions.begin() + 2, predictions.begin() + 6));
+
+    tatami::FixedViewOracle<int, const unsigned*> uview(upredictions.data(), upredictions.size());
+    std::fill(buffer.begin(), buffer.end(), 0);
+    auto uvptr = uview.span(1, 4, buffer.data());
+    EXPECT_EQ(uvptr, buffer.data());
+    EXPECT_EQ(buffer, std::vector<int>(predictions.begin() + 1, predictions.begin() + 5));
+}
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory>
+#include <random>
+
+#include "tatami/dense/DenseMatrix.hpp"
+#include "tatami/sparse/convert_to_compressed_sparse.hpp"
+#include "tatami/utils/ReorderedExtraction.hpp"
+
+#include "tatami_test/tatami_test.hpp"
+
+class ReorderedExtractionTest : public ::testing::TestWithParam<std::tuple<bool, std::size_t> > {
+protected:
+    inline static int nrow = 67, ncol = 41;
+    inline static std::shared_ptr<tatami::NumericMatrix> dense, sparse;
+
+    static void SetUpTestSuite() {
+        auto simulated = tatami_test::simulate_vector<double>(nrow * ncol, []{
+            tatami_test::SimulateVectorOptions opt;
+            opt.density = 0.2;
+            opt.seed = 9182;
+            return opt;
+        }());
+        dense.reset(new tatami::DenseMatrix<double, int, decltype(simulated)>(nrow, ncol, std::move(simulated), true));
+        sparse = tatami::convert_to_compressed_sparse<double, int>(*dense, false, {});
+    }
+
+    static std::vector<int> create_requests(int dim) {
+        std::mt19937_64 rng(dim * 13);
+        std::vector<int> requested(dim * 2); // guaranteed to have some duplicates.
+        for (auto& r : requested) {
+            r = rng() % dim;
+        }
+        return requested;
+    }
+
+    template<typename ... Args_>
+    static void compare(const tatami::NumericMatrix& mat, bool row, const tatami::ReorderedExtractionOptions& ropt, int extent, Args_... args) {
+        const int dim = (row ? mat.nrow() : mat.ncol());
+        const auto requested = create_requests(dim);
+
+        auto ref = tatami::new_extractor<false, false>(mat, row, false, args...);
+        std::vector<std::vector<double> > expected;
+        std::vector<double> rbuffer(extent);
+        for (auto r : requested) {
+            auto rptr = ref->fetch(r, rbuffer.data());
+            expected.emplace_back(rptr, rptr + extent);
+        }
+
+        // In order.
+        {
+            tatami::ReorderedDenseExtraction<double, int> ext(mat, row, requested, ropt, args...);
+            EXPECT_EQ(ext.total(), requested.size());
+            std::vector<double> buffer(extent);
+            for (std::size_t i = 0; i < requested.size(); ++i) {
+                auto ptr = ext.fetch(buffer.data());
+                EXPECT_EQ(expected[i], std::vector<double>(ptr, ptr + extent));
+            }
+
+            tatami_test::throws_error([&]() -> void {
+                ext.fetch(buffer.data());
+            }, "already been fetched");
+        }
+
+        {
+            tatami::ReorderedSparseExtraction<double, int> ext(mat, row, requested, ropt, args...);
+            std::vector<double> vbuffer(extent);
+            std::vector<int> ibuffer(extent);
+            for (std::size_t i = 0; i < requested.size(); ++i) {
+                auto range = ext.fetch(vbuffer.data(), ibuffer.data());
+                auto sref = tatami::new_extractor<true, false>(mat, row, false, args...);
+                std::vector<double> rvbuffer(extent);
+                std::vector<int> ribuffer(extent);
+                auto rrange = sref->fetch(requested[i], rvbuffer.data(), ribuffer.data());
+                ASSERT_EQ(rrange.number, range.number);
+                EXPECT_EQ(std::vector<double>(rrange.value, rrange.value + rrange.number), std::vector<double>(range.value, range.value + range.number));
+                EXPECT_EQ(std::vector<int>(rrange.index, rrange.index + rrange.number), std::vector<int>(range.index, range.index + range.number));
+            }
+        }
+
+        // Scattering.
+        {
+            tatami::ReorderedDenseExtraction<double, int> ext(mat, row, requested, ropt, args...);
+            std::vector<std::vector<double> > observed(requested.size());
+            std::vector<double> buffer(extent);
+            int last = -1;
+            std::size_t nused = 0;
+            for (std::size_t i = 0, end = ext.total_unordered(); i < end; ++i) {
+                auto res = ext.fetch_unordered(buffer.data());
+                ASSERT_GT(res.second.size(), 0);
+                auto current = requested[res.second[0]];
+                if (ropt.buffer_size == 0) {
+                    EXPECT_GT(current, last); // everything is sorted and unique.
+                }
+                last = current;
+                for (auto p : res.second) {
+                    EXPECT_EQ(requested[p], current);
+                    observed[p].insert(observed[p].end(), res.first, res.first + extent);
+                    ++nused;
+                }
+            }
+            EXPECT_EQ(nused, requested.size());
+            EXPECT_EQ(observed, expected);
+        }
+
+        {
+            auto sref = tatami::new_extractor<true, false>(mat, row, false, args...);
+            std::vector<double> rvbuffer(extent);
+            std::vector<int> ribuffer(extent);
+
+            tatami::ReorderedSparseExtraction<double, int> ext(mat, row, requested, ropt, args...);
+            std::vector<double> vbuffer(extent);
+            std::vector<int> ibuffer(extent);
+            std::size_t nused = 0;
+            for (std::size_t i = 0, end = ext.total_unordered(); i < end; ++i) {
+                auto res = ext.fetch_unordered(vbuffer.data(), ibuffer.data());
+                for (auto p : res.second) {
+                    auto rrange = sref->fetch(requested[p], rvbuffer.data(), ribuffer.data());
+                    ASSERT_EQ(rrange.number, res.first.number);
+                    EXPECT_EQ(std::vector<double>(rrange.value, rrange.value + rrange.number), std::vector<double>(res.first.value, res.first.value + res.first.number));
+                    EXPECT_EQ(std::vector<int>(rrange.index, rrange.index + rrange.number), std::vector<int>(res.first.index, res.first.index + res.first.number));
+                    ++nused;
+                }
+            }
+            EXPECT_EQ(nused, requested.size());
+        }
+    }
+};
+
+TEST_P(ReorderedExtractionTest, Full) {
+    auto param = GetParam();
+    auto row = std::get<0>(param);
+    tatami::ReorderedExtractionOptions ropt;
+    ropt.buffer_size = std::get<1>(param);
+
+    const int extent = (row ? ncol : nrow);
+    compare(*dense, row, ropt, extent);
+    compare(*sparse, row, ropt, extent);
+}
+
+TEST_P(ReorderedExtractionTest, Block) {
+    auto param = GetParam();
+    auto row = std::get<0>(param);
+    tatami::ReorderedExtractionOptions ropt;
+    ropt.buffer_size = std::get<1>(param);
+
+    const int extent = (row ? ncol : nrow);
+    const int start = extent / 4, length = extent / 2;
+    compare(*dense, row, ropt, length, start, length);
+    compare(*sparse, row, ropt, length, start, length, tatami::Options());
+}
+
+TEST_P(ReorderedExtractionTest, Index) {
+    auto param = GetParam();
+    auto row = std::get<0>(param);
+    tatami::ReorderedExtractionOptions ropt;
+    ropt.buffer_size = std::get<1>(param);
+
+    const int extent = (row ? ncol : nrow);
+    auto indices = std::make_shared<std::vector<int> >();
+    for (int i = 2; i < extent; i += 3) {
+        indices->push_back(i);
+    }
+    tatami::VectorPtr<int> iptr(indices);
+    compare(*dense, row, ropt, static_cast<int>(indices->size()), iptr);
+    compare(*sparse, row, ropt, static_cast<int>(indices->size()), iptr, tatami::Options());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ReorderedExtraction,
+    ReorderedExtractionTest,
+    ::testing::Combine(
+        ::testing::Values(true, false), // by row or column
+        ::testing::Values(0, 1, 7, 50) // buffer size
+    )
+);
+
+TEST(ReorderedExtraction, Consecutive) {
+    std::vector<double> values(100);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = i;
+    }
+    tatami::DenseRowMatrix<double, int> mat(10, 10, std::move(values));
+
+    // Sorted requests are extracted with a consecutive oracle.
+    std::vector<int> requested{ 5, 3, 4, 6, 3 };
+    tatami::ReorderedExtractionOptions ropt;
+    ropt.buffer_size = 0;
+    tatami::ReorderedDenseExtraction<double, int> ext(mat, true, requested, ropt);
+    EXPECT_EQ(ext.total(), 5);
+    EXPECT_EQ(ext.total_unordered(), 4);
+
+    std::vector<double> buffer(10);
+    for (auto r : requested) {
+        EXPECT_EQ(ext.fetch(buffer.data())[0], r * 10);
+    }
+
+    // Empty requests are also fine.
+    tatami::ReorderedDenseExtraction<double, int> empty(mat, true, std::vector<int>{}, ropt);
+    EXPECT_EQ(empty.total(), 0);
+    EXPECT_EQ(empty.total_unordered(), 0);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "tatami/utils/ThreadPool.hpp"
+#include "tatami/utils/parallelize.hpp"
+
+static void check_ranges(const std::vector<int>& start, const std::vector<int>& length, int tasks) {
+    int last = 0;
+    for (std::size_t t = 0; t < start.size(); ++t) {
+        EXPECT_EQ(last, start[t]);
+        EXPECT_GT(length[t], 0);
+        last += length[t];
+    }
+    EXPECT_EQ(last, tasks);
+}
+
+TEST(ThreadPool, Basic) {
+    tatami::ThreadPool pool(3);
+    EXPECT_EQ(pool.num_threads(), 3);
+
+    // Repeated calls re-use the same threads.
+    for (int it = 0; it < 20; ++it) {
+        std::vector<int> start(5, -1), length(5, -1), calls(5);
+        auto used = pool.run([&](int w, int s, int l) -> void {
+            start[w] = s;
+            length[w] = l;
+            ++calls[w];
+        }, 101, 5);
+
+        EXPECT_EQ(used, 5);
+        EXPECT_EQ(calls, std::vector<int>(5, 1));
+        check_ranges(start, length, 101);
+        EXPECT_EQ(length, std::vector<int>({ 21, 20, 20, 20, 20 }));
+    }
+}
+
+TEST(ThreadPool, FewTasks) {
+    tatami::ThreadPool pool(4);
+
+    std::vector<int> start(10, -1), length(10, -1);
+    auto used = pool.run([&](int w, int s, int l) -> void {
+        start[w] = s;
+        length[w] = l;
+    }, 3, 10);
+    EXPECT_EQ(used, 3);
+    start.resize(used);
+    length.resize(used);
+    check_ranges(start, length, 3);
+
+    EXPECT_EQ(pool.run([&](int, int, int) -> void {}, 0, 10), 0);
+}
+
+TEST(ThreadPool, SingleThread) {
+    tatami::ThreadPool pool(1);
+    EXPECT_EQ(pool.num_threads(), 1);
+
+    std::vector<int> start(4, -1), length(4, -1);
+    auto used = pool.run([&](int w, int s, int l) -> void {
+        start[w] = s;
+        length[w] = l;
+    }, 50, 4);
+    EXPECT_EQ(used, 4);
+    check_ranges(start, length, 50);
+}
+
+TEST(ThreadPool, Nested) {
+    tatami::ThreadPool pool(2);
+
+    // All threads are busy in the outer job, so the inner jobs must be processed by their calling threads.
+    std::vector<int> totals(4);
+    pool.run([&](int w, int, int) -> void {
+        std::vector<int> inner(3);
+        pool.run([&](int iw, int, int l) -> void {
+            inner[iw] = l;
+        }, 30, 3);
+        totals[w] = inner[0] + inner[1] + inner[2];
+    }, 4, 4);
+
+    EXPECT_EQ(totals, std::vector<int>(4, 30));
+}
+
+TEST(ThreadPool, Error) {
+    tatami::ThreadPool pool(3);
+
+    std::vector<int> calls(3);
+    bool caught = false;
+    try {
+        pool.run([&](int w, int, int) -> void {
+            ++calls[w];
+            if (w == 1) {
+                throw std::runtime_error("oops");
+            }
+        }, 30, 3);
+    } catch (std::exception& e) {
+        caught = true;
+        EXPECT_EQ(std::string(e.what()), "oops");
+    }
+    EXPECT_TRUE(caught);
+
+    // Other ranges are still processed.
+    EXPECT_EQ(calls, std::vector<int>(3, 1));
+
+    // Pool is still usable afterwards.
+    std::vector<int> length(3);
+    pool.run([&](int w, int, int l) -> void {
+        length[w] = l;
+    }, 30, 3);
+    EXPECT_EQ(length, std::vector<int>(3, 10));
+}
+
+TEST(ThreadPool, Parallelize) {
+    tatami::set_parallelize_thread_pool(std::make_shared<tatami::ThreadPool>(3));
+
+    std::vector<int> start(4, -1), length(4, -1);
+    auto used = tatami::parallelize([&](int t, int s, int l) -> void {
+        start[t] = s;
+        length[t] = l;
+    }, 100, 4);
+    EXPECT_EQ(used, 4);
+    check_ranges(start, length, 100);
+
+    // Same ranges as the default.
+    tatami::set_parallelize_thread_pool(nullptr);
+    std::vector<int> ref_start(4, -1), ref_length(4, -1);
+    tatami::parallelize([&](int t, int s, int l) -> void {
+        ref_start[t] = s;
+        ref_length[t] = l;
+    }, 100, 4);
+    EXPECT_EQ(start, ref_start);
+    EXPECT_EQ(length, ref_length);
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "tatami/utils/gather.hpp"
+
+#include <vector>
+#include <random>
+#include <numeric>
+#include <memory>
+
+static std::vector<double> reference_gather(const std::vector<double>& source, const std::vector<int>& indices) {
+    std::vector<double> output;
+    output.reserve(indices.size());
+    for (auto i : indices) {
+        output.push_back(source[i]);
+    }
+    return output;
+}
+
+TEST(GatherIndices, Empty) {
+    tatami::GatherIndices<int> empty;
+    EXPECT_EQ(empty.size(), 0);
+    EXPECT_FALSE(empty.uses_runs());
+
+    tatami::GatherIndices<int> also_empty(std::make_shared<const std::vector<int> >());
+    EXPECT_EQ(also_empty.size(), 0);
+    EXPECT_FALSE(also_empty.uses_runs());
+
+    double dummy = 0;
+    EXPECT_EQ(also_empty.gather(&dummy, &dummy), &dummy);
+}
+
+TEST(GatherIndices, Runs) {
+    std::vector<double> source(100);
+    std::iota(source.begin(), source.end(), 0.5);
+
+    {
+        std::vector<int> indices(50);
+        std::iota(indices.begin(), indices.end(), 20);
+        tatami::GatherIndices<int> gatherer(indices.data(), indices.size());
+        EXPECT_TRUE(gatherer.uses_runs());
+        std::vector<double> output(indices.size());
+        EXPECT_EQ(gatherer.gather(source.data(), output.data()), output.data());
+        EXPECT_EQ(output, reference_gather(source, indices));
+    }
+
+    {
+        std::vector<int> indices { 5, 6, 7, 8, 0, 1, 2, 3, 4, 90, 91, 92, 93, 5, 6, 7 };
+        tatami::GatherIndices<int> gatherer(indices.data(), indices.size());
+        EXPECT_TRUE(gatherer.uses_runs());
+        std::vector<double> output(indices.size());
+        gatherer.gather(source.begin(), output.data());
+        EXPECT_EQ(output, reference_gather(source, indices));
+
+        // Runs are ignored if we raise the minimum length.
+        tatami::GatherIndices<int> scalar(indices.data(), indices.size(), 10);
+        EXPECT_FALSE(scalar.uses_runs());
+        std::vector<double> output2(indices.size());
+        scalar.gather(source.begin(), output2.data());
+        EXPECT_EQ(output, output2);
+    }
+}
+
+TEST(GatherIndices, Scattered) {
+    std::vector<double> source(100);
+    std::iota(source.begin(), source.end(), -1.5);
+
+    std::vector<int> indices { 99, 0, 50, 50, 2, 4, 6, 8, 1, 1 };
+    tatami::GatherIndices<int> gatherer(indices.data(), indices.size());
+    EXPECT_FALSE(gatherer.uses_runs());
+    EXPECT_EQ(gatherer.size(), indices.size());
+
+    std::vector<int> output(indices.size()); // checking conversion to a different output type.
+    gatherer.gather(source.data(), output.data());
+    auto expected = reference_gather(source, indices);
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        EXPECT_EQ(output[i], static_cast<int>(expected[i]));
+    }
+}
+
+TEST(GatherIndices, Random) {
+    std::mt19937_64 rng(42);
+    std::vector<double> source(1000);
+    std::normal_distribution<double> ndist;
+    for (auto& s : source) {
+        s = ndist(rng);
+    }
+
+    for (int it = 0; it < 20; ++it) {
+        std::vector<int> indices;
+        std::uniform_int_distribution<int> start_dist(0, 989), len_dist(1, 10);
+        while (indices.size() < 200) {
+            const int start = start_dist(rng);
+            const int len = len_dist(rng);
+            for (int l = 0; l < len; ++l) {
+                indices.push_back(start + l);
+            }
+        }
+
+        tatami::GatherIndices<int> gatherer(indices.data(), indices.size());
+        std::vector<double> output(indices.size());
+        gatherer.gather(source.data(), output.data());
+        EXPECT_EQ(output, reference_gather(source, indices));
+    }
+}
+
+TEST(GatherIndices, Shared) {
+    std::vector<double> source(100);
+    std::iota(source.begin(), source.end(), 2.5);
+
+    std::vector<int> indices { 10, 11, 12, 13, 14, 50, 51, 52, 53, 54, 99, 98 };
+    auto expected = reference_gather(source, indices);
+    auto iptr = std::make_shared<const std::vector<int> >(std::move(indices));
+
+    std::vector<tatami::GatherIndices<int> > gatherers;
+    for (int i = 0; i < 3; ++i) {
+        gatherers.emplace_back(iptr);
+    }
+    EXPECT_EQ(iptr.use_count(), 4); // shared, not copied.
+    iptr.reset();
+
+    // Gatherers keep the indices alive after the original pointer is released, along with any copies.
+    auto copy = gatherers.front();
+    gatherers.clear();
+    EXPECT_FALSE(copy.uses_runs());
+    EXPECT_EQ(copy.size(), expected.size());
+    std::vector<double> output(expected.size());
+    copy.gather(source.data(), output.data());
+    EXPECT_EQ(output, expected);
+}
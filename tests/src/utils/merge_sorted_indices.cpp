@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "tatami/utils/merge_sorted_indices.hpp"
+
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <tuple>
+#include <cstdint>
+#include <limits>
+
+// Reference implementation to check the merge results.
+static std::vector<std::tuple<int, int, int> > reference_merge(const std::vector<int>& left, const std::vector<int>& right, bool intersect) {
+    std::vector<std::tuple<int, int, int> > output;
+    std::size_t l = 0, r = 0;
+    while (l < left.size() || r < right.size()) {
+        if (r == right.size() || (l < left.size() && left[l] < right[r])) {
+            if (!intersect) {
+                output.emplace_back(left[l], l, -1);
+            }
+            ++l;
+        } else if (l == left.size() || left[l] > right[r]) {
+            if (!intersect) {
+                output.emplace_back(right[r], -1, r);
+            }
+            ++r;
+        } else {
+            output.emplace_back(left[l], l, r);
+            ++l;
+            ++r;
+        }
+    }
+    return output;
+}
+
+template<bool intersect_>
+static std::vector<std::tuple<int, int, int> > run_merge(const std::vector<int>& left, const std::vector<int>& right) {
+    std::vector<std::tuple<int, int, int> > output;
+    tatami::merge_sorted_indices<intersect_>(
+        static_cast<int>(left.size()),
+        left.data(),
+        static_cast<int>(right.size()),
+        right.data(),
+        [&](int l, int r) -> void { output.emplace_back(left[l], l, r); },
+        [&](int l) -> void { output.emplace_back(left[l], l, -1); },
+        [&](int r) -> void { output.emplace_back(right[r], -1, r); }
+    );
+    return output;
+}
+
+static std::vector<int> simulate_indices(int extent, double density, int seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<> unif(0, 1);
+    std::vector<int> output;
+    for (int i = 0; i < extent; ++i) {
+        if (unif(rng) < density) {
+            output.push_back(i);
+        }
+    }
+    return output;
+}
+
+class MergeSortedIndicesTest : public ::testing::TestWithParam<std::tuple<double, double> > {};
+
+TEST_P(MergeSortedIndicesTest, Basic) {
+    auto param = GetParam();
+    auto left = simulate_indices(1000, std::get<0>(param), 1234);
+    auto right = simulate_indices(1000, std::get<1>(param), 5678);
+
+    EXPECT_EQ(run_merge<false>(left, right), reference_merge(left, right, false));
+    EXPECT_EQ(run_merge<true>(left, right), reference_merge(left, right, true));
+
+    // Swapping the order.
+    EXPECT_EQ(run_merge<false>(right, left), reference_merge(right, left, false));
+    EXPECT_EQ(run_merge<true>(right, left), reference_merge(right, left, true));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    MergeSortedIndices,
+    MergeSortedIndicesTest,
+    ::testing::Combine(
+        ::testing::Values(0, 0.001, 0.01, 0.1, 0.5), // density of the left array.
+        ::testing::Values(0, 0.01, 0.2, 0.9, 1) // density of the right array.
+    )
+);
+
+TEST(MergeSortedIndices, Galloping) {
+    // Checking the edge cases when the short array's indices lie outside the range of the long array.
+    std::vector<int> left{ 0, 500, 999 };
+    std::vector<int> right;
+    for (int i = 100; i < 900; i += 2) {
+        right.push_back(i);
+    }
+    EXPECT_EQ(run_merge<false>(left, right), reference_merge(left, right, false));
+    EXPECT_EQ(run_merge<true>(left, right), reference_merge(left, right, true));
+    EXPECT_EQ(run_merge<false>(right, left), reference_merge(right, left, false));
+    EXPECT_EQ(run_merge<true>(right, left), reference_merge(right, left, true));
+
+    std::vector<int> left2{ 898, 899 };
+    EXPECT_EQ(run_merge<false>(left2, right), reference_merge(left2, right, false));
+    EXPECT_EQ(run_merge<true>(left2, right), reference_merge(left2, right, true));
+}
+
+TEST(MergeSortedIndices, GallopingOverflow) {
+    // Using a small index type so that doubling the step would overflow for the longest possible array.
+    typedef std::int8_t Index;
+    const Index end = std::numeric_limits<Index>::max();
+    std::vector<Index> indices(end);
+    for (Index i = 0; i < end; ++i) {
+        indices[i] = i;
+    }
+
+    for (int pos = 0; pos < end; pos += 10) {
+        for (int target = pos; target <= end; ++target) {
+            const auto observed = tatami::merge_sorted_indices_internal::gallop<Index>(indices.data(), pos, end, target);
+            const auto expected = std::lower_bound(indices.begin() + pos, indices.end(), target) - indices.begin();
+            EXPECT_EQ(observed, expected);
+        }
+    }
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <algorithm>
+
+#ifdef __linux__
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+#include "tatami/utils/parallelize_numa.hpp"
+
+TEST(ParallelizeNuma, Basic) {
+    EXPECT_GE(tatami::numa_node_count(), 1);
+
+    // Same ranges as parallelize(), regardless of the number of nodes.
+    std::vector<int> start(4, -1), length(4, -1);
+    auto used = tatami::parallelize_numa([&](int t, int s, int l) -> void {
+        start[t] = s;
+        length[t] = l;
+    }, 100, 4);
+    EXPECT_EQ(used, 4);
+
+    std::vector<int> ref_start(4, -1), ref_length(4, -1);
+    tatami::parallelize([&](int t, int s, int l) -> void {
+        ref_start[t] = s;
+        ref_length[t] = l;
+    }, 100, 4);
+    EXPECT_EQ(start, ref_start);
+    EXPECT_EQ(length, ref_length);
+
+    used = tatami::parallelize_numa<false>([&](int t, int s, int l) -> void {
+        start[t] = s;
+        length[t] = l;
+    }, 100, 4);
+    EXPECT_EQ(used, 1);
+    EXPECT_EQ(start.front(), 0);
+    EXPECT_EQ(length.front(), 100);
+}
+
+TEST(ParallelizeNuma, StableMapping) {
+    // Repeated calls with the same tasks and workers should assign the same ranges and nodes to each worker,
+    // so that the pages first touched in one call are accessed from the same node in the next.
+    auto run = [&](int tasks, int workers) -> std::vector<std::vector<int> > {
+        std::vector<std::vector<int> > mapping(workers);
+        tatami::parallelize_numa([&](int t, int s, int l) -> void {
+            mapping[t] = std::vector<int>{ s, l, tatami::numa_node_for_task(s, tasks) };
+
+#ifdef __linux__
+            // Checking that the worker is actually pinned to the node's CPUs, if there are multiple nodes.
+            const auto& nodes = tatami::parallelize_numa_internal::node_cpus();
+            if (nodes.size() > 1) {
+                cpu_set_t current;
+                if (sched_getaffinity(0, sizeof(cpu_set_t), &current) == 0) {
+                    const auto& allowed = nodes[mapping[t][2]];
+                    for (int c = 0; c < CPU_SETSIZE; ++c) {
+                        if (CPU_ISSET(c, &current) && std::find(allowed.begin(), allowed.end(), c) == allowed.end()) {
+                            mapping[t].push_back(-1);
+                            break;
+                        }
+                    }
+                }
+            }
+#endif
+        }, tasks, workers);
+        return mapping;
+    };
+
+    for (int workers : { 1, 3, 8 }) {
+        for (int tasks : { 5, 100, 1001 }) {
+            auto first = run(tasks, workers);
+            for (const auto& m : first) {
+                if (!m.empty()) {
+                    EXPECT_EQ(m.size(), 3); // i.e., no unpinned workers.
+                }
+            }
+            for (int rep = 0; rep < 3; ++rep) {
+                EXPECT_EQ(run(tasks, workers), first);
+            }
+        }
+    }
+}
+
+TEST(ParallelizeNuma, NodeForTask) {
+    const int nodes = tatami::numa_node_count();
+    int last = 0;
+    for (int t = 0; t < 1000; ++t) {
+        const int node = tatami::numa_node_for_task(t, 1000);
+        EXPECT_GE(node, last);
+        EXPECT_LT(node, nodes);
+        last = node;
+    }
+    EXPECT_EQ(tatami::numa_node_for_task(0, 1000), 0);
+    EXPECT_EQ(last, nodes - 1);
+}
+
+#ifdef __linux__
+TEST(ParallelizeNuma, ParseCpuList) {
+    EXPECT_EQ(tatami::parallelize_numa_internal::parse_cpu_list("0-3,8,10-11\n"), std::vector<int>({ 0, 1, 2, 3, 8, 10, 11 }));
+    EXPECT_EQ(tatami::parallelize_numa_internal::parse_cpu_list("5"), std::vector<int>({ 5 }));
+    EXPECT_TRUE(tatami::parallelize_numa_internal::parse_cpu_list("").empty());
+}
+
+TEST(ParallelizeNuma, ReadNodeCpus) {
+    char tmpl[] = "/tmp/tatami-numa-XXXXXX";
+    ASSERT_NE(mkdtemp(tmpl), nullptr);
+    const std::string root(tmpl);
+
+    // Node IDs are not contiguous, and there are some other entries that should be ignored.
+    auto add_node = [&](const std::string& name, const std::string& cpus) -> void {
+        const auto path = root + "/" + name;
+        ASSERT_EQ(mkdir(path.c_str(), 0700), 0);
+        std::ofstream handle(path + "/cpulist");
+        handle << cpus << "\n";
+    };
+    add_node("node2", "4-5");
+    add_node("node0", "0-1");
+    add_node("node10", "6");
+    add_node("nodefoo", "7");
+    add_node("possible", "0-7");
+
+    auto nodes = tatami::parallelize_numa_internal::read_node_cpus(root);
+    ASSERT_EQ(nodes.size(), 3);
+    EXPECT_EQ(nodes[0], std::vector<int>({ 0, 1 }));
+    EXPECT_EQ(nodes[1], std::vector<int>({ 4, 5 }));
+    EXPECT_EQ(nodes[2], std::vector<int>({ 6 }));
+
+    // Missing directory means that we have no NUMA information.
+    EXPECT_TRUE(tatami::parallelize_numa_internal::read_node_cpus(root + "/missing").empty());
+
+    for (const auto& name : { "node2", "node0", "node10", "nodefoo", "possible" }) {
+        const auto path = root + "/" + name;
+        std::remove((path + "/cpulist").c_str());
+        rmdir(path.c_str());
+    }
+    rmdir(root.c_str());
+}
+#endif
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "../custom_parallel.h"
+
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstddef>
+
+#include "tatami/utils/parallelize_weighted.hpp"
+
+class ParallelizeWeightedTest : public ::testing::Test {
+protected:
+    // Collecting the ranges and checking that they cover [0, tasks) without overlap.
+    static std::vector<std::pair<int, int> > collect(const std::vector<std::pair<int, int> >& ranges, int used, int tasks) {
+        auto sorted = ranges;
+        sorted.resize(used);
+        std::sort(sorted.begin(), sorted.end());
+
+        int last = 0;
+        for (const auto& r : sorted) {
+            EXPECT_EQ(r.first, last);
+            EXPECT_GT(r.second, 0);
+            last += r.second;
+        }
+        EXPECT_EQ(last, tasks);
+        return sorted;
+    }
+};
+
+TEST_F(ParallelizeWeightedTest, Uniform) {
+    std::vector<double> costs(100, 1);
+    std::vector<std::pair<int, int> > ranges(4);
+    auto used = tatami::parallelize_weighted([&](int t, int s, int l) -> void {
+        ranges[t] = std::make_pair(s, l);
+    }, costs.data(), 100, 4);
+
+    EXPECT_EQ(used, 4);
+    auto sorted = collect(ranges, used, 100);
+    for (const auto& r : sorted) {
+        EXPECT_EQ(r.second, 25);
+    }
+}
+
+TEST_F(ParallelizeWeightedTest, Skewed) {
+    // First 10 tasks are 10 times more expensive than the rest.
+    std::vector<int> costs(100, 1);
+    std::fill_n(costs.begin(), 10, 10);
+
+    std::vector<std::pair<int, int> > ranges(3);
+    auto used = tatami::parallelize_weighted([&](int t, int s, int l) -> void {
+        ranges[t] = std::make_pair(s, l);
+    }, costs.data(), 100, 3);
+
+    EXPECT_EQ(used, 3);
+    auto sorted = collect(ranges, used, 100);
+
+    // Total cost is 190, so each range should have a cost of about 63.
+    for (const auto& r : sorted) {
+        int total = 0;
+        for (int i = r.first; i < r.first + r.second; ++i) {
+            total += costs[i];
+        }
+        EXPECT_LE(std::abs(total - 63), 10);
+    }
+    EXPECT_LT(sorted.front().second, 10);
+}
+
+TEST_F(ParallelizeWeightedTest, Extreme) {
+    // Every range still has at least one task, even if one task dominates the cost.
+    std::vector<double> costs(10);
+    costs[9] = 100;
+
+    std::vector<std::pair<int, int> > ranges(5);
+    auto used = tatami::parallelize_weighted([&](int t, int s, int l) -> void {
+        ranges[t] = std::make_pair(s, l);
+    }, costs.data(), 10, 5);
+    EXPECT_EQ(used, 5);
+    auto sorted = collect(ranges, used, 10);
+    EXPECT_EQ(sorted.back(), std::make_pair(9, 1));
+
+    // More workers than tasks.
+    ranges.resize(20);
+    used = tatami::parallelize_weighted([&](int t, int s, int l) -> void {
+        ranges[t] = std::make_pair(s, l);
+    }, costs.data(), 10, 20);
+    EXPECT_EQ(used, 10);
+    collect(ranges, used, 10);
+
+    // No tasks.
+    used = tatami::parallelize_weighted([&](int, int, int) -> void {}, costs.data(), 0, 5);
+    EXPECT_EQ(used, 0);
+}
+
+TEST_F(ParallelizeWeightedTest, ZeroCost) {
+    // Falls back to an even split when all tasks are free.
+    std::vector<double> costs(10);
+    std::vector<std::pair<int, int> > ranges(4);
+    auto used = tatami::parallelize_weighted([&](int t, int s, int l) -> void {
+        ranges[t] = std::make_pair(s, l);
+    }, costs.data(), 10, 4);
+
+    EXPECT_EQ(used, 4);
+    auto sorted = collect(ranges, used, 10);
+    std::vector<std::pair<int, int> > expected{ { 0, 3 }, { 3, 3 }, { 6, 2 }, { 8, 2 } };
+    EXPECT_EQ(sorted, expected);
+
+    // Same for unsigned indices.
+    std::vector<std::pair<unsigned, unsigned> > uranges(3);
+    auto uused = tatami::parallelize_weighted([&](int t, unsigned s, unsigned l) -> void {
+        uranges[t] = std::make_pair(s, l);
+    }, costs.data(), 9u, 3);
+    EXPECT_EQ(uused, 3);
+    std::sort(uranges.begin(), uranges.end());
+    std::vector<std::pair<unsigned, unsigned> > uexpected{ { 0, 3 }, { 3, 3 }, { 6, 3 } };
+    EXPECT_EQ(uranges, uexpected);
+}
+
+TEST_F(ParallelizeWeightedTest, Serial) {
+    std::vector<double> costs(10, 1);
+    std::vector<std::pair<int, int> > ranges(5);
+    auto used = tatami::parallelize_weighted<false>([&](int t, int s, int l) -> void {
+        ranges[t] = std::make_pair(s, l);
+    }, costs.data(), 10, 5);
+    EXPECT_EQ(used, 1);
+    EXPECT_EQ(ranges.front(), std::make_pair(0, 10));
+
+    used = tatami::parallelize_weighted([&](int t, int s, int l) -> void {
+        ranges[t] = std::make_pair(s, l);
+    }, costs.data(), 10, 1);
+    EXPECT_EQ(used, 1);
+    EXPECT_EQ(ranges.front(), std::make_pair(0, 10));
+}
+
+TEST_F(ParallelizeWeightedTest, Pointers) {
+    std::vector<int> counts(50, 2);
+    std::fill_n(counts.begin() + 40, 10, 50);
+    std::vector<std::size_t> pointers(51);
+    for (int i = 0; i < 50; ++i) {
+        pointers[i + 1] = pointers[i] + counts[i];
+    }
+
+    std::vector<std::pair<int, int> > ranges(4), ref(4);
+    auto used = tatami::parallelize_by_pointers([&](int t, int s, int l) -> void {
+        ranges[t] = std::make_pair(s, l);
+    }, pointers.data(), 50, 4);
+    EXPECT_EQ(used, 4);
+
+    // Same as using the costs directly.
+    std::vector<int> costs(counts);
+    for (auto& c : costs) {
+        ++c;
+    }
+    auto ref_used = tatami::parallelize_weighted([&](int t, int s, int l) -> void {
+        ref[t] = std::make_pair(s, l);
+    }, costs.data(), 50, 4);
+    EXPECT_EQ(used, ref_used);
+    EXPECT_EQ(collect(ranges, used, 50), collect(ref, ref_used, 50));
+}
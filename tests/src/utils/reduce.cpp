@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory>
+#include <tuple>
+
+#include "tatami/dense/DenseMatrix.hpp"
+#include "tatami/dense/convert_to_dense.hpp"
+#include "tatami/sparse/convert_to_compressed_sparse.hpp"
+#include "tatami/utils/reduce.hpp"
+
+#include "tatami_test/tatami_test.hpp"
+
+class ReduceTest : public ::testing::TestWithParam<std::tuple<bool, bool, int> > {
+protected:
+    inline static int nrow = 123, ncol = 87;
+    inline static std::vector<double> simulated;
+
+    static void SetUpTestSuite() {
+        simulated = tatami_test::simulate_vector<double>(nrow * ncol, []{
+            tatami_test::SimulateVectorOptions opt;
+            opt.density = 0.15;
+            opt.seed = 912873;
+            return opt;
+        }());
+    }
+
+    // Computing both the row and column sums in a single pass.
+    struct Sums {
+        std::vector<double> row, column;
+    };
+
+    static Sums compute(const tatami::NumericMatrix& mat, int threads) {
+        tatami::ReduceOptions ropt;
+        ropt.num_threads = threads;
+        return tatami::reduce(
+            mat,
+            [&]() -> Sums {
+                Sums output;
+                output.row.resize(nrow);
+                output.column.resize(ncol);
+                return output;
+            },
+            [&](Sums& state, bool row, int i, const double* values) -> void {
+                auto& target = (row ? state.row : state.column);
+                auto& other = (row ? state.column : state.row);
+                for (std::size_t j = 0; j < other.size(); ++j) {
+                    target[i] += values[j];
+                    other[j] += values[j];
+                }
+            },
+            [&](Sums& state, bool row, int i, const tatami::SparseRange<double, int>& range) -> void {
+                auto& target = (row ? state.row : state.column);
+                auto& other = (row ? state.column : state.row);
+                for (int j = 0; j < range.number; ++j) {
+                    target[i] += range.value[j];
+                    other[range.index[j]] += range.value[j];
+                }
+            },
+            [&](Sums& left, Sums&& right) -> void {
+                for (int r = 0; r < nrow; ++r) {
+                    left.row[r] += right.row[r];
+                }
+                for (int c = 0; c < ncol; ++c) {
+                    left.column[c] += right.column[c];
+                }
+            },
+            ropt
+        );
+    }
+};
+
+TEST_P(ReduceTest, Sums) {
+    auto param = GetParam();
+    const bool row = std::get<0>(param);
+    const bool sparse = std::get<1>(param);
+    const int threads = std::get<2>(param);
+
+    std::shared_ptr<tatami::NumericMatrix> mat(new tatami::DenseRowMatrix<double, int>(nrow, ncol, simulated));
+    if (sparse) {
+        mat = tatami::convert_to_compressed_sparse<double, int>(*mat, row, {});
+    } else if (!row) {
+        mat = tatami::convert_to_dense<double, int>(*mat, false, {});
+    }
+
+    std::vector<double> expected_row(nrow), expected_col(ncol);
+    for (int r = 0; r < nrow; ++r) {
+        for (int c = 0; c < ncol; ++c) {
+            expected_row[r] += simulated[r * ncol + c];
+            expected_col[c] += simulated[r * ncol + c];
+        }
+    }
+
+    auto sums = compute(*mat, threads);
+    ASSERT_EQ(sums.row.size(), expected_row.size());
+    for (int r = 0; r < nrow; ++r) {
+        EXPECT_NEAR(sums.row[r], expected_row[r], 1e-8);
+    }
+    ASSERT_EQ(sums.column.size(), expected_col.size());
+    for (int c = 0; c < ncol; ++c) {
+        EXPECT_NEAR(sums.column[c], expected_col[c], 1e-8);
+    }
+
+    // Results are exactly reproducible for the same number of threads.
+    auto again = compute(*mat, threads);
+    EXPECT_EQ(sums.row, again.row);
+    EXPECT_EQ(sums.column, again.column);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Reduce,
+    ReduceTest,
+    ::testing::Combine(
+        ::testing::Values(true, false), // row or column major.
+        ::testing::Values(true, false), // sparse or dense.
+        ::testing::Values(1, 3, 200) // number of threads, including more threads than rows/columns.
+    )
+);
+
+TEST(Reduce, Empty) {
+    tatami::DenseRowMatrix<double, int> mat(0, 10, std::vector<double>());
+    auto out = tatami::reduce(
+        mat,
+        []() -> int { return 5; },
+        [](int& state, bool, int, const double*) -> void { ++state; },
+        [](int& state, bool, int, const tatami::SparseRange<double, int>&) -> void { ++state; },
+        [](int& left, int&& right) -> void { left += right; }
+    );
+    EXPECT_EQ(out, 5);
+}